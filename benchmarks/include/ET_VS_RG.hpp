@@ -152,3 +152,488 @@ BENCHMARK(long_op_matrices<RG_type_STL<double>::Matrix>)
     ->RangeMultiplier(range_mult)
     ->Range(range_min, squared_compl_range_max)
     ->Complexity(benchmark::oNSquared);
+
+// Mult matrix and vector: memory bandwidth -----------------------------------------------------------------
+BENCHMARK(read_bandwidth<double>)
+    ->Name("read_bandwidth")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, squared_compl_range_max)
+    ->Complexity(benchmark::oNSquared);
+BENCHMARK(mult_matrix_vector<ET_type<double>::Matrix>)
+    ->Name("mult_mat_vec_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, squared_compl_range_max)
+    ->Complexity(benchmark::oNSquared);
+BENCHMARK(mult_matrix_vector<RG_type_STL<double>::Matrix>)
+    ->Name("mult_mat_vec_RG")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, squared_compl_range_max)
+    ->Complexity(benchmark::oNSquared);
+BENCHMARK(mult_vector_matrix<ET_type<double>::Matrix>)
+    ->Name("mult_vec_mat_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, squared_compl_range_max)
+    ->Complexity(benchmark::oNSquared);
+BENCHMARK(mult_vector_matrix<RG_type_STL<double>::Matrix>)
+    ->Name("mult_vec_mat_RG")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, squared_compl_range_max)
+    ->Complexity(benchmark::oNSquared);
+
+// Mixed precision: float storage with double accumulation, compared with the double and float versions -----------------------------------------------------------------
+BENCHMARK(mult_matrix_vector<ET_type<float>::Matrix>)
+    ->Name("mult_mat_vec_float_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, squared_compl_range_max)
+    ->Complexity(benchmark::oNSquared);
+BENCHMARK((mult_matrix_vector<ET_type<float>::Matrix, double>))
+    ->Name("mult_mat_vec_float_acc_double_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, squared_compl_range_max)
+    ->Complexity(benchmark::oNSquared);
+BENCHMARK((mult_matrix_vector<RG_type_STL<float>::Matrix, double>))
+    ->Name("mult_mat_vec_float_acc_double_RG")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, squared_compl_range_max)
+    ->Complexity(benchmark::oNSquared);
+BENCHMARK((mult_two_matrices<ET_type<float>::Matrix, double>))
+    ->Name("mult_two_mat_float_acc_double_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, cubic_compl_range_max)
+    ->Complexity(benchmark::oNCubed);
+BENCHMARK(sum_matrix<ET_type<double>::Matrix>)
+    ->Name("sum_mat_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, squared_compl_range_max)
+    ->Complexity(benchmark::oNSquared);
+BENCHMARK(sum_matrix<ET_type<float>::Matrix>)
+    ->Name("sum_mat_float_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, squared_compl_range_max)
+    ->Complexity(benchmark::oNSquared);
+BENCHMARK((sum_matrix<ET_type<float>::Matrix, double>))
+    ->Name("sum_mat_float_acc_double_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, squared_compl_range_max)
+    ->Complexity(benchmark::oNSquared);
+BENCHMARK(dot_matrices<ET_type<double>::Matrix>)
+    ->Name("dot_mat_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, squared_compl_range_max)
+    ->Complexity(benchmark::oNSquared);
+BENCHMARK((dot_matrices<ET_type<float>::Matrix, double>))
+    ->Name("dot_mat_float_acc_double_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, squared_compl_range_max)
+    ->Complexity(benchmark::oNSquared);
+BENCHMARK((dot_matrices<RG_type_STL<float>::Matrix, double>))
+    ->Name("dot_mat_float_acc_double_RG")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, squared_compl_range_max)
+    ->Complexity(benchmark::oNSquared);
+
+// Mult a rectangular chain: optimal order vs right to left -----------------------------------------------------------------
+BENCHMARK(mult_rect_chain<ET_type<double>::Matrix>)
+    ->Name("mult_rect_chain_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, cubic_compl_range_max)
+    ->Complexity(benchmark::oNSquared);
+BENCHMARK(mult_rect_chain_right_fold<ET_type<double>::Matrix>)
+    ->Name("mult_rect_chain_right_fold_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, cubic_compl_range_max)
+    ->Complexity(benchmark::oNCubed);
+BENCHMARK(mult_rect_chain<RG_type_STL<double>::Matrix>)
+    ->Name("mult_rect_chain_RG")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, cubic_compl_range_max)
+    ->Complexity(benchmark::oNSquared);
+
+// Mult two matrices: GEMM kernel vs naive loop -----------------------------------------------------------------
+BENCHMARK(mult_two_matrices<ET_type<double>::Matrix>)
+    ->Name("mult_two_mat_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, cubic_compl_range_max)
+    ->Complexity(benchmark::oNCubed);
+BENCHMARK(mult_two_matrices_naive<ET_type<double>::Matrix>)
+    ->Name("mult_two_mat_naive_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, cubic_compl_range_max)
+    ->Complexity(benchmark::oNCubed);
+
+// Column-heavy access, unpadded vs padded rows -----------------------------------------------------------------
+BENCHMARK(column_sums<ET_type<double>::Matrix>)
+    ->Name("column_sums_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->ArgsProduct({ { 256, 512, 1024, 2048 }, { 0, 1 } });
+BENCHMARK(mult_two_matrices_naive_padded<ET_type<double>::Matrix>)
+    ->Name("mult_two_mat_naive_padded_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->ArgsProduct({ { 128, 256, 512 }, { 0, 1 } });
+BENCHMARK(mult_transposed_padded<ET_type<double>::Matrix>)
+    ->Name("mult_transposed_padded_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->ArgsProduct({ { 256, 512, 1024 }, { 0, 1 } });
+
+// Temporaries with and without an arena -----------------------------------------------------------------
+BENCHMARK(mult_four_matrices_arena<ET_type<double>::Matrix>)
+    ->Name("mult_four_mat_arena_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->ArgsProduct({ { 8, 32, 128, 512 }, { 0, 1 } });
+BENCHMARK(mult_four_matrices_arena<RG_type<double>::Matrix>)
+    ->Name("mult_four_mat_arena_RG")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->ArgsProduct({ { 8, 32, 128, 512 }, { 0, 1 } });
+BENCHMARK(mult_two_expr_preeval_arena<ET_type<double>::Matrix>)
+    ->Name("mult_two_expr_preeval_arena_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->ArgsProduct({ { 8, 32, 128, 512 }, { 0, 1 } });
+BENCHMARK(mult_two_expr_preeval_arena<RG_type<double>::Matrix>)
+    ->Name("mult_two_expr_preeval_arena_RG")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->ArgsProduct({ { 8, 32, 128, 512 }, { 0, 1 } });
+
+// Layouts: conversion from row-major, and column sweeps in each layout -----------------------------------------------------------------
+BENCHMARK(convert_layout<ET_type<double>::Matrix, ET::ColMajorMatrix<double>>)
+    ->Name("convert_layout_row_to_col_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->ArgsProduct({ { 256, 1024, 4096 } });
+BENCHMARK(convert_layout<ET_type<double>::Matrix, ET::TiledMatrix<double>>)
+    ->Name("convert_layout_row_to_tiled_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->ArgsProduct({ { 256, 1024, 4096 } });
+BENCHMARK(column_sums_layout<ET_type<double>::Matrix>)
+    ->Name("column_sums_row_major_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->ArgsProduct({ { 1024, 4096 } });
+BENCHMARK(column_sums_layout<ET::ColMajorMatrix<double>>)
+    ->Name("column_sums_col_major_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->ArgsProduct({ { 1024, 4096 } });
+BENCHMARK(column_sums_layout<ET::TiledMatrix<double>>)
+    ->Name("column_sums_tiled_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->ArgsProduct({ { 1024, 4096 } });
+
+// Products of blocks: views vs copies -----------------------------------------------------------------
+BENCHMARK(mult_blocks<ET_type<double>::Matrix>)
+    ->Name("mult_blocks_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->ArgsProduct({ { 64, 256, 1024 }, { 0, 1 } });
+BENCHMARK(mult_blocks<RG_type<double>::Matrix>)
+    ->Name("mult_blocks_RG")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->ArgsProduct({ { 64, 256, 1024 }, { 0, 1 } });
+
+// Expressions over mapped files vs in-memory matrices -----------------------------------------------------------------
+BENCHMARK(sum_two_mapped<ET_type<double>::Matrix, ET_type<double>::MappedMatrix>)
+    ->Name("sum_two_mapped_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->ArgsProduct({ { 256, 1024, 2048 }, { 0, 1 } });
+BENCHMARK(sum_two_mapped<RG_type<double>::Matrix, RG_type<double>::MappedMatrix>)
+    ->Name("sum_two_mapped_RG")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->ArgsProduct({ { 256, 1024, 2048 }, { 0, 1 } });
+
+// Matrix files: text vs binary, copied vs mapped -----------------------------------------------------------------
+BENCHMARK(write_matrix_file<ET_type<double>::Matrix>)
+    ->Name("write_matrix_file_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->ArgsProduct({ { 256, 1024 }, { 0, 1 } });
+BENCHMARK(read_binary_file<ET_type<double>::Matrix, ET_type<double>::MappedMatrix>)
+    ->Name("read_binary_file_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->ArgsProduct({ { 256, 1024, 2048 }, { 0, 1 } });
+BENCHMARK(read_binary_file<RG_type<double>::Matrix, RG_type<double>::MappedMatrix>)
+    ->Name("read_binary_file_RG")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->ArgsProduct({ { 256, 1024, 2048 }, { 0, 1 } });
+
+// Text matrices: operator<< vs to_chars, parsing with from_chars -----------------------------------------------------------------
+BENCHMARK(write_text_matrix<ET_type<double>::Matrix>)
+    ->Name("write_text_matrix_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->ArgsProduct({ { 256, 1024 }, { 0, 1 } });
+BENCHMARK(parse_text_matrix<ET_type<double>::Matrix>)
+    ->Name("parse_text_matrix_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->Apply([](benchmark::internal::Benchmark* b) { strong_scaling_args(b, 1024); })
+    ->UseRealTime();
+BENCHMARK(parse_text_matrix<RG_type<double>::Matrix>)
+    ->Name("parse_text_matrix_RG")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->Apply([](benchmark::internal::Benchmark* b) { strong_scaling_args(b, 1024); })
+    ->UseRealTime();
+
+// Allocate and overwrite: value initialized vs uninitialized -----------------------------------------------------------------
+BENCHMARK(allocate_and_assign_uninitialized<ET_type<double>::Matrix>)
+    ->Name("allocate_and_assign_uninitialized_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->ArgsProduct({ { 256, 1024, 4096 }, { 0, 1 } });
+BENCHMARK(allocate_and_assign_uninitialized<RG_type<double>::Matrix>)
+    ->Name("allocate_and_assign_uninitialized_RG")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->ArgsProduct({ { 256, 1024, 4096 }, { 0, 1 } });
+
+// Mult with helper matrices: a copy for Identity, a broadcast of the column sums for Constant ----------------------------------
+BENCHMARK(mult_helper_matrix<ET_type<double>::Matrix, ET_type<double>::Identity>)
+    ->Name("mult_identity_mat_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, squared_compl_range_max)
+    ->Complexity(benchmark::oNSquared);
+BENCHMARK(mult_helper_matrix<RG_type<double>::Matrix, RG_type<double>::Identity>)
+    ->Name("mult_identity_mat_RG")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, squared_compl_range_max)
+    ->Complexity(benchmark::oNSquared);
+BENCHMARK(mult_helper_matrix<ET_type<double>::Matrix, ET_type<double>::Constant>)
+    ->Name("mult_constant_mat_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, squared_compl_range_max)
+    ->Complexity(benchmark::oNSquared);
+BENCHMARK(mult_helper_matrix<RG_type<double>::Matrix, RG_type<double>::Constant>)
+    ->Name("mult_constant_mat_RG")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, squared_compl_range_max)
+    ->Complexity(benchmark::oNSquared);
+
+// Mult matrices into an existing matrix: no allocation of the result and of the temporaries ----------------------------------
+BENCHMARK(mult_two_matrices_into<ET_type<double>::Matrix>)
+    ->Name("mult_two_mat_into_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, cubic_compl_range_max)
+    ->Complexity(benchmark::oNCubed);
+BENCHMARK(mult_two_matrices_into<RG_type_STL<double>::Matrix>)
+    ->Name("mult_two_mat_into_RG")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, cubic_compl_range_max)
+    ->Complexity(benchmark::oNCubed);
+BENCHMARK(mult_four_matrices<ET_type<double>::Matrix>)
+    ->Name("mult_four_mat_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, cubic_compl_range_max)
+    ->Complexity(benchmark::oNCubed);
+BENCHMARK(mult_four_matrices_into<ET_type<double>::Matrix>)
+    ->Name("mult_four_mat_into_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, cubic_compl_range_max)
+    ->Complexity(benchmark::oNCubed);
+
+// Mult two matrices: instruction set variants (0 generic, 1 sse4, 2 avx2, 3 avx512, 4 avx512vnni) ----------------------------------
+BENCHMARK(mult_two_matrices_isa<ET_type<double>::Matrix>)
+    ->Name("mult_two_mat_isa_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->ArgsProduct({ { 128, 512 }, { 0, 1, 2, 3, 4 } });
+BENCHMARK(mult_two_matrices_isa<ET::Matrixi16>)
+    ->Name("mult_two_mat_int16_isa_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->ArgsProduct({ { 128, 512 }, { 0, 1, 2, 3, 4 } });
+
+// Mult two matrices: integer kernel with widened accumulators, compare with the floating point mult_two_mat_ET -----------------------
+BENCHMARK(mult_two_matrices<ET_type<float>::Matrix>)
+    ->Name("mult_two_mat_float_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, cubic_compl_range_max)
+    ->Complexity(benchmark::oNCubed);
+BENCHMARK(mult_two_matrices<ET_type<int>::Matrix>)
+    ->Name("mult_two_mat_int_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, cubic_compl_range_max)
+    ->Complexity(benchmark::oNCubed);
+BENCHMARK(mult_two_matrices_widening<ET::Matrixi8>)
+    ->Name("mult_two_mat_int8_widening_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, cubic_compl_range_max)
+    ->Complexity(benchmark::oNCubed);
+BENCHMARK(mult_two_matrices_widening<ET::Matrixi16>)
+    ->Name("mult_two_mat_int16_widening_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, cubic_compl_range_max)
+    ->Complexity(benchmark::oNCubed);
+BENCHMARK(mult_two_matrices_widening<ET::Matrixi16, std::int64_t>)
+    ->Name("mult_two_mat_int16_to_int64_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, cubic_compl_range_max)
+    ->Complexity(benchmark::oNCubed);
+BENCHMARK(mult_two_matrices_widening<RG::Matrixi16>)
+    ->Name("mult_two_mat_int16_widening_RG")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, cubic_compl_range_max)
+    ->Complexity(benchmark::oNCubed);
+
+// Batches of small matrix products: products per second of mat_mult calls vs batched_mat_mult -----------------------------------
+BENCHMARK(mult_small_matrices_loop<ET_type<double>::Matrix>)
+    ->Name("mult_small_mat_loop_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->ArgsProduct({ { 1 << 10, 1 << 15 }, { 2, 3, 4, 8, 16 } });
+BENCHMARK(mult_fixed_size_matrices<double>)
+    ->Name("mult_fixed_size_mat_loop_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->ArgsProduct({ { 1 << 10, 1 << 15 }, { 2, 3, 4, 8, 16 } });
+BENCHMARK(mult_small_matrices_batched<double>)
+    ->Name("mult_small_mat_batched")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->ArgsProduct({ { 1 << 10, 1 << 15, 1 << 20 }, { 3, 4, 8, 16 }, { 0, 1 } })
+    ->UseRealTime();
+
+// Batches of small LU solves: dynamic matrices with LU vs fixed size matrices with FixedLU ------------------------------------
+BENCHMARK(LU_small_matrices_loop<ET_type<double>::Matrix>)
+    ->Name("LU_small_mat_loop_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->ArgsProduct({ { 1 << 10 }, { 2, 3, 4, 8, 16 } });
+BENCHMARK(LU_fixed_size_matrices<double>)
+    ->Name("LU_fixed_size_mat_loop_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->ArgsProduct({ { 1 << 10 }, { 2, 3, 4, 8, 16 } });
+
+// Mult two matrices: Strassen-Winograd crossover, compare with mult_two_mat_standard_ET ------------------------------------
+BENCHMARK(mult_two_matrices<ET_type<double>::Matrix>)
+    ->Name("mult_two_mat_standard_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->Arg(512)
+    ->Arg(1024)
+    ->Arg(2048)
+    ->Arg(4096);
+BENCHMARK(mult_two_matrices_strassen<ET_type<double>::Matrix>)
+    ->Name("mult_two_mat_strassen_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->ArgsProduct({ { 512, 1024, 2048, 4096 }, { 128, 256, 512 } });
+
+// Gram matrix: general product vs symmetric rank-k update -----------------------------------------------------------------
+BENCHMARK(gram_matrix_mat_mult<ET_type<double>::Matrix>)
+    ->Name("gram_mat_mat_mult_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, cubic_compl_range_max)
+    ->Complexity(benchmark::oNCubed);
+BENCHMARK(gram_matrix_syrk<ET_type<double>::Matrix>)
+    ->Name("gram_mat_syrk_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, cubic_compl_range_max)
+    ->Complexity(benchmark::oNCubed);
+BENCHMARK(gram_matrix_mat_mult<RG_type_STL<double>::Matrix>)
+    ->Name("gram_mat_mat_mult_RG")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, cubic_compl_range_max)
+    ->Complexity(benchmark::oNCubed);
+BENCHMARK(gram_matrix_syrk<RG_type_STL<double>::Matrix>)
+    ->Name("gram_mat_syrk_RG")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, cubic_compl_range_max)
+    ->Complexity(benchmark::oNCubed);
+
+// Mult two matrices: strong scaling -----------------------------------------------------------------
+BENCHMARK(mult_two_matrices_threads<ET_type<double>::Matrix>)
+    ->Name("mult_two_mat_threads_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->Apply([](benchmark::internal::Benchmark* b) { strong_scaling_args(b, 2048); })
+    ->UseRealTime();
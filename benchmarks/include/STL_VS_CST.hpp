@@ -184,3 +184,11 @@ BENCHMARK(long_op_matrices<RG_type<double>::Matrix>)
     ->RangeMultiplier(range_mult)
     ->Range(range_min, squared_compl_range_max)
     ->Complexity(benchmark::oNSquared);
+
+// Mult two matrices: strong scaling -----------------------------------------------------------------
+BENCHMARK(mult_two_matrices_threads<RG_type<double>::Matrix>)
+    ->Name("mult_two_mat_threads_CST")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->Apply([](benchmark::internal::Benchmark* b) { strong_scaling_args(b, 512); })
+    ->UseRealTime();
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "benchmarks.hpp"
+
+extern double min_time;
+extern double min_warmup_time;
+extern int range_min;
+extern int squared_compl_range_max;
+extern int sparse_range_max;
+extern int range_mult;
+
+// Sparse matrix times vector -----------------------------------------------------------------
+BENCHMARK(mult_sparse_dense<ET_type<double>::Matrix, SparseFormat::CSR, SparsePattern::Banded>)
+    ->Name("spmv_banded_csr_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, sparse_range_max)
+    ->Complexity(benchmark::oN);
+BENCHMARK(mult_sparse_dense<ET_type<double>::Matrix, SparseFormat::CSC, SparsePattern::Banded>)
+    ->Name("spmv_banded_csc_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, sparse_range_max)
+    ->Complexity(benchmark::oN);
+BENCHMARK(mult_sparse_dense<ET_type<double>::Matrix, SparseFormat::CSR, SparsePattern::Random>)
+    ->Name("spmv_random_csr_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, sparse_range_max)
+    ->Complexity(benchmark::oN);
+BENCHMARK(mult_sparse_dense<ET_type<double>::Matrix, SparseFormat::CSC, SparsePattern::Random>)
+    ->Name("spmv_random_csc_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, sparse_range_max)
+    ->Complexity(benchmark::oN);
+BENCHMARK(mult_sparse_dense<ET_type<double>::Matrix, SparseFormat::CSR, SparsePattern::PowerLaw>)
+    ->Name("spmv_power_law_csr_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, sparse_range_max)
+    ->Complexity(benchmark::oN);
+BENCHMARK(mult_sparse_dense<ET_type<double>::Matrix, SparseFormat::CSC, SparsePattern::PowerLaw>)
+    ->Name("spmv_power_law_csc_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, sparse_range_max)
+    ->Complexity(benchmark::oN);
+BENCHMARK(mult_sparse_dense<RG_type<double>::Matrix, SparseFormat::CSR, SparsePattern::Random>)
+    ->Name("spmv_random_csr_RG")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, sparse_range_max)
+    ->Complexity(benchmark::oN);
+BENCHMARK(mult_sparse_as_dense<ET_type<double>::Matrix, SparsePattern::Random>)
+    ->Name("spmv_random_dense_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, squared_compl_range_max)
+    ->Complexity(benchmark::oNSquared);
+
+// Sparse matrix times dense matrix -----------------------------------------------------------------
+BENCHMARK(mult_sparse_dense<ET_type<double>::Matrix, SparseFormat::CSR, SparsePattern::Banded, sparse_row_length>)
+    ->Name("spmm_banded_csr_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, sparse_range_max)
+    ->Complexity(benchmark::oN);
+BENCHMARK(mult_sparse_dense<ET_type<double>::Matrix, SparseFormat::CSC, SparsePattern::Banded, sparse_row_length>)
+    ->Name("spmm_banded_csc_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, sparse_range_max)
+    ->Complexity(benchmark::oN);
+BENCHMARK(mult_sparse_dense<ET_type<double>::Matrix, SparseFormat::CSR, SparsePattern::Random, sparse_row_length>)
+    ->Name("spmm_random_csr_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, sparse_range_max)
+    ->Complexity(benchmark::oN);
+BENCHMARK(mult_sparse_dense<ET_type<double>::Matrix, SparseFormat::CSC, SparsePattern::Random, sparse_row_length>)
+    ->Name("spmm_random_csc_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, sparse_range_max)
+    ->Complexity(benchmark::oN);
+BENCHMARK(mult_sparse_dense<ET_type<double>::Matrix, SparseFormat::CSR, SparsePattern::PowerLaw, sparse_row_length>)
+    ->Name("spmm_power_law_csr_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, sparse_range_max)
+    ->Complexity(benchmark::oN);
+BENCHMARK(mult_sparse_dense<ET_type<double>::Matrix, SparseFormat::CSC, SparsePattern::PowerLaw, sparse_row_length>)
+    ->Name("spmm_power_law_csc_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, sparse_range_max)
+    ->Complexity(benchmark::oN);
+BENCHMARK(mult_sparse_dense<RG_type<double>::Matrix, SparseFormat::CSR, SparsePattern::Random, sparse_row_length>)
+    ->Name("spmm_random_csr_RG")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, sparse_range_max)
+    ->Complexity(benchmark::oN);
+BENCHMARK(mult_sparse_as_dense<ET_type<double>::Matrix, SparsePattern::Random, sparse_row_length>)
+    ->Name("spmm_random_dense_ET")
+    ->MinTime(min_time)
+    ->MinWarmUpTime(min_warmup_time)
+    ->RangeMultiplier(range_mult)
+    ->Range(range_min, squared_compl_range_max)
+    ->Complexity(benchmark::oNSquared);
@@ -5,13 +5,56 @@
 
 #include <benchmark/benchmark.h>
 
+// Counter reporting the FLOP/s of an m x k times k x n matrix product.
+inline benchmark::Counter flops_counter(double m, double n, double k)
+{
+    return benchmark::Counter(2. * m * n * k, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// Counter reporting the memory bandwidth needed to read bytes per iteration.
+inline benchmark::Counter bandwidth_counter(double bytes)
+{
+    return benchmark::Counter(bytes, benchmark::Counter::kIsIterationInvariantRate, benchmark::Counter::kIs1024);
+}
+
+// Number of calls to the global operator new, counted by its replacement in main.cpp.
+extern std::atomic<std::size_t> heap_allocations;
+
+// Counter reporting the heap allocations per iteration since the count was allocations.
+inline benchmark::Counter allocations_counter(std::size_t allocations)
+{
+    return benchmark::Counter(static_cast<double>(heap_allocations - allocations), benchmark::Counter::kAvgIterations);
+}
+
 // Allocate ---------------------------------------------------------------------
+// The allocs counter is the number of heap allocations per iteration: none for the small RG matrices, stored inside their Container.
 template <typename Matrix>
 static void allocate_matrix(benchmark::State& state)
 {
+    const std::size_t allocations = heap_allocations;
     for (auto _ : state)
         benchmark::DoNotOptimize(Matrix(state.range(0), state.range(0)));
     state.SetComplexityN(state.range(0));
+    state.counters["allocs"] = allocations_counter(allocations);
+}
+
+// Allocate and overwrite: value initialized vs uninitialized -----------------------------------------------------------------
+// range(1) is 1 if the result is constructed uninitialized, 0 if its coefficients are first zeroed. The expression overwrites all of them.
+template <typename Matrix>
+static void allocate_and_assign_uninitialized(benchmark::State& state)
+{
+    const int n = state.range(0);
+    Matrix m1 = Matrix::randn(n, n);
+    Matrix m2 = Matrix::randn(n, n);
+
+    for (auto _ : state)
+    {
+        Matrix res = state.range(1) ? Matrix(n, n, LinAlg::Matrices::Common::uninitialized) : Matrix(n, n);
+        res = m1 + m2;
+        benchmark::DoNotOptimize(res);
+    }
+    state.counters["uninitialized"] = state.range(1);
+    state.counters["bandwidth"] = bandwidth_counter(3. * n * n * sizeof(typename Matrix::Scalar));
 }
 
 // Set operator -----------------------------------------------------------------
@@ -190,8 +233,8 @@ static void mult_scalar(benchmark::State& state)
     state.SetComplexityN(state.range(0));
 }
 
-// Mult two matrices -----------------------------------------------------------------
-template <typename Matrix>
+// Mult two matrices, accumulating in Acc -----------------------------------------------------------------
+template <typename Matrix, typename Acc = void>
 static void mult_two_matrices(benchmark::State& state)
 {
     using Scalar = typename Matrix::Scalar;
@@ -199,11 +242,718 @@ static void mult_two_matrices(benchmark::State& state)
     Matrix m2 = Matrix::randn(state.range(0), state.range(0));
     Matrix m3;
 
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(m3 = mat_mult<Acc>(m1, m2));
+    }
+    state.SetComplexityN(state.range(0));
+    state.counters["FLOP"] = flops_counter(state.range(0), state.range(0), state.range(0));
+}
+
+// Mult a matrix with a helper matrix (Identity or Constant), whose structure avoids the general product -----------------------------------------------------------------
+template <typename Matrix, typename Helper>
+static void mult_helper_matrix(benchmark::State& state)
+{
+    Matrix m1 = Matrix::randn(state.range(0), state.range(0));
+    Helper helper = [&]
+    {
+        if constexpr (std::is_constructible_v<Helper, int>)
+            return Helper(state.range(0));
+        else
+            return Helper(state.range(0), state.range(0), 2.);
+    }();
+    Matrix m3;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(m3 = mat_mult(helper, m1));
+    }
+    state.SetComplexityN(state.range(0));
+}
+
+// Mult two integer matrices, accumulating and returning the result in a widened type -----------------------------------------------------------------
+// The FLOP counter counts integer multiply-adds, hence it is directly comparable with mult_two_matrices on floating point matrices.
+template <typename Matrix, typename Acc = void>
+static void mult_two_matrices_widening(benchmark::State& state)
+{
+    Matrix m1 = Matrix::randn(state.range(0), state.range(0), 0, 20);
+    Matrix m2 = Matrix::randn(state.range(0), state.range(0), 0, 20);
+
+    for (auto _ : state)
+    {
+        auto m3 = widening_mult<Acc>(m1, m2);
+        benchmark::DoNotOptimize(m3);
+    }
+    state.SetComplexityN(state.range(0));
+    state.counters["FLOP"] = flops_counter(state.range(0), state.range(0), state.range(0));
+}
+
+// Gram matrix A^T * A of an n x n/2 matrix: general product with a materialized transpose vs syrk -----------------------------------------------------------------
+// The FLOP counter counts the operations of the general product, hence syrk reaches up to twice the rate of mat_mult.
+template <typename Matrix>
+static void gram_matrix_mat_mult(benchmark::State& state)
+{
+    Matrix m1 = Matrix::randn(state.range(0), state.range(0) / 2);
+    Matrix m2;
+
+    for (auto _ : state)
+    {
+        Matrix m1_t(m1.cols(), m1.rows());
+        for (int i = 0; i < m1.rows(); ++i)
+            for (int j = 0; j < m1.cols(); ++j)
+                m1_t[j, i] = m1[i, j];
+        benchmark::DoNotOptimize(m2 = mat_mult(m1_t, m1));
+    }
+    state.SetComplexityN(state.range(0));
+    state.counters["FLOP"] = flops_counter(state.range(0) / 2, state.range(0) / 2, state.range(0));
+}
+
+template <typename Matrix>
+static void gram_matrix_syrk(benchmark::State& state)
+{
+    Matrix m1 = Matrix::randn(state.range(0), state.range(0) / 2);
+    Matrix m2;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(m2 = syrk(m1, true));
+    }
+    state.SetComplexityN(state.range(0));
+    state.counters["FLOP"] = flops_counter(state.range(0) / 2, state.range(0) / 2, state.range(0));
+}
+
+// Mult two matrices with a given number of threads -----------------------------------------------------------------
+template <typename Matrix>
+static void mult_two_matrices_threads(benchmark::State& state)
+{
+    namespace Kernels = LinAlg::Matrices::Kernels;
+    const int initial_threads = Kernels::num_threads();
+    Kernels::set_num_threads(state.range(1));
+
+    Matrix m1 = Matrix::randn(state.range(0), state.range(0));
+    Matrix m2 = Matrix::randn(state.range(0), state.range(0));
+    Matrix m3;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(m3 = mat_mult(m1, m2));
+    }
+    state.counters["threads"] = state.range(1);
+    state.counters["FLOP"] = flops_counter(state.range(0), state.range(0), state.range(0));
+    Kernels::set_num_threads(initial_threads);
+}
+
+// Thread counts 1, 2, 4, ... up to the number of hardware threads, for the strong scaling benchmarks.
+inline void strong_scaling_args(benchmark::internal::Benchmark* b, int n)
+{
+    const int max_threads = std::max(1u, std::thread::hardware_concurrency());
+    for (int threads = 1; threads < max_threads; threads *= 2)
+        b->Args({ n, threads });
+    b->Args({ n, max_threads });
+}
+
+// Mult two matrices with a given instruction set -----------------------------------------------------------------
+template <typename Matrix>
+static void mult_two_matrices_isa(benchmark::State& state)
+{
+    namespace Kernels = LinAlg::Matrices::Kernels;
+    const Kernels::ISA initial = Kernels::active_isa();
+    const Kernels::ISA isa = Kernels::set_isa(static_cast<Kernels::ISA>(state.range(1)));
+    state.SetLabel(Kernels::isa_name(isa));
+
+    Matrix m1 = Matrix::randn(state.range(0), state.range(0), 0, 20);
+    Matrix m2 = Matrix::randn(state.range(0), state.range(0), 0, 20);
+    Matrix m3;
+
     for (auto _ : state)
     {
         benchmark::DoNotOptimize(m3 = mat_mult(m1, m2));
     }
+    state.counters["FLOP"] = flops_counter(state.range(0), state.range(0), state.range(0));
+    Kernels::set_isa(initial);
+}
+
+// Mult two matrices with the naive triple loop -----------------------------------------------------------------
+template <typename Matrix>
+static void mult_two_matrices_naive(benchmark::State& state)
+{
+    Matrix m1 = Matrix::randn(state.range(0), state.range(0));
+    Matrix m2 = Matrix::randn(state.range(0), state.range(0));
+    Matrix m3(state.range(0), state.range(0));
+
+    for (auto _ : state)
+    {
+        ET::_implementation_details::naive_two_matrix_mult(m1, m2, m3);
+        benchmark::DoNotOptimize(m3.data().data());
+    }
+    state.SetComplexityN(state.range(0));
+    state.counters["FLOP"] = flops_counter(state.range(0), state.range(0), state.range(0));
+}
+
+// Mult two matrices with Strassen-Winograd and a given cutoff -----------------------------------------------------------------
+// The FLOP counter uses the operation count of the standard product, hence it is directly comparable with mult_two_matrices.
+template <typename Matrix>
+static void mult_two_matrices_strassen(benchmark::State& state)
+{
+    Matrix m1 = Matrix::randn(state.range(0), state.range(0));
+    Matrix m2 = Matrix::randn(state.range(0), state.range(0));
+    Matrix m3;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(m3 = strassen_mult(m1, m2, state.range(1)));
+    }
+    state.counters["cutoff"] = state.range(1);
+    state.counters["FLOP"] = flops_counter(state.range(0), state.range(0), state.range(0));
+}
+
+// Mult two matrices into an existing matrix -----------------------------------------------------------------
+template <typename Matrix>
+static void mult_two_matrices_into(benchmark::State& state)
+{
+    Matrix m1 = Matrix::randn(state.range(0), state.range(0));
+    Matrix m2 = Matrix::randn(state.range(0), state.range(0));
+    Matrix m3(state.range(0), state.range(0));
+
+    for (auto _ : state)
+    {
+        gemm_into(m3, m1, m2);
+        benchmark::DoNotOptimize(m3.data().data());
+    }
+    state.SetComplexityN(state.range(0));
+    state.counters["FLOP"] = flops_counter(state.range(0), state.range(0), state.range(0));
+}
+
+// Column-heavy access with and without padded rows -----------------------------------------------------------------
+// range(1) is 1 for rows padded with padded_leading_dimension, 0 for unpadded rows. With power of two sizes, the coefficients of a column
+// of an unpadded matrix map to a few cache sets only and evict each other.
+template <typename Matrix>
+Matrix randn_padded(int rows, int cols, bool padded)
+{
+    Matrix m = Matrix::randn(rows, cols);
+    if (!padded)
+        return m;
+    return Matrix(m, LinAlg::Matrices::Common::padded_leading_dimension<typename Matrix::Scalar>(cols));
+}
+
+// Sums of the columns, each column being read from top to bottom as in the column sweeps of LU.
+template <typename Matrix>
+static void column_sums(benchmark::State& state)
+{
+    using Scalar = typename Matrix::Scalar;
+    const int n = state.range(0);
+    Matrix m = randn_padded<Matrix>(n, n, state.range(1));
+    std::vector<Scalar> sums(n);
+
+    for (auto _ : state)
+    {
+        for (int j = 0; j < n; ++j)
+        {
+            Scalar sum = 0;
+            for (int i = 0; i < n; ++i)
+                sum += m[i, j];
+            sums[j] = sum;
+        }
+        benchmark::DoNotOptimize(sums.data());
+    }
+    state.counters["padded"] = state.range(1);
+    state.counters["Bytes"] = bandwidth_counter(static_cast<double>(n) * n * sizeof(Scalar));
+}
+
+// Naive product, whose inner loop reads a column of the right matrix.
+template <typename Matrix>
+static void mult_two_matrices_naive_padded(benchmark::State& state)
+{
+    const int n = state.range(0);
+    Matrix m1 = randn_padded<Matrix>(n, n, state.range(1));
+    Matrix m2 = randn_padded<Matrix>(n, n, state.range(1));
+    Matrix m3(n, n);
+
+    for (auto _ : state)
+    {
+        ET::_implementation_details::naive_two_matrix_mult(m1, m2, m3);
+        benchmark::DoNotOptimize(m3.data().data());
+    }
+    state.counters["padded"] = state.range(1);
+    state.counters["FLOP"] = flops_counter(n, n, n);
+}
+
+// Product with the transpose of the left matrix, whose columns are read when packing the panels of the GEMM kernel.
+template <typename Matrix>
+static void mult_transposed_padded(benchmark::State& state)
+{
+    const int n = state.range(0);
+    Matrix m1 = randn_padded<Matrix>(n, n, state.range(1));
+    Matrix m2 = randn_padded<Matrix>(n, n, state.range(1));
+    Matrix m3(n, n);
+
+    for (auto _ : state)
+    {
+        gemm_into(m3, m1, m2, 1., 0., true);
+        benchmark::DoNotOptimize(m3.data().data());
+    }
+    state.counters["padded"] = state.range(1);
+    state.counters["FLOP"] = flops_counter(n, n, n);
+}
+
+// Layouts -----------------------------------------------------------------
+// Explicit conversion of a row-major matrix to the layout of Target.
+template <typename Matrix, typename Target>
+static void convert_layout(benchmark::State& state)
+{
+    const int n = state.range(0);
+    Matrix m = Matrix::randn(n, n);
+
+    for (auto _ : state)
+    {
+        Target converted(m);
+        benchmark::DoNotOptimize(converted.data().data());
+    }
+    state.counters["Bytes"] = bandwidth_counter(2. * sizeof(typename Matrix::Scalar) * n * n);
+}
+
+// Sums of the columns of a matrix in the layout of Matrix, read from top to bottom.
+template <typename Matrix>
+static void column_sums_layout(benchmark::State& state)
+{
+    using Scalar = typename Matrix::Scalar;
+    const int n = state.range(0);
+    Matrix m(Matrix::randn(n, n));
+    std::vector<Scalar> sums(n);
+
+    for (auto _ : state)
+    {
+        for (int j = 0; j < n; ++j)
+        {
+            Scalar sum = 0;
+            for (int i = 0; i < n; ++i)
+                sum += m[i, j];
+            sums[j] = sum;
+        }
+        benchmark::DoNotOptimize(sums.data());
+    }
+    state.counters["Bytes"] = bandwidth_counter(static_cast<double>(n) * n * sizeof(Scalar));
+}
+
+// Views -----------------------------------------------------------------
+// Product of blocks of two larger matrices, read in place through views if range(1) is 1, copied into matrices first if it is 0.
+template <typename Matrix>
+static void mult_blocks(benchmark::State& state)
+{
+    const int n = state.range(0);
+    Matrix m1 = Matrix::randn(2 * n, 2 * n);
+    Matrix m2 = Matrix::randn(2 * n, 2 * n);
+    Matrix res;
+
+    for (auto _ : state)
+    {
+        if (state.range(1))
+            res = mat_mult(m1.block(n / 2, n / 2, n, n), m2.block(0, n, n, n).transpose());
+        else
+            res = mat_mult(Matrix(m1.block(n / 2, n / 2, n, n)), Matrix(m2.block(0, n, n, n).transpose()));
+        benchmark::DoNotOptimize(res.data().data());
+    }
+    state.counters["views"] = state.range(1);
+    state.counters["FLOP"] = flops_counter(n, n, n);
+}
+
+// Mapped matrices -----------------------------------------------------------------
+// Sequential evaluation of an expression reading two matrices, mapped from files if range(1) is 1, stored in memory if it is 0.
+// The files stay in the page cache between the iterations: the difference is the cost of the page faults, not of the disk.
+template <typename Matrix, typename MappedMatrix>
+static void sum_two_mapped(benchmark::State& state)
+{
+    using Scalar = typename Matrix::Scalar;
+    using LinAlg::Matrices::Common::MappedArray;
+    const int n = state.range(0);
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "linalg_mapped_benchmark";
+    Matrix m1 = Matrix::randn(n, n);
+    Matrix m2 = Matrix::randn(n, n);
+    for (const auto& [m, name] : { std::pair(&m1, "1.bin"), std::pair(&m2, "2.bin") })
+    {
+        MappedMatrix file(n, n, MappedArray<Scalar>::create(path.string() + name, n * n));
+        file = *m;
+    }
+    const MappedMatrix mapped1(n, n, MappedArray<Scalar>::open(path.string() + "1.bin"));
+    const MappedMatrix mapped2(n, n, MappedArray<Scalar>::open(path.string() + "2.bin"));
+    Matrix res(n, n);
+
+    for (auto _ : state)
+    {
+        if (state.range(1))
+            res = 2. * mapped1 + mapped2;
+        else
+            res = 2. * m1 + m2;
+        benchmark::DoNotOptimize(res.data().data());
+    }
+    state.counters["mapped"] = state.range(1);
+    state.counters["Bytes"] = bandwidth_counter(2. * sizeof(Scalar) * n * n);
+    std::filesystem::remove(path.string() + "1.bin");
+    std::filesystem::remove(path.string() + "2.bin");
+}
+
+// Binary files -----------------------------------------------------------------
+// Writes a matrix into a file, as text through operator<< if range(1) is 0, in the binary format of save_binary if it is 1.
+template <typename Matrix>
+static void write_matrix_file(benchmark::State& state)
+{
+    const int n = state.range(0);
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "linalg_write_benchmark";
+    Matrix m = Matrix::randn(n, n);
+
+    for (auto _ : state)
+    {
+        if (state.range(1))
+            LinAlg::Matrices::Common::save_binary(path, m);
+        else
+            std::ofstream(path) << m;
+    }
+    state.counters["binary"] = state.range(1);
+    state.counters["Bytes"] = bandwidth_counter(static_cast<double>(sizeof(typename Matrix::Scalar)) * n * n);
+    std::filesystem::remove(path);
+}
+
+// Reads a binary matrix file and sums its coefficients: copied into a matrix by load_binary, verifying the checksum, if range(1) is 0,
+// mapped by map_binary and read in place if it is 1.
+template <typename Matrix, typename MappedMatrix>
+static void read_binary_file(benchmark::State& state)
+{
+    const int n = state.range(0);
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "linalg_read_benchmark";
+    LinAlg::Matrices::Common::save_binary(path, Matrix::randn(n, n));
+
+    for (auto _ : state)
+    {
+        if (state.range(1))
+            benchmark::DoNotOptimize(LinAlg::Matrices::Common::sum(LinAlg::Matrices::Common::map_binary<MappedMatrix>(path)));
+        else
+            benchmark::DoNotOptimize(LinAlg::Matrices::Common::sum(LinAlg::Matrices::Common::load_binary<Matrix>(path)));
+    }
+    state.counters["mapped"] = state.range(1);
+    state.counters["Bytes"] = bandwidth_counter(static_cast<double>(sizeof(typename Matrix::Scalar)) * n * n);
+    std::filesystem::remove(path);
+}
+
+// Text files -----------------------------------------------------------------
+// Formats a matrix as text into a string, through operator<< if range(1) is 0, with write_text if it is 1. The Bytes counter is the
+// size of the text written by write_text.
+template <typename Matrix>
+static void write_text_matrix(benchmark::State& state)
+{
+    const int n = state.range(0);
+    Matrix m = Matrix::randn(n, n);
+    std::ostringstream text;
+    LinAlg::Matrices::Common::write_text(text, m);
+    const double bytes = static_cast<double>(text.str().size());
+
+    for (auto _ : state)
+    {
+        std::ostringstream os;
+        if (state.range(1))
+            LinAlg::Matrices::Common::write_text(os, m);
+        else
+            os << m;
+        benchmark::DoNotOptimize(os.tellp());
+    }
+    state.counters["to_chars"] = state.range(1);
+    state.counters["Bytes"] = bandwidth_counter(bytes);
+}
+
+// Parses the text of a matrix with parse_text on range(1) threads.
+template <typename Matrix>
+static void parse_text_matrix(benchmark::State& state)
+{
+    namespace Kernels = LinAlg::Matrices::Kernels;
+    const int initial_threads = Kernels::num_threads();
+    Kernels::set_num_threads(state.range(1));
+
+    const int n = state.range(0);
+    std::ostringstream os;
+    LinAlg::Matrices::Common::write_text(os, Matrix::randn(n, n));
+    const std::string text = os.str();
+    Matrix m;
+
+    for (auto _ : state)
+    {
+        m = LinAlg::Matrices::Common::parse_text<Matrix>(text);
+        benchmark::DoNotOptimize(m.data().data());
+    }
+    state.counters["threads"] = state.range(1);
+    state.counters["Bytes"] = bandwidth_counter(static_cast<double>(text.size()));
+    Kernels::set_num_threads(initial_threads);
+}
+
+// Temporaries with and without an arena -----------------------------------------------------------------
+// range(1) is 1 if each iteration runs in an ArenaScope, 0 if the temporaries are allocated on the heap. The allocs counter is the number
+// of heap allocations per iteration, the result only with an arena.
+template <typename Matrix>
+static void mult_four_matrices_arena(benchmark::State& state)
+{
+    const int n = state.range(0);
+    Matrix m1 = Matrix::randn(n, n);
+    Matrix m2 = Matrix::randn(n, n);
+    Matrix m3 = Matrix::randn(n, n);
+    Matrix m4 = Matrix::randn(n, n);
+    Matrix m5;
+    LinAlg::Matrices::Common::Arena arena;
+
+    const std::size_t allocations = heap_allocations;
+    for (auto _ : state)
+    {
+        std::optional<LinAlg::Matrices::Common::ArenaScope> scope;
+        if (state.range(1))
+            scope.emplace(arena);
+        benchmark::DoNotOptimize(m5 = mat_mult(m1, m2, m3, m4));
+    }
+    state.counters["arena"] = state.range(1);
+    state.counters["allocs"] = allocations_counter(allocations);
+}
+
+template <typename Matrix>
+static void mult_two_expr_preeval_arena(benchmark::State& state)
+{
+    const int n = state.range(0);
+    Matrix m1 = Matrix::randn(n, n);
+    Matrix m2 = Matrix::randn(n, n);
+    Matrix m3 = Matrix::randn(n, n);
+    Matrix m4 = Matrix::randn(n, n);
+    Matrix m5;
+    LinAlg::Matrices::Common::Arena arena;
+
+    const std::size_t allocations = heap_allocations;
+    for (auto _ : state)
+    {
+        std::optional<LinAlg::Matrices::Common::ArenaScope> scope;
+        if (state.range(1))
+            scope.emplace(arena);
+        benchmark::DoNotOptimize(m5 = mat_mult<true>(m1 * m2 + m3 * m4, m2 * m3 - m4 * m1));
+    }
+    state.counters["arena"] = state.range(1);
+    state.counters["allocs"] = allocations_counter(allocations);
+}
+
+// Mult four matrices into an existing matrix, reusing the scratch buffers -----------------------------------------------------------------
+template <typename Matrix>
+static void mult_four_matrices_into(benchmark::State& state)
+{
+    using Scalar = typename Matrix::Scalar;
+    Matrix m1 = Matrix::randn(state.range(0), state.range(0));
+    Matrix m2 = Matrix::randn(state.range(0), state.range(0));
+    Matrix m3 = Matrix::randn(state.range(0), state.range(0));
+    Matrix m4 = Matrix::randn(state.range(0), state.range(0));
+    Matrix m5(state.range(0), state.range(0));
+    LinAlg::Matrices::Common::ChainWorkspace<Scalar> workspace;
+
+    for (auto _ : state)
+    {
+        mat_mult_into(m5, workspace, m1, m2, m3, m4);
+        benchmark::DoNotOptimize(m5.data().data());
+    }
+    state.SetComplexityN(state.range(0));
+}
+
+// Mult matrix and vector -----------------------------------------------------------------
+// Both products are bound by the bandwidth needed to stream the matrix, compare the Bytes counter with read_bandwidth.
+// With float matrices and Acc = double (mixed precision), the matrix-vector product streams half the bytes of the double one.
+template <typename Matrix, typename Acc = void>
+static void mult_matrix_vector(benchmark::State& state)
+{
+    using Scalar = typename Matrix::Scalar;
+    Matrix m1 = Matrix::randn(state.range(0), state.range(0));
+    Matrix v = Matrix::randn(state.range(0), 1);
+    Matrix res;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(res = mat_mult<Acc>(m1, v));
+    }
+    state.SetComplexityN(state.range(0));
+    state.counters["Bytes"] = bandwidth_counter(sizeof(Scalar) * state.range(0) * state.range(0));
+}
+
+template <typename Matrix>
+static void mult_vector_matrix(benchmark::State& state)
+{
+    using Scalar = typename Matrix::Scalar;
+    Matrix m1 = Matrix::randn(state.range(0), state.range(0));
+    Matrix v = Matrix::randn(1, state.range(0));
+    Matrix res;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(res = mat_mult(v, m1));
+    }
+    state.SetComplexityN(state.range(0));
+    state.counters["Bytes"] = bandwidth_counter(sizeof(Scalar) * state.range(0) * state.range(0));
+}
+
+// Reductions of a matrix, accumulated in Acc -----------------------------------------------------------------
+// Both are bound by the memory bandwidth: sum<double> of a float matrix runs at the speed of the float sum and twice the one of the double sum.
+template <typename Matrix, typename Acc = void>
+static void sum_matrix(benchmark::State& state)
+{
+    using Scalar = typename Matrix::Scalar;
+    Matrix m1 = Matrix::randn(state.range(0), state.range(0));
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(LinAlg::Matrices::Common::sum<Acc>(m1));
+    state.SetComplexityN(state.range(0));
+    state.counters["Bytes"] = bandwidth_counter(sizeof(Scalar) * state.range(0) * state.range(0));
+}
+
+template <typename Matrix, typename Acc = void>
+static void dot_matrices(benchmark::State& state)
+{
+    using Scalar = typename Matrix::Scalar;
+    Matrix m1 = Matrix::randn(state.range(0), state.range(0));
+    Matrix m2 = Matrix::randn(state.range(0), state.range(0));
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(LinAlg::Matrices::Common::dot<Acc>(m1, m2));
+    state.SetComplexityN(state.range(0));
+    state.counters["Bytes"] = bandwidth_counter(2. * sizeof(Scalar) * state.range(0) * state.range(0));
+}
+
+// Reference memory bandwidth: sum of an array with the size of an n x n matrix, reduced with independent partial sums.
+template <typename Scalar>
+static void read_bandwidth(benchmark::State& state)
+{
+    std::vector<Scalar> data(state.range(0) * state.range(0), Scalar(1));
+
+    for (auto _ : state)
+    {
+        Scalar acc[8] = {};
+        for (std::size_t i = 0; i + 8 <= data.size(); i += 8)
+            for (int l = 0; l < 8; ++l)
+                acc[l] += data[i + l];
+        benchmark::DoNotOptimize(acc);
+    }
     state.SetComplexityN(state.range(0));
+    state.counters["Bytes"] = bandwidth_counter(sizeof(Scalar) * state.range(0) * state.range(0));
+}
+
+// Batch of small matrix products, one mat_mult call per product -----------------------------------------------------------------
+// range(0) is the batch size and range(1) the size of the square matrices.
+template <typename Matrix>
+static void mult_small_matrices_loop(benchmark::State& state)
+{
+    const int batch = state.range(0);
+    const int size = state.range(1);
+    std::vector<Matrix> A(batch, Matrix::randn(size, size));
+    std::vector<Matrix> B(batch, Matrix::randn(size, size));
+    std::vector<Matrix> C(batch);
+
+    for (auto _ : state)
+    {
+        for (int b = 0; b < batch; ++b)
+            C[b] = mat_mult(A[b], B[b]);
+        benchmark::DoNotOptimize(C.data());
+    }
+    state.counters["products"] = benchmark::Counter(batch, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// Batch of small matrix products with batched_mat_mult -----------------------------------------------------------------
+// range(0) is the batch size, range(1) the size of the square matrices and range(2) the layout (0 contiguous, 1 interleaved).
+template <typename Scalar>
+static void mult_small_matrices_batched(benchmark::State& state)
+{
+    namespace Kernels = LinAlg::Matrices::Kernels;
+    const std::size_t batch = state.range(0);
+    const int size = state.range(1);
+    const auto layout = static_cast<Kernels::BatchLayout>(state.range(2));
+    state.SetLabel(layout == Kernels::BatchLayout::Interleaved ? "interleaved" : "contiguous");
+
+    const std::size_t n_elements = Kernels::batched_size<Scalar>(size, size, batch, layout);
+    std::vector<Scalar> A(n_elements, Scalar(1.5));
+    std::vector<Scalar> B(n_elements, Scalar(0.5));
+    std::vector<Scalar> C(n_elements);
+
+    for (auto _ : state)
+    {
+        LinAlg::Matrices::Common::batched_mat_mult<Scalar>(size, size, size, batch, A, B, C, layout);
+        benchmark::DoNotOptimize(C.data());
+    }
+    state.counters["products"] = benchmark::Counter(batch, benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["FLOP"] = flops_counter(batch * size, size, size);
+}
+
+// Batch of fixed size matrix products, one mat_mult call per product -----------------------------------------------------------------
+// range(0) is the batch size and range(1) the size N of the square matrices, from 2 to 16. Compare with mult_small_matrices_loop.
+template <typename Scalar, int N>
+static void mult_fixed_size_matrices_of_size(benchmark::State& state)
+{
+    using Matrix = ET::Matrix<Scalar, N, N>;
+    const int batch = state.range(0);
+    std::vector<Matrix> A(batch, Matrix::randn());
+    std::vector<Matrix> B(batch, Matrix::randn());
+    std::vector<Matrix> C(batch);
+
+    for (auto _ : state)
+    {
+        for (int b = 0; b < batch; ++b)
+            C[b] = mat_mult(A[b], B[b]);
+        benchmark::DoNotOptimize(C.data());
+    }
+    state.counters["products"] = benchmark::Counter(batch, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+template <typename Scalar>
+static void mult_fixed_size_matrices(benchmark::State& state)
+{
+    const int size = state.range(1);
+    [&]<int... N>(std::integer_sequence<int, N...>)
+    { ((size == N + 2 && (mult_fixed_size_matrices_of_size<Scalar, N + 2>(state), true)) || ...); }(std::make_integer_sequence<int, 15> {});
+}
+
+// Batch of small LU factorizations and solves -----------------------------------------------------------------
+// range(0) is the batch size and range(1) the size of the square matrices.
+template <typename Matrix>
+static void LU_small_matrices_loop(benchmark::State& state)
+{
+    const int batch = state.range(0);
+    const int size = state.range(1);
+    std::vector<Matrix> A(batch, Matrix::randn(size, size, 10., 1.));
+    std::vector<Matrix> b(batch, Matrix::randn(size, 1));
+    std::vector<Matrix> x(batch);
+
+    for (auto _ : state)
+    {
+        for (int i = 0; i < batch; ++i)
+        {
+            LinAlg::Solvers::LU lu(A[i]);
+            x[i] = lu.solve(b[i]);
+        }
+        benchmark::DoNotOptimize(x.data());
+    }
+    state.counters["solves"] = benchmark::Counter(batch, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// The same with fixed size matrices and FixedLU. range(1) is between 2 and 16.
+template <typename Scalar, int N>
+static void LU_fixed_size_matrices_of_size(benchmark::State& state)
+{
+    using Matrix = ET::Matrix<Scalar, N, N>;
+    using Vector = ET::Matrix<Scalar, N, 1>;
+    const int batch = state.range(0);
+    std::vector<Matrix> A(batch, Matrix::randn(N, N, 10., 1.));
+    std::vector<Vector> b(batch, Vector::randn());
+    std::vector<Vector> x(batch);
+
+    for (auto _ : state)
+    {
+        for (int i = 0; i < batch; ++i)
+            x[i] = LinAlg::Solvers::FixedLU(A[i]).solve(b[i]);
+        benchmark::DoNotOptimize(x.data());
+    }
+    state.counters["solves"] = benchmark::Counter(batch, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+template <typename Scalar>
+static void LU_fixed_size_matrices(benchmark::State& state)
+{
+    const int size = state.range(1);
+    [&]<int... N>(std::integer_sequence<int, N...>)
+    { ((size == N + 2 && (LU_fixed_size_matrices_of_size<Scalar, N + 2>(state), true)) || ...); }(std::make_integer_sequence<int, 15> {});
 }
 
 // Mult four matrices -----------------------------------------------------------------
@@ -224,6 +974,41 @@ static void mult_four_matrices(benchmark::State& state)
     state.SetComplexityN(state.range(0));
 }
 
+// Mult a rectangular chain -----------------------------------------------------------------
+/*
+    The chain (8 x n) * (n x n) * (n x n) costs O(n^2) when evaluated from the left and O(n^3) from the right.
+    mult_rect_chain lets mat_mult choose the order, mult_rect_chain_right_fold forces the right to left evaluation.
+*/
+template <typename Matrix>
+static void mult_rect_chain(benchmark::State& state)
+{
+    Matrix m1 = Matrix::randn(8, state.range(0));
+    Matrix m2 = Matrix::randn(state.range(0), state.range(0));
+    Matrix m3 = Matrix::randn(state.range(0), state.range(0));
+    Matrix m4;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(m4 = mat_mult(m1, m2, m3));
+    }
+    state.SetComplexityN(state.range(0));
+}
+
+template <typename Matrix>
+static void mult_rect_chain_right_fold(benchmark::State& state)
+{
+    Matrix m1 = Matrix::randn(8, state.range(0));
+    Matrix m2 = Matrix::randn(state.range(0), state.range(0));
+    Matrix m3 = Matrix::randn(state.range(0), state.range(0));
+    Matrix m4;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(m4 = mat_mult(m1, mat_mult(m2, m3)));
+    }
+    state.SetComplexityN(state.range(0));
+}
+
 // Long Operation four matrices -----------------------------------------------------------------
 template <typename Matrix>
 static void long_op_matrices(benchmark::State& state)
@@ -246,6 +1031,7 @@ static void long_op_matrices(benchmark::State& state)
 }
 
 // Mult two epressions -----------------------------------------------------------------
+// The FLOP counter only counts the product, hence it is directly comparable with mult_two_matrices.
 template <typename Matrix>
 static void mult_two_expr(benchmark::State& state)
 {
@@ -261,6 +1047,7 @@ static void mult_two_expr(benchmark::State& state)
         benchmark::DoNotOptimize(m5 = mat_mult(m1 * m2 + m3 * m4, m2 * m3 - m4 * m1));
     }
     state.SetComplexityN(state.range(0));
+    state.counters["FLOP"] = flops_counter(state.range(0), state.range(0), state.range(0));
 }
 
 // Mult two epressions with preeval -----------------------------------------------------------------
@@ -279,6 +1066,7 @@ static void mult_two_expr_preeval(benchmark::State& state)
         benchmark::DoNotOptimize(m5 = mat_mult<true>(m1 * m2 + m3 * m4, m2 * m3 - m4 * m1));
     }
     state.SetComplexityN(state.range(0));
+    state.counters["FLOP"] = flops_counter(state.range(0), state.range(0), state.range(0));
 }
 
 // LU factorization matrix -----------------------------------------------------------------
@@ -289,12 +1077,14 @@ static void LU_factorization(benchmark::State& state)
     Matrix m = Matrix::randn(state.range(0), state.range(0));
     LinAlg::Solvers::LU lu(m);
 
+    const std::size_t allocations = heap_allocations;
     for (auto _ : state)
     {
         lu.reinit(m);
         lu.factorize();
     }
     state.SetComplexityN(state.range(0));
+    state.counters["allocs"] = allocations_counter(allocations);
 }
 
 // LU solve -----------------------------------------------------------------
@@ -313,3 +1103,83 @@ static void LU_solve(benchmark::State& state)
     }
     state.SetComplexityN(state.range(0));
 }
+
+// Sparse matrices -----------------------------------------------------------------
+using LinAlg::Matrices::Common::SparseFormat;
+
+// Sparsity patterns of the generated sparse matrices, with about sparse_row_length non-zeros per row on average.
+enum class SparsePattern
+{
+    Banded,  // A band of sparse_row_length diagonals around the main one, as in finite difference discretizations.
+    Random,  // Uniformly distributed non-zeros.
+    PowerLaw // Row lengths following a power law: a few rows hold most of the non-zeros, as in graph adjacency matrices.
+};
+
+constexpr int sparse_row_length = 16;
+
+template <typename Sparse>
+Sparse sparse_matrix(int n, SparsePattern pattern, int seed = 1)
+{
+    using Scalar = typename Sparse::Scalar;
+    using Triplet = LinAlg::Matrices::Common::Triplet<Scalar>;
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> index(0, n - 1);
+    std::uniform_real_distribution<double> uniform(0., 1.);
+    std::vector<Triplet> triplets;
+    triplets.reserve(static_cast<std::size_t>(n) * sparse_row_length);
+
+    if (pattern == SparsePattern::Banded)
+    {
+        for (int i = 0; i < n; ++i)
+            for (int j = std::max(0, i - sparse_row_length / 2); j < std::min(n, i + sparse_row_length / 2); ++j)
+                triplets.push_back({ i, j, static_cast<Scalar>(uniform(gen)) });
+    }
+    else
+        for (std::size_t nz = 0; nz < static_cast<std::size_t>(n) * sparse_row_length; ++nz)
+        {
+            // n * u^3 has the density x^(-2/3) / (3 n^(1/3)) on [0, n]: the first rows are much longer than the last ones.
+            const double u = uniform(gen);
+            const int row = pattern == SparsePattern::Random ? index(gen) : std::min(n - 1, static_cast<int>(n * u * u * u));
+            triplets.push_back({ row, index(gen), static_cast<Scalar>(uniform(gen)) });
+        }
+    return Sparse::from_triplets(n, n, triplets);
+}
+
+// Product of an n x n sparse matrix with a dense vector (SpMV), or with a dense n x sparse_row_length matrix (SpMM).
+template <typename Matrix, SparseFormat Format, SparsePattern Pattern, int cols = 1>
+static void mult_sparse_dense(benchmark::State& state)
+{
+    using Scalar = typename Matrix::Scalar;
+    using Sparse = LinAlg::Matrices::Common::SparseMatrix<Scalar, Format>;
+    const int n = state.range(0);
+    Sparse m1 = sparse_matrix<Sparse>(n, Pattern);
+    Matrix m2 = Matrix::randn(n, cols);
+    Matrix m3;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(m3 = mat_mult(m1, m2));
+    }
+    state.SetComplexityN(n);
+    state.counters["FLOP"] = benchmark::Counter(2. * m1.non_zeros() * cols, benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["Bytes"] = bandwidth_counter((sizeof(Scalar) + sizeof(int)) * m1.non_zeros() + 2. * sizeof(Scalar) * n * cols);
+}
+
+// The same product with the sparse matrix stored densely, as a reference.
+template <typename Matrix, SparsePattern Pattern, int cols = 1>
+static void mult_sparse_as_dense(benchmark::State& state)
+{
+    using Scalar = typename Matrix::Scalar;
+    using Sparse = LinAlg::Matrices::Common::SparseMatrix<Scalar>;
+    const int n = state.range(0);
+    Matrix m1(sparse_matrix<Sparse>(n, Pattern));
+    Matrix m2 = Matrix::randn(n, cols);
+    Matrix m3;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(m3 = mat_mult(m1, m2));
+    }
+    state.SetComplexityN(n);
+    state.counters["FLOP"] = flops_counter(n, cols, n);
+}
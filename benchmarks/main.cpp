@@ -1,12 +1,35 @@
 
 #include "include/ET_VS_RG.hpp"
 #include "include/STL_VS_CST.hpp"
+#include "include/Sparse.hpp"
 
 double min_time = 1.0;
 double min_warmup_time = 1.0;
 int range_min = 2;
 int squared_compl_range_max = 8192;
 int cubic_compl_range_max = 512;
+int sparse_range_max = 1 << 20;
 int range_mult = 4;
 
+// The global operator new is replaced to count the heap allocations (see allocations_counter).
+std::atomic<std::size_t> heap_allocations { 0 };
+
+void* operator new(std::size_t size)
+{
+    heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
 BENCHMARK_MAIN();
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <Matrices/Common/Arena.hpp>
+#include <stdafx.hpp>
+
+namespace LinAlg::Matrices::Common
+{
+    /**
+     * @brief Size of a cache line, to which the coefficients of the matrices are aligned.
+     */
+    inline constexpr std::size_t cache_line_size = 64;
+
+    /**
+     * @brief An allocator returning memory aligned to Alignment bytes, by default a cache line.
+     *
+     * The rows of a matrix whose leading dimension is a multiple of the cache line (see padded_leading_dimension) then all start on a cache line,
+     * and the vectorized loops of the kernels never load a vector split across two lines.
+     *
+     * The memory is over-allocated with the plain operator new, and the offset of the aligned block is stored just before it. The aligned
+     * operator new would be simpler, but glibc serves it with memalign, which does not reuse the large freed blocks: every large temporary
+     * matrix would then be mapped and faulted in again.
+     *
+     * While the library allocates temporaries in an ArenaScope, the memory is taken from its arena instead, and the stored offset is zero:
+     * such blocks are not freed one by one but released with the arena.
+     *
+     * The elements constructed without arguments are default initialized, as by new T, instead of value initialized: a std::vector<T, AlignedAllocator<T>>(n)
+     * of scalars is left uninitialized, and does not write its memory twice when it is filled next, as the results of the products.
+     *
+     * @tparam T value type
+     * @tparam Alignment alignment in bytes, a power of two
+     */
+    template <typename T, std::size_t Alignment = cache_line_size>
+    class AlignedAllocator
+    {
+        static_assert(std::has_single_bit(Alignment) && Alignment >= alignof(T) && Alignment >= sizeof(std::ptrdiff_t),
+                      "The alignment must be a power of two, at least the one of T and of a pointer offset.");
+
+      public:
+        using value_type = T;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = AlignedAllocator<U, Alignment>;
+        };
+
+        AlignedAllocator() noexcept = default;
+        template <typename U>
+        AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept
+        {
+        }
+
+        T* allocate(std::size_t n)
+        {
+            const std::size_t bytes = n * sizeof(T) + Alignment;
+            if (Arena* arena = _implementation_details::temporaries_arena())
+            {
+                std::byte* aligned = static_cast<std::byte*>(arena->allocate(bytes, Alignment)) + Alignment;
+                reinterpret_cast<std::ptrdiff_t*>(aligned)[-1] = 0;
+                return reinterpret_cast<T*>(aligned);
+            }
+
+            std::byte* raw = static_cast<std::byte*>(::operator new(bytes));
+            std::byte* aligned = raw + (Alignment - reinterpret_cast<std::uintptr_t>(raw) % Alignment);
+            reinterpret_cast<std::ptrdiff_t*>(aligned)[-1] = aligned - raw;
+            return reinterpret_cast<T*>(aligned);
+        }
+
+        void deallocate(T* ptr, std::size_t) noexcept
+        {
+            std::byte* aligned = reinterpret_cast<std::byte*>(ptr);
+            if (const std::ptrdiff_t offset = reinterpret_cast<std::ptrdiff_t*>(aligned)[-1]; offset != 0)
+                ::operator delete(aligned - offset);
+        }
+
+        template <typename U>
+        void construct(U* ptr) noexcept(std::is_nothrow_default_constructible_v<U>) ///< Default initializes an element.
+        {
+            ::new (static_cast<void*>(ptr)) U;
+        }
+
+        template <typename U, typename... Args>
+        void construct(U* ptr, Args&&... args) ///< Constructs an element from args.
+        {
+            ::new (static_cast<void*>(ptr)) U(std::forward<Args>(args)...);
+        }
+
+        template <typename U>
+        bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept
+        {
+            return true;
+        }
+    };
+
+    /**
+     * @brief Returns a leading dimension (distance between the first coefficients of two consecutive rows) suited to a row-major matrix
+     * with cols columns of type T.
+     *
+     * The rows are rounded up to a whole number of cache lines. If the row size is then a multiple of 512 bytes, as for the power of two sizes,
+     * a cache line is added: otherwise the coefficients of a column map to a few sets of the cache only, and evict each other when the columns
+     * are read, as when packing the transpose of a matrix or sweeping a column in LU.
+     *
+     * @tparam T scalar type
+     * @param cols number of columns
+     */
+    template <typename T>
+    constexpr int padded_leading_dimension(int cols)
+    {
+        constexpr int line = std::max<int>(1, cache_line_size / sizeof(T));
+        int ld = (cols + line - 1) / line * line;
+        if ((static_cast<std::size_t>(ld) * sizeof(T)) % 512 == 0)
+            ld += line;
+        return ld;
+    }
+}
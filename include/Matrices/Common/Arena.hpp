@@ -0,0 +1,138 @@
+#pragma once
+
+#include <stdafx.hpp>
+
+namespace LinAlg::Matrices::Common
+{
+    /**
+     * @brief A memory arena for the temporary matrices of the library: the intermediate products of the chains in mat_mult, the expressions
+     * it evaluates first (mat_mult<true>) and the dense operands evaluated for the sparse products.
+     *
+     * Allocations are taken one after the other from a buffer allocated once, and are not freed one by one: release() frees them all at once
+     * and makes the whole buffer available again. Allocations which do not fit in the buffer are taken from the heap, and returned by release().
+     * The temporaries are drawn from the arena only while an ArenaScope on it is alive, in the thread of the scope: the arena is not thread-safe.
+     */
+    class Arena
+    {
+      public:
+        static constexpr std::size_t default_capacity = std::size_t(16) << 20; ///< 16 MiB.
+
+        explicit Arena(std::size_t capacity = default_capacity);
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        void* allocate(std::size_t bytes, std::size_t alignment); ///< Returns bytes bytes aligned to alignment, valid until release().
+        void release();                                           ///< Frees all the allocations. The buffer is kept for the next ones.
+        std::size_t capacity() const { return m_capacity; }       ///< Returns the size of the buffer, in bytes.
+
+      private:
+        std::unique_ptr<std::byte[]> m_buffer;
+        std::size_t m_capacity;
+        std::pmr::monotonic_buffer_resource m_resource;
+    };
+
+    /**
+     * @brief Draws the temporaries of the calling thread from an arena while alive, and releases the arena when destroyed.
+     *
+     * Typically, a scope wraps each iteration of a loop, hence the temporaries cost no heap allocation once the arena is large enough:
+     *
+     *     Arena arena;
+     *     for (...)
+     *     {
+     *         ArenaScope scope(arena);
+     *         x = mat_mult(A, B, C);
+     *     }
+     *
+     * The matrices returned to the caller are never allocated from the arena, hence they can outlive the scope. Scopes can be nested
+     * on different arenas, the innermost one is used.
+     */
+    class ArenaScope
+    {
+      public:
+        explicit ArenaScope(Arena& arena);
+        ~ArenaScope();
+        ArenaScope(const ArenaScope&) = delete;
+        ArenaScope& operator=(const ArenaScope&) = delete;
+
+      private:
+        Arena& m_arena;
+        Arena* m_previous;
+    };
+
+    namespace _implementation_details
+    {
+        inline thread_local Arena* active_arena = nullptr;
+        inline thread_local int temporaries_depth = 0;
+
+        /**
+         * @brief Returns the arena the calling thread allocates from, or nullptr: the one of the innermost ArenaScope, while the library
+         * allocates temporaries (see as_temporary()).
+         */
+        inline Arena* temporaries_arena()
+        {
+            return temporaries_depth > 0 ? active_arena : nullptr;
+        }
+
+        /**
+         * @brief Returns f(), allocating the matrices created meanwhile by the calling thread from the active arena, if any.
+         *
+         * Only for matrices which do not outlive the computation of the library calling it.
+         */
+        template <typename F>
+        constexpr decltype(auto) as_temporary(F&& f)
+        {
+            struct Guard
+            {
+                constexpr Guard()
+                {
+                    if (!std::is_constant_evaluated())
+                        ++temporaries_depth;
+                }
+                constexpr ~Guard()
+                {
+                    if (!std::is_constant_evaluated())
+                        --temporaries_depth;
+                }
+            } guard;
+            return std::forward<F>(f)();
+        }
+    }
+}
+
+/*
+    Implementation
+    -----------------------------------------------------------------------------------------
+*/
+namespace LinAlg::Matrices::Common
+{
+    inline Arena::Arena(std::size_t capacity)
+        : m_buffer(std::make_unique_for_overwrite<std::byte[]>(capacity))
+        , m_capacity(capacity)
+        , m_resource(m_buffer.get(), capacity)
+    {
+    }
+
+    inline void* Arena::allocate(std::size_t bytes, std::size_t alignment)
+    {
+        return m_resource.allocate(bytes, alignment);
+    }
+
+    inline void Arena::release()
+    {
+        m_resource.release();
+    }
+
+    inline ArenaScope::ArenaScope(Arena& arena)
+        : m_arena(arena)
+        , m_previous(_implementation_details::active_arena)
+    {
+        assert(m_previous != &arena && "Nested scopes on the same arena would release the allocations of the outer one.");
+        _implementation_details::active_arena = &arena;
+    }
+
+    inline ArenaScope::~ArenaScope()
+    {
+        _implementation_details::active_arena = m_previous;
+        m_arena.release();
+    }
+}
@@ -32,7 +32,7 @@ namespace LinAlg::Matrices::Common
       public:
         using Scalar = traits<Derived>::Scalar;
 
-        MatrixBase(int rows, int cols);
+        constexpr MatrixBase(int rows, int cols);
         MatrixBase(const MatrixBase& other);
         MatrixBase(MatrixBase&& other) noexcept;
         ~MatrixBase() = default;
@@ -84,7 +84,7 @@ namespace LinAlg::Matrices::Common
      */
 
     template <typename Derived>
-    MatrixBase<Derived>::MatrixBase(int rows, int cols)
+    constexpr MatrixBase<Derived>::MatrixBase(int rows, int cols)
         : m_rows { rows }
         , m_cols { cols }
     {
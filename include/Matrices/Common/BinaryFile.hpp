@@ -0,0 +1,360 @@
+#pragma once
+
+#include <Matrices/Common/Base.hpp>
+#include <Matrices/Common/ForwardDeclarations.hpp>
+#include <Matrices/Common/MappedArray.hpp>
+#include <Matrices/Common/Matrix.hpp>
+#include <Matrices/Kernels/Operands.hpp>
+#include <stdafx.hpp>
+
+namespace LinAlg::Matrices::Common
+{
+    /**
+     * @brief Kind of the scalars stored in a binary matrix file, their size in bytes being stored next to it.
+     */
+    enum class BinaryScalar : std::uint32_t
+    {
+        SignedInteger,
+        UnsignedInteger,
+        FloatingPoint
+    };
+
+    /**
+     * @brief Order of the coefficients in a binary matrix file.
+     */
+    enum class BinaryLayout : std::uint32_t
+    {
+        RowMajor,
+        ColMajor
+    };
+
+    /**
+     * @brief Header of a binary matrix file, written by save_binary.
+     *
+     * The file is the 64 bytes header followed, data_offset bytes after its beginning, by the rows * cols coefficients without padding,
+     * in the order of layout and the byte order of the machine which wrote it. The data offset is a multiple of 64 bytes: as the mappings
+     * start on a page, the mapped coefficients are aligned on a cache line (see map_binary). The readers use data_offset rather than the size
+     * of the header, which newer versions can extend.
+     */
+    struct BinaryHeader
+    {
+        static constexpr std::array<char, 8> expected_magic { 'L', 'I', 'N', 'A', 'L', 'G', 'M', 'X' };
+        static constexpr std::uint32_t current_version = 1;
+        static constexpr std::uint32_t expected_byte_order = 0x01020304;
+        static constexpr std::uint32_t has_checksum = 1; ///< Flag set if checksum is the one of the coefficients (see BinaryChecksum).
+
+        std::array<char, 8> magic;
+        std::uint32_t version;
+        std::uint32_t byte_order; ///< expected_byte_order written with the byte order of the coefficients.
+        BinaryScalar scalar;
+        std::uint32_t scalar_size;
+        BinaryLayout layout;
+        std::uint32_t flags;
+        std::uint64_t rows;
+        std::uint64_t cols;
+        std::uint64_t data_offset; ///< Position of the first coefficient in the file, in bytes.
+        std::uint64_t checksum;
+    };
+
+    static_assert(sizeof(BinaryHeader) == 64 && std::is_trivially_copyable_v<BinaryHeader>);
+
+    /**
+     * @brief Checksum of the coefficients of a binary matrix file, to detect a corrupted or truncated checkpoint (it is not cryptographic).
+     *
+     * The bytes are read by 64 bit words, hashed into four independent lanes so that the hash runs at the memory bandwidth rather than
+     * at the latency of the multiplications. The bytes can be given in several calls to update().
+     */
+    class BinaryChecksum
+    {
+      public:
+        void update(const void* data, std::size_t size);
+        std::uint64_t value() const;
+
+      private:
+        static constexpr std::uint64_t prime = 0x100000001b3;
+        static constexpr std::size_t block_size = 32; ///< One word per lane.
+
+        void hash_block(const std::byte* block);
+
+        std::array<std::uint64_t, 4> m_lanes { 0xcbf29ce484222325, 0x84222325cbf29ce4, 0x9ce484222325cbf2, 0x2325cbf29ce48422 };
+        std::array<std::byte, block_size> m_pending {}; ///< Bytes of an incomplete block.
+        std::size_t m_pending_size { 0 };
+        std::uint64_t m_size { 0 };
+    };
+
+    BinaryHeader read_binary_header(const std::filesystem::path& path);
+
+    template <typename Derived>
+    void save_binary(const std::filesystem::path& path, const MatrixBase<Derived>& mat, bool checksum = true);
+
+    template <typename MatrixType>
+    MatrixType load_binary(const std::filesystem::path& path, bool verify = true);
+
+    template <typename MappedMatrixType>
+    MappedMatrixType map_binary(const std::filesystem::path& path, MapMode mode = MapMode::ReadOnly, MapAccess access = MapAccess::Sequential, bool verify = false);
+
+    namespace _implementation_details
+    {
+        template <typename T>
+        inline constexpr BinaryScalar binary_scalar = std::is_floating_point_v<T> ? BinaryScalar::FloatingPoint
+            : std::is_signed_v<T>                                                 ? BinaryScalar::SignedInteger
+                                                                                  : BinaryScalar::UnsignedInteger;
+
+        /**
+         * @brief Throws a std::runtime_error if the file described by header does not store a matrix of T which fits the int dimensions.
+         */
+        template <typename T>
+        void check_binary_header(const BinaryHeader& header, const std::filesystem::path& path)
+        {
+            if (header.scalar != binary_scalar<T> || header.scalar_size != sizeof(T))
+                throw std::runtime_error(path.string() + " stores another scalar type");
+            if (header.rows > static_cast<std::uint64_t>(std::numeric_limits<int>::max()) || header.cols > static_cast<std::uint64_t>(std::numeric_limits<int>::max()))
+                throw std::runtime_error(path.string() + " stores a matrix too large for int dimensions");
+            if (header.data_offset % alignof(T) != 0)
+                throw std::runtime_error(path.string() + " stores misaligned coefficients");
+        }
+
+        /**
+         * @brief Maps the coefficients of a binary matrix file of T, after checking its header and, if verify, their checksum.
+         */
+        template <typename T>
+        MappedArray<T> map_binary_coefficients(const std::filesystem::path& path, const BinaryHeader& header, MapMode mode, MapAccess access, bool verify)
+        {
+            check_binary_header<T>(header, path);
+            MappedArray<T> data = MappedArray<T>::open(path, mode, access, header.data_offset, header.rows * header.cols);
+            if (verify && (header.flags & BinaryHeader::has_checksum))
+            {
+                BinaryChecksum checksum;
+                checksum.update(data.data(), data.size() * sizeof(T));
+                if (checksum.value() != header.checksum)
+                    throw std::runtime_error("The coefficients stored in " + path.string() + " do not match their checksum");
+            }
+            return data;
+        }
+
+        /**
+         * @brief Calls write with consecutive spans of the coefficients of mat, in column-major order if mat is stored so, else in row-major order.
+         *
+         * The coefficients of a matrix stored without padding are given at once, the others are gathered into a buffer first.
+         */
+        template <typename Mat, typename Write>
+        void write_coefficients(const Mat& mat, Write&& write)
+        {
+            using T = LinAlg::CommonScalar<Mat>;
+            constexpr bool col_major = Kernels::Concepts::ColMajorMatrix<Mat>;
+            const int outer = col_major ? mat.cols() : mat.rows();
+            const int inner = col_major ? mat.rows() : mat.cols();
+
+            if constexpr (Kernels::Concepts::ContiguousMatrix<Mat> || col_major)
+                if (Kernels::leading_dimension(mat) == inner)
+                {
+                    write(std::ranges::data(mat.data()), static_cast<std::size_t>(outer) * inner);
+                    return;
+                }
+
+            constexpr std::size_t buffer_size = (std::size_t(1) << 16) / sizeof(T);
+            std::vector<T> buffer;
+            buffer.reserve(std::min(buffer_size, static_cast<std::size_t>(outer) * inner));
+            for (int o = 0; o < outer; ++o)
+                for (int i = 0; i < inner; ++i)
+                {
+                    buffer.push_back(col_major ? mat[i, o] : mat[o, i]);
+                    if (buffer.size() == buffer_size)
+                    {
+                        write(buffer.data(), buffer.size());
+                        buffer.clear();
+                    }
+                }
+            write(buffer.data(), buffer.size());
+        }
+    }
+}
+
+/*
+    Implementation
+    -----------------------------------------------------------------------------------------
+*/
+namespace LinAlg::Matrices::Common
+{
+    inline void BinaryChecksum::hash_block(const std::byte* block)
+    {
+        for (std::size_t lane = 0; lane < m_lanes.size(); ++lane)
+        {
+            std::uint64_t word;
+            std::memcpy(&word, block + lane * sizeof(word), sizeof(word));
+            m_lanes[lane] = std::rotl((m_lanes[lane] ^ word) * prime, 31);
+        }
+    }
+
+    inline void BinaryChecksum::update(const void* data, std::size_t size)
+    {
+        const std::byte* bytes = static_cast<const std::byte*>(data);
+        m_size += size;
+        if (m_pending_size > 0)
+        {
+            const std::size_t count = std::min(size, block_size - m_pending_size);
+            std::memcpy(m_pending.data() + m_pending_size, bytes, count);
+            m_pending_size += count;
+            bytes += count;
+            size -= count;
+            if (m_pending_size < block_size)
+                return;
+            hash_block(m_pending.data());
+            m_pending_size = 0;
+        }
+        for (; size >= block_size; bytes += block_size, size -= block_size)
+            hash_block(bytes);
+        std::memcpy(m_pending.data(), bytes, size);
+        m_pending_size = size;
+    }
+
+    /**
+     * @brief Returns the checksum of the bytes given so far: the last incomplete block is padded with zeros, and the number of bytes is hashed too.
+     */
+    inline std::uint64_t BinaryChecksum::value() const
+    {
+        BinaryChecksum last = *this;
+        if (m_pending_size > 0)
+        {
+            std::fill(last.m_pending.begin() + m_pending_size, last.m_pending.end(), std::byte { 0 });
+            last.hash_block(last.m_pending.data());
+        }
+        std::uint64_t hash = m_size;
+        for (const std::uint64_t lane : last.m_lanes)
+            hash = std::rotl((hash ^ lane) * prime, 31);
+        return hash;
+    }
+
+    /**
+     * @brief Reads the header of a binary matrix file, and throws a std::runtime_error if the file is not one that this version can read.
+     */
+    inline BinaryHeader read_binary_header(const std::filesystem::path& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            _implementation_details::throw_system_error("Cannot open " + path.string());
+
+        BinaryHeader header;
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.magic != BinaryHeader::expected_magic)
+            throw std::runtime_error(path.string() + " is not a binary matrix file");
+        if (header.version > BinaryHeader::current_version)
+            throw std::runtime_error(path.string() + " was written by a newer version of the binary matrix format");
+        if (header.byte_order != BinaryHeader::expected_byte_order)
+            throw std::runtime_error(path.string() + " was written with another byte order");
+        if (header.layout != BinaryLayout::RowMajor && header.layout != BinaryLayout::ColMajor)
+            throw std::runtime_error(path.string() + " stores an unknown layout");
+        return header;
+    }
+
+    /**
+     * @brief Writes a matrix (or an expression) into a binary matrix file: a BinaryHeader followed by the raw coefficients.
+     *
+     * The column-major matrices are written in column-major order, the others in row-major order, so that the contiguous matrices without padding
+     * are written in a single call. The file is written in one pass, the checksum being computed on the way and written into the header last.
+     *
+     * @param path file to create or overwrite
+     * @param mat matrix or expression
+     * @param checksum whether to store the checksum of the coefficients, which costs about as much as reading them
+     */
+    template <typename Derived>
+    void save_binary(const std::filesystem::path& path, const MatrixBase<Derived>& mat, bool checksum)
+    {
+        using T = LinAlg::CommonScalar<Derived>;
+        static_assert(std::is_arithmetic_v<T>, "Only the matrices of integers and floating point numbers can be saved.");
+        constexpr std::uint64_t data_offset = 64;
+
+        BinaryHeader header {
+            .magic = BinaryHeader::expected_magic,
+            .version = BinaryHeader::current_version,
+            .byte_order = BinaryHeader::expected_byte_order,
+            .scalar = _implementation_details::binary_scalar<T>,
+            .scalar_size = sizeof(T),
+            .layout = Kernels::Concepts::ColMajorMatrix<Derived> ? BinaryLayout::ColMajor : BinaryLayout::RowMajor,
+            .flags = checksum ? BinaryHeader::has_checksum : 0,
+            .rows = static_cast<std::uint64_t>(mat.rows()),
+            .cols = static_cast<std::uint64_t>(mat.cols()),
+            .data_offset = data_offset,
+            .checksum = 0,
+        };
+        static_assert(data_offset >= sizeof(BinaryHeader) && data_offset % 64 == 0);
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file)
+            _implementation_details::throw_system_error("Cannot create " + path.string());
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        BinaryChecksum coefficients_checksum;
+        _implementation_details::write_coefficients(static_cast<const Derived&>(mat), [&](const T* data, std::size_t size)
+        {
+            if (checksum)
+                coefficients_checksum.update(data, size * sizeof(T));
+            file.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size * sizeof(T)));
+        });
+
+        if (checksum)
+        {
+            header.checksum = coefficients_checksum.value();
+            file.seekp(0);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        }
+        file.close();
+        if (!file)
+            _implementation_details::throw_system_error("Cannot write " + path.string());
+    }
+
+    /**
+     * @brief Reads a binary matrix file into a new matrix, stored in memory.
+     *
+     * The file is mapped and its coefficients copied into the matrix, converting them to its layout if the file stores the other one.
+     * The scalar type must be the one of the file: the coefficients are not converted.
+     *
+     * @tparam MatrixType type of the matrix, for instance ET::Matrix<double> or ET::ColMajorMatrix<double>
+     * @param path file written by save_binary
+     * @param verify whether to check the checksum of the coefficients, if the file stores one
+     */
+    template <typename MatrixType>
+    MatrixType load_binary(const std::filesystem::path& path, bool verify)
+    {
+        using T = typename MatrixType::Scalar;
+        const BinaryHeader header = read_binary_header(path);
+        MappedArray<T> data = _implementation_details::map_binary_coefficients<T>(path, header, MapMode::ReadOnly, MapAccess::Sequential, verify);
+        const int rows = static_cast<int>(header.rows);
+        const int cols = static_cast<int>(header.cols);
+
+        if (header.layout == BinaryLayout::ColMajor)
+            return MatrixType(Matrix<MappedArray<T>, ColMajor>(rows, cols, std::move(data)));
+        return MatrixType(Matrix<MappedArray<T>, RowMajor>(rows, cols, std::move(data)));
+    }
+
+    /**
+     * @brief Maps the coefficients of a binary matrix file into a matrix, without copying nor parsing them: the pages are read when first
+     * accessed (see MappedArray). Only the row-major files can be mapped, load_binary reads the others.
+     *
+     * Writing into a ReadWrite mapping changes the file in place, so its checksum is dropped from the header.
+     *
+     * @tparam MappedMatrixType type of the matrix, ET::MappedMatrix<T> or RG::MappedMatrix<T>
+     * @param path file written by save_binary
+     * @param mode ReadOnly, or ReadWrite to write the modified coefficients back to the file
+     * @param access access pattern announced to the kernel
+     * @param verify whether to check the checksum of the coefficients, which reads the whole file
+     */
+    template <typename MappedMatrixType>
+    MappedMatrixType map_binary(const std::filesystem::path& path, MapMode mode, MapAccess access, bool verify)
+    {
+        using T = typename MappedMatrixType::Scalar;
+        BinaryHeader header = read_binary_header(path);
+        if (header.layout != BinaryLayout::RowMajor)
+            throw std::runtime_error(path.string() + " stores a column-major matrix, which cannot be mapped into a row-major one");
+        MappedArray<T> data = _implementation_details::map_binary_coefficients<T>(path, header, mode, access, verify);
+
+        if (mode == MapMode::ReadWrite && (header.flags & BinaryHeader::has_checksum))
+        {
+            header.flags &= ~BinaryHeader::has_checksum;
+            header.checksum = 0;
+            std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+            if (!file.write(reinterpret_cast<const char*>(&header), sizeof(header)))
+                _implementation_details::throw_system_error("Cannot write " + path.string());
+        }
+        return MappedMatrixType(static_cast<int>(header.rows), static_cast<int>(header.cols), std::move(data));
+    }
+}
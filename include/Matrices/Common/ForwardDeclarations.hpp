@@ -7,9 +7,17 @@ namespace LinAlg::Matrices::Common
     template <typename Derived>
     class MatrixBase;
 
-    template <typename Cont>
+    struct RowMajor;
+    struct ColMajor;
+    template <int TileSize>
+    struct Tiled;
+
+    template <typename Cont, typename StorageLayout = RowMajor>
     class Matrix;
 
+    template <typename T>
+    class MappedArray;
+
     template <typename T>
     class Constant;
 
@@ -18,6 +26,86 @@ namespace LinAlg::Matrices::Common
 
     template <typename T>
     class Identity;
+
+    /**
+     * @brief Storage format of a SparseMatrix.
+     */
+    enum class SparseFormat
+    {
+        CSR, ///< Compressed sparse rows: the non-zeros are stored row after row.
+        CSC  ///< Compressed sparse columns: the non-zeros are stored column after column.
+    };
+
+    template <typename T, SparseFormat Format = SparseFormat::CSR>
+    class SparseMatrix;
+
+    /**
+     * @brief Structure of a matrix known at compile time, declared by the helper matrices through a static member structure.
+     * mat_mult uses it to skip the products it makes trivial.
+     */
+    enum class MatrixStructure
+    {
+        General,  ///< No known structure.
+        Zero,     ///< All the coefficients are zero.
+        Identity, ///< A square matrix with ones on the diagonal and zeros elsewhere.
+        Constant  ///< All the coefficients have the same value.
+    };
+
+    template <typename Mat>
+    inline constexpr MatrixStructure structure_of = MatrixStructure::General;
+
+    template <typename Mat>
+        requires requires { Mat::structure; }
+    inline constexpr MatrixStructure structure_of<Mat> = Mat::structure;
+
+    /**
+     * @brief Dimension of a matrix which is only known at runtime.
+     */
+    inline constexpr int Dynamic = -1;
+
+    /**
+     * @brief Number of rows and of columns of a matrix known at compile time, declared by the fixed size matrices through the static members
+     * RowsAtCompileTime and ColsAtCompileTime, or Dynamic.
+     */
+    template <typename Mat>
+    inline constexpr int rows_at_compile_time = Dynamic;
+
+    template <typename Mat>
+        requires requires { Mat::RowsAtCompileTime; }
+    inline constexpr int rows_at_compile_time<Mat> = Mat::RowsAtCompileTime;
+
+    template <typename Mat>
+    inline constexpr int cols_at_compile_time = Dynamic;
+
+    template <typename Mat>
+        requires requires { Mat::ColsAtCompileTime; }
+    inline constexpr int cols_at_compile_time<Mat> = Mat::ColsAtCompileTime;
+
+    /**
+     * @brief Returns false if both dimensions are known at compile time and differ.
+     */
+    constexpr bool dimensions_match(int lhs, int rhs)
+    {
+        return lhs == Dynamic || rhs == Dynamic || lhs == rhs;
+    }
+
+    /**
+     * @brief Returns the first of the dimensions known at compile time, or Dynamic.
+     */
+    constexpr int common_dimension(std::initializer_list<int> dims)
+    {
+        for (int dim : dims)
+            if (dim != Dynamic)
+                return dim;
+        return Dynamic;
+    }
+
+    /**
+     * @brief False if the shapes of LHS and RHS are known at compile time and differ, as needed by coefficient wise operations.
+     */
+    template <typename LHS, typename RHS>
+    inline constexpr bool shapes_match = dimensions_match(rows_at_compile_time<std::remove_cvref_t<LHS>>, rows_at_compile_time<std::remove_cvref_t<RHS>>)
+                                         && dimensions_match(cols_at_compile_time<std::remove_cvref_t<LHS>>, cols_at_compile_time<std::remove_cvref_t<RHS>>);
 }
 
 namespace LinAlg
@@ -49,8 +137,29 @@ namespace LinAlg
         using ContType = void;
     };
 
-    template <typename Cont>
-    struct traits<LinAlg::Matrices::Common::Matrix<Cont>>
+    template <>
+    struct traits<std::int8_t>
+    {
+        using Scalar = std::int8_t;
+        using ContType = void;
+    };
+
+    template <>
+    struct traits<std::int16_t>
+    {
+        using Scalar = std::int16_t;
+        using ContType = void;
+    };
+
+    template <>
+    struct traits<std::int64_t>
+    {
+        using Scalar = std::int64_t;
+        using ContType = void;
+    };
+
+    template <typename Cont, typename StorageLayout>
+    struct traits<LinAlg::Matrices::Common::Matrix<Cont, StorageLayout>>
     {
         using Scalar = typename Cont::value_type;
         using ContType = Cont;
@@ -77,4 +186,11 @@ namespace LinAlg
         using ContType = void;
     };
 
+    template <typename T, LinAlg::Matrices::Common::SparseFormat Format>
+    struct traits<LinAlg::Matrices::Common::SparseMatrix<T, Format>>
+    {
+        using Scalar = T;
+        using ContType = void;
+    };
+
 }
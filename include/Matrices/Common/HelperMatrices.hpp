@@ -16,6 +16,7 @@ namespace LinAlg::Matrices::Common
     {
       public:
         using Scalar = T;
+        static constexpr MatrixStructure structure = MatrixStructure::Constant;
 
         Constant(int rows, int cols, const T& value)
             : MatrixBase<Constant<T>>(rows, cols)
@@ -46,6 +47,7 @@ namespace LinAlg::Matrices::Common
     {
       public:
         using Scalar = T;
+        static constexpr MatrixStructure structure = MatrixStructure::Zero;
 
         Zero(int rows, int cols)
             : MatrixBase<Zero<T>>(rows, cols)
@@ -72,6 +74,7 @@ namespace LinAlg::Matrices::Common
     {
       public:
         using Scalar = T;
+        static constexpr MatrixStructure structure = MatrixStructure::Identity;
 
         Identity(int n)
             : MatrixBase<Identity<T>>(n, n)
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <stdafx.hpp>
+
+namespace LinAlg::Matrices::Common
+{
+    /**
+     * @brief Row-major layout, the default one: the coefficient (i, j) is stored at i * ld + j, the leading dimension ld being the distance
+     * between the first coefficients of two consecutive rows.
+     */
+    struct RowMajor
+    {
+        static constexpr bool is_row_major = true;
+        static constexpr bool is_col_major = false;
+
+        static constexpr int min_leading_dimension(int, int cols) { return cols; } ///< Smallest leading dimension of a rows x cols matrix.
+        static constexpr bool valid_leading_dimension(int, int cols, int ld) { return ld >= cols; }
+        static constexpr std::size_t storage_size(int rows, int, int ld) { return static_cast<std::size_t>(rows) * ld; } ///< Number of stored coefficients.
+        static constexpr std::ptrdiff_t index(int i, int j, int ld) { return static_cast<std::ptrdiff_t>(i) * ld + j; }    ///< Position of (i, j) in the storage.
+    };
+
+    /**
+     * @brief Column-major layout: the coefficient (i, j) is stored at j * ld + i, the leading dimension ld being the distance between
+     * the first coefficients of two consecutive columns. The columns are contiguous, as in Fortran and BLAS.
+     */
+    struct ColMajor
+    {
+        static constexpr bool is_row_major = false;
+        static constexpr bool is_col_major = true;
+
+        static constexpr int min_leading_dimension(int rows, int) { return rows; }
+        static constexpr bool valid_leading_dimension(int rows, int, int ld) { return ld >= rows; }
+        static constexpr std::size_t storage_size(int, int cols, int ld) { return static_cast<std::size_t>(cols) * ld; }
+        static constexpr std::ptrdiff_t index(int i, int j, int ld) { return static_cast<std::ptrdiff_t>(j) * ld + i; }
+    };
+
+    /**
+     * @brief Blocked layout: the matrix is cut into TileSize x TileSize tiles, stored one after the other row by row of tiles, and the coefficients
+     * of a tile are contiguous and row-major.
+     *
+     * Neighbouring coefficients in both directions are then close in memory: sweeping a column touches a cache line every TileSize rows
+     * instead of every row. The leading dimension is the number of columns rounded up to a whole number of tiles, and the last row and column
+     * of tiles are padded.
+     *
+     * @tparam TileSize number of rows and columns of a tile, a power of two
+     */
+    template <int TileSize>
+    struct Tiled
+    {
+        static_assert(TileSize > 0 && std::has_single_bit(static_cast<unsigned>(TileSize)), "The tile size must be a power of two.");
+
+        static constexpr bool is_row_major = false;
+        static constexpr bool is_col_major = false;
+        static constexpr int tile_size = TileSize;
+
+        static constexpr int round_up(int n) { return (n + TileSize - 1) / TileSize * TileSize; }
+
+        static constexpr int min_leading_dimension(int, int cols) { return round_up(cols); }
+        static constexpr bool valid_leading_dimension(int, int cols, int ld) { return ld >= cols && ld % TileSize == 0; }
+        static constexpr std::size_t storage_size(int rows, int, int ld) { return static_cast<std::size_t>(round_up(rows)) * ld; }
+        static constexpr std::ptrdiff_t index(int i, int j, int ld)
+        {
+            const auto row_of_tiles = static_cast<std::ptrdiff_t>(static_cast<unsigned>(i) / TileSize) * TileSize * ld;
+            const auto tile = static_cast<std::ptrdiff_t>(static_cast<unsigned>(j) / TileSize) * TileSize * TileSize;
+            return row_of_tiles + tile + static_cast<std::ptrdiff_t>(static_cast<unsigned>(i) % TileSize) * TileSize + static_cast<unsigned>(j) % TileSize;
+        }
+    };
+}
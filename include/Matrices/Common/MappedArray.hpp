@@ -0,0 +1,292 @@
+#pragma once
+
+#include <Matrices/Common/ForwardDeclarations.hpp>
+#include <stdafx.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace LinAlg::Matrices::Common
+{
+    /**
+     * @brief Whether the values of a MappedArray opened from a file can be written. Writing into a ReadOnly mapping faults.
+     */
+    enum class MapMode
+    {
+        ReadOnly, ///< The file is mapped read-only.
+        ReadWrite ///< The file is mapped shared: the values written are written back to the file.
+    };
+
+    /**
+     * @brief Access pattern announced to the kernel with madvise, which decides how the pages of the file are read ahead and evicted.
+     */
+    enum class MapAccess
+    {
+        Normal,     ///< Default read-ahead.
+        Sequential, ///< Aggressive read-ahead, the pages already read being evicted first: the matrices streamed through once, as by the expressions.
+        Random      ///< No read-ahead: the matrices read by scattered blocks.
+    };
+
+    template <typename T>
+    void swap(MappedArray<T>& first, MappedArray<T>& second) noexcept;
+
+    /**
+     * @brief A fixed size array of T stored in a memory mapping: a file, for the matrices which do not fit in memory, or an anonymous mapping.
+     *
+     * Common::Matrix<MappedArray<T>> (ET::MappedMatrix, RG::MappedMatrix) then takes part in the expressions, the reductions and the products
+     * like an in-memory matrix: its pages are read from the file when the kernels first touch them, and evicted by the kernel under memory
+     * pressure, so a pass over a matrix larger than the memory streams it instead of loading it.
+     *
+     * A MappedArray constructed with a size, as the Matrix constructors do, is an anonymous mapping of zeros. Copying a MappedArray copies its
+     * values into an anonymous mapping: move it to transfer the mapping of a file. The errors of the system calls are thrown as std::system_error.
+     *
+     * @tparam T value type, trivially copyable
+     */
+    template <typename T>
+    class MappedArray
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be stored in a file mapping.");
+
+      public:
+        using value_type = T;
+        using iterator = T*;
+        using const_iterator = const T*;
+
+        MappedArray(std::size_t size = 0);
+        MappedArray(const MappedArray& other);
+        MappedArray(MappedArray&& other) noexcept;
+        ~MappedArray();
+
+        MappedArray& operator=(MappedArray other) noexcept;
+        friend void swap<T>(MappedArray<T>& first, MappedArray<T>& second) noexcept;
+
+        static MappedArray open(const std::filesystem::path& path, MapMode mode = MapMode::ReadOnly, MapAccess access = MapAccess::Sequential,
+                                std::size_t offset = 0, std::optional<std::size_t> size = std::nullopt);
+        static MappedArray create(const std::filesystem::path& path, std::size_t size, MapAccess access = MapAccess::Sequential, std::size_t offset = 0);
+
+        void advise(MapAccess access) const; ///< Announces a new access pattern, for instance Random before a blocked algorithm.
+        void flush() const;                  ///< Writes the modified values back to the file and waits for the write to complete.
+
+        iterator begin() { return m_data; }
+        iterator end() { return m_data + m_size; }
+        const_iterator begin() const { return m_data; }
+        const_iterator end() const { return m_data + m_size; }
+        const_iterator cbegin() const { return m_data; }
+        const_iterator cend() const { return m_data + m_size; }
+
+        T& operator[](std::size_t index) { return m_data[index]; }
+        const T& operator[](std::size_t index) const { return m_data[index]; }
+
+        T* data() { return m_data; }
+        const T* data() const { return m_data; }
+
+        std::size_t size() const { return m_size; }
+        bool is_file() const { return m_file; }                        ///< Returns whether the values are mapped from a file.
+        bool read_only() const { return m_mode == MapMode::ReadOnly; } ///< Returns whether the values cannot be written.
+
+      private:
+        MappedArray(void* mapping, std::size_t mapping_size, std::size_t offset, std::size_t size, MapMode mode, bool file);
+        static MappedArray map_file(int fd, MapMode mode, MapAccess access, std::size_t offset, std::size_t size);
+
+        void* m_mapping { nullptr }; ///< Start of the mapping, page aligned.
+        std::size_t m_mapping_size { 0 };
+        T* m_data { nullptr }; ///< First value, offset bytes after the start of the mapping.
+        std::size_t m_size { 0 };
+        MapMode m_mode { MapMode::ReadWrite };
+        bool m_file { false };
+    };
+
+    namespace _implementation_details
+    {
+        [[noreturn]] inline void throw_system_error(const std::string& what)
+        {
+            throw std::system_error(errno, std::generic_category(), what);
+        }
+
+        inline int madvise_flag(MapAccess access)
+        {
+            switch (access)
+            {
+            case MapAccess::Sequential:
+                return MADV_SEQUENTIAL;
+            case MapAccess::Random:
+                return MADV_RANDOM;
+            default:
+                return MADV_NORMAL;
+            }
+        }
+
+        /**
+         * @brief Closes a file descriptor on destruction: the mappings stay valid once their file is closed.
+         */
+        struct FileDescriptor
+        {
+            int fd;
+            ~FileDescriptor()
+            {
+                if (fd >= 0)
+                    ::close(fd);
+            }
+        };
+    }
+}
+
+/*
+    Implementation
+    -----------------------------------------------------------------------------------------
+*/
+namespace LinAlg::Matrices::Common
+{
+    template <typename T>
+    MappedArray<T>::MappedArray(void* mapping, std::size_t mapping_size, std::size_t offset, std::size_t size, MapMode mode, bool file)
+        : m_mapping(mapping)
+        , m_mapping_size(mapping_size)
+        , m_data(reinterpret_cast<T*>(static_cast<std::byte*>(mapping) + offset))
+        , m_size(size)
+        , m_mode(mode)
+        , m_file(file)
+    {
+    }
+
+    /**
+     * @brief Construct a new MappedArray of size zero values in an anonymous mapping.
+     */
+    template <typename T>
+    MappedArray<T>::MappedArray(std::size_t size)
+    {
+        if (size == 0)
+            return;
+        m_mapping_size = size * sizeof(T);
+        m_mapping = ::mmap(nullptr, m_mapping_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (m_mapping == MAP_FAILED)
+        {
+            m_mapping = nullptr;
+            throw std::bad_alloc();
+        }
+        m_data = static_cast<T*>(m_mapping);
+        m_size = size;
+    }
+
+    template <typename T>
+    MappedArray<T>::MappedArray(const MappedArray& other)
+        : MappedArray(other.m_size)
+    {
+        std::copy_n(other.m_data, m_size, m_data);
+    }
+
+    template <typename T>
+    MappedArray<T>::MappedArray(MappedArray&& other) noexcept
+    {
+        swap(*this, other);
+    }
+
+    template <typename T>
+    MappedArray<T>::~MappedArray()
+    {
+        if (m_mapping)
+            ::munmap(m_mapping, m_mapping_size);
+    }
+
+    template <typename T>
+    MappedArray<T>& MappedArray<T>::operator=(MappedArray other) noexcept
+    {
+        swap(*this, other);
+        return *this;
+    }
+
+    template <typename T>
+    void swap(MappedArray<T>& first, MappedArray<T>& second) noexcept
+    {
+        using std::swap;
+        swap(first.m_mapping, second.m_mapping);
+        swap(first.m_mapping_size, second.m_mapping_size);
+        swap(first.m_data, second.m_data);
+        swap(first.m_size, second.m_size);
+        swap(first.m_mode, second.m_mode);
+        swap(first.m_file, second.m_file);
+    }
+
+    /**
+     * @brief Maps the values stored in a file.
+     *
+     * The values start offset bytes after the beginning of the file, which must be a multiple of alignof(T), for instance after a header.
+     * By default, all the values up to the end of the file are mapped.
+     *
+     * @param path file to map
+     * @param mode ReadOnly, or ReadWrite to write the modified values back to the file
+     * @param access access pattern announced to the kernel, see advise()
+     * @param offset position in bytes of the first value in the file
+     * @param size number of values, at most the ones stored in the file
+     */
+    template <typename T>
+    MappedArray<T> MappedArray<T>::open(const std::filesystem::path& path, MapMode mode, MapAccess access, std::size_t offset, std::optional<std::size_t> size)
+    {
+        assert(offset % alignof(T) == 0 && "The values in the file are not aligned.");
+        const _implementation_details::FileDescriptor file { ::open(path.c_str(), mode == MapMode::ReadOnly ? O_RDONLY : O_RDWR) };
+        if (file.fd < 0)
+            _implementation_details::throw_system_error("Cannot open " + path.string());
+
+        struct stat status;
+        if (::fstat(file.fd, &status) != 0)
+            _implementation_details::throw_system_error("Cannot read the size of " + path.string());
+        const std::size_t file_size = static_cast<std::size_t>(status.st_size);
+        if (offset > file_size || (size && *size > (file_size - offset) / sizeof(T)))
+            throw std::system_error(std::make_error_code(std::errc::invalid_argument), path.string() + " is smaller than the mapped values");
+
+        return map_file(file.fd, mode, access, offset, size.value_or((file_size - offset) / sizeof(T)));
+    }
+
+    /**
+     * @brief Creates, or truncates, a file large enough to hold offset bytes followed by size values, and maps the values for reading
+     * and writing. The file is sparse: the values are zero and take disk space only once written.
+     */
+    template <typename T>
+    MappedArray<T> MappedArray<T>::create(const std::filesystem::path& path, std::size_t size, MapAccess access, std::size_t offset)
+    {
+        assert(offset % alignof(T) == 0 && "The values in the file are not aligned.");
+        const _implementation_details::FileDescriptor file { ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644) };
+        if (file.fd < 0)
+            _implementation_details::throw_system_error("Cannot create " + path.string());
+        if (::ftruncate(file.fd, static_cast<off_t>(offset + size * sizeof(T))) != 0)
+            _implementation_details::throw_system_error("Cannot resize " + path.string());
+
+        return map_file(file.fd, MapMode::ReadWrite, access, offset, size);
+    }
+
+    template <typename T>
+    MappedArray<T> MappedArray<T>::map_file(int fd, MapMode mode, MapAccess access, std::size_t offset, std::size_t size)
+    {
+        const std::size_t mapping_size = offset + size * sizeof(T);
+        if (mapping_size == 0)
+            return MappedArray();
+
+        const int protection = mode == MapMode::ReadOnly ? PROT_READ : PROT_READ | PROT_WRITE;
+        void* mapping = ::mmap(nullptr, mapping_size, protection, MAP_SHARED, fd, 0);
+        if (mapping == MAP_FAILED)
+            _implementation_details::throw_system_error("Cannot map the file");
+
+        MappedArray array(mapping, mapping_size, offset, size, mode, true);
+        array.advise(access);
+        return array;
+    }
+
+    /**
+     * @brief Announces the access pattern to the kernel with madvise. The hint only changes how the file is read ahead and evicted,
+     * and it is ignored for the anonymous mappings.
+     */
+    template <typename T>
+    void MappedArray<T>::advise(MapAccess access) const
+    {
+        if (m_file)
+            ::madvise(m_mapping, m_mapping_size, _implementation_details::madvise_flag(access));
+    }
+
+    template <typename T>
+    void MappedArray<T>::flush() const
+    {
+        if (m_file && m_mode == MapMode::ReadWrite && ::msync(m_mapping, m_mapping_size, MS_SYNC) != 0)
+            _implementation_details::throw_system_error("Cannot write the mapped values back to the file");
+    }
+}
@@ -1,31 +1,104 @@
 #pragma once
 
+#include <Matrices/Common/Allocator.hpp>
 #include <Matrices/Common/Base.hpp>
 #include <Matrices/Common/HelperMatrices.hpp>
+#include <Matrices/Common/Layout.hpp>
+#include <Matrices/Kernels/Assign.hpp>
 
 namespace LinAlg::Matrices::Common
 {
-    template <typename Cont>
-    void swap(Matrix<Cont>& lhs, Matrix<Cont>& rhs) noexcept;
+    /**
+     * @brief Tag of the Matrix constructor which leaves the coefficients uninitialized, for matrices which are fully overwritten next.
+     */
+    struct uninitialized_t
+    {
+        explicit uninitialized_t() = default;
+    };
+    inline constexpr uninitialized_t uninitialized {};
 
-    template <typename Cont>
-    class Matrix : public LinAlg::Matrices::Common::MatrixBase<Matrix<Cont>>
+    namespace _implementation_details
+    {
+        /**
+         * @brief Returns a container of size value initialized coefficients. The std::vector are filled on construction, the other
+         * containers after their allocation.
+         */
+        template <typename Cont>
+        Cont value_initialized_storage(std::size_t size)
+        {
+            using T = std::ranges::range_value_t<Cont>;
+            if constexpr (std::constructible_from<Cont, std::size_t, const T&>)
+                return Cont(size, T());
+            else
+            {
+                Cont data(size);
+                std::fill_n(std::ranges::data(data), size, T());
+                return data;
+            }
+        }
+
+        /**
+         * @brief The layout of the coefficients of a matrix type, Default for the types which do not declare one (expressions, helper matrices).
+         */
+        template <typename Mat, typename Default>
+        struct layout_of
+        {
+            using type = Default;
+        };
+
+        template <typename Mat, typename Default>
+            requires requires { typename Mat::Layout; }
+        struct layout_of<Mat, Default>
+        {
+            using type = typename Mat::Layout;
+        };
+
+        template <typename Mat, typename Layout>
+        concept SameLayout = std::is_same_v<typename layout_of<Mat, Layout>::type, Layout>;
+    }
+
+    template <typename Cont, typename StorageLayout>
+    void swap(Matrix<Cont, StorageLayout>& lhs, Matrix<Cont, StorageLayout>& rhs) noexcept;
+
+    /**
+     * @brief A dense matrix stored in a container Cont, in the layout StorageLayout: RowMajor (the default), ColMajor or Tiled.
+     *
+     * The layout only changes where the coefficients are stored: the matrices of all layouts take part in the same expressions and products.
+     * The kernels read the row-major and column-major matrices in place, with their strides, and the tiled ones through operator[].
+     * Converting a matrix to another layout is explicit, with the constructor from a MatrixBase.
+     *
+     * @tparam Cont container type
+     * @tparam StorageLayout layout policy, see Layout.hpp
+     */
+    template <typename Cont, typename StorageLayout>
+    class Matrix : public LinAlg::Matrices::Common::MatrixBase<Matrix<Cont, StorageLayout>>
     {
       public:
         using Scalar = typename Cont::value_type;
-        friend class LinAlg::Matrices::Common::MatrixBase<Matrix<Cont>>;
+        using Layout = StorageLayout;
+        friend class LinAlg::Matrices::Common::MatrixBase<Matrix<Cont, StorageLayout>>;
 
         Matrix(int rows = 0, int cols = 0);
+        Matrix(int rows, int cols, int leading_dimension); ///< Construct a new Matrix whose rows (columns if ColMajor) are leading_dimension coefficients apart.
+        Matrix(int rows, int cols, uninitialized_t);       ///< Construct a new Matrix whose coefficients are left uninitialized.
+        Matrix(int rows, int cols, Cont&& data);           ///< Construct a new Matrix over the coefficients stored in data, for instance a MappedArray.
         Matrix(const Matrix& other);                                       ///< Copy constructor.
         Matrix(Matrix&& other) noexcept;                                   ///< Move constructor.
         Matrix(std::initializer_list<std::initializer_list<Scalar>> list); ///< Construct a new Matrix object from embedded initializer lists.
         ~Matrix() = default;
 
         Matrix& operator=(Matrix other) noexcept; ///< Copy assignment. Uses copy and swap idiom.
-        friend void swap<Cont>(Matrix<Cont>& lhs, Matrix<Cont>& rhs) noexcept;
+        friend void swap<Cont, StorageLayout>(Matrix<Cont, StorageLayout>& lhs, Matrix<Cont, StorageLayout>& rhs) noexcept;
 
+        // Two overloads rather than a conditional explicit, which GCC drops from the inherited constructors.
         template <typename OtherDerived>
+            requires _implementation_details::SameLayout<OtherDerived, StorageLayout>
         Matrix(const MatrixBase<OtherDerived>& other) noexcept; ///< Construct a new Matrix object from a MatrixBase object.
+        template <typename OtherDerived>
+            requires(!_implementation_details::SameLayout<OtherDerived, StorageLayout>)
+        explicit Matrix(const MatrixBase<OtherDerived>& other) noexcept; ///< Construct a new Matrix object from a matrix with another layout.
+        template <typename OtherDerived>
+        Matrix(const MatrixBase<OtherDerived>& other, int leading_dimension); ///< Construct a new Matrix object with padded rows from a MatrixBase object.
         template <typename OtherDerived>
         Matrix& operator=(const MatrixBase<OtherDerived>& other) noexcept; ///< Copy assignment from a MatrixBase object. It forces expressions to be evaluated.
 
@@ -38,89 +111,174 @@ namespace LinAlg::Matrices::Common
 
         Cont& data() { return this->m_data; }
         const Cont& data() const { return this->m_data; }
+        int leading_dimension() const { return m_ld; } ///< Returns the distance between the first coefficients of two consecutive rows (columns if ColMajor) in data().
+        /// Returns whether the flattened coefficient i is not data()[i]: the rows are padded, i.e. leading_dimension() > cols(), or the layout is not row-major.
+        bool is_padded() const { return !Layout::is_row_major || m_ld != this->m_cols; }
 
         template <typename Func>
-        Matrix<Cont>& apply_inplace(Func&& f); ///< Applies the function f to all elements inplace.
-        Matrix<Cont>& zero();                  ///< Sets all elements to zero.
-        Matrix<Cont>& set(const Scalar& val);  ///< Sets all elements to val.
+        Matrix<Cont, StorageLayout>& apply_inplace(Func&& f); ///< Applies the function f to all elements inplace.
+        Matrix<Cont, StorageLayout>& zero();                  ///< Sets all elements to zero.
+        Matrix<Cont, StorageLayout>& set(const Scalar& val);  ///< Sets all elements to val.
 
-        static Matrix<Cont> Constant(int rows, int cols, const Scalar& value); ///< Returns a Matrix with given dimensions and constant coefficients.
-        static Matrix<Cont> Zero(int rows, int cols);                          ///< Returns the zero Matrix with given dimensions.
-        static Matrix<Cont> Identity(int n);                                   ///< Returns the identity Matrix of size n.
-        static Matrix<Cont> randn(int rows, int cols, Scalar mean = 0, Scalar stddev = 1, Scalar min_abs_value = 0, std::optional<int> seed = std::nullopt);
+        static Matrix<Cont, StorageLayout> Constant(int rows, int cols, const Scalar& value); ///< Returns a Matrix with given dimensions and constant coefficients.
+        static Matrix<Cont, StorageLayout> Zero(int rows, int cols);                          ///< Returns the zero Matrix with given dimensions.
+        static Matrix<Cont, StorageLayout> Identity(int n);                                   ///< Returns the identity Matrix of size n.
+        static Matrix<Cont, StorageLayout> randn(int rows, int cols, Scalar mean = 0, Scalar stddev = 1, Scalar min_abs_value = 0, std::optional<int> seed = std::nullopt);
 
       protected:
         Cont m_data {};
+        int m_ld { 0 };
     };
 
 }
 
 namespace LinAlg::Matrices::Common
 {
-    template <typename Cont>
-    Matrix<Cont>::Matrix(int rows, int cols)
-        : LinAlg::Matrices::Common::MatrixBase<Matrix<Cont>>(rows, cols)
-        , m_data(rows * cols)
+    /**
+     * @brief Construct a new Matrix with zero coefficients.
+     */
+    template <typename Cont, typename StorageLayout>
+    Matrix<Cont, StorageLayout>::Matrix(int rows, int cols)
+        : Matrix(rows, cols, Layout::min_leading_dimension(rows, cols))
+    {
+    }
+
+    /**
+     * @brief Construct a new Matrix with padded rows: the coefficient (i, j) is stored at i * leading_dimension + j in data().
+     *
+     * Padding the rows, for instance with padded_leading_dimension<Scalar>(cols), avoids the cache conflicts of the columns of matrices
+     * whose rows are a power of two bytes long. The padding coefficients are not part of the matrix: flattened accesses skip them,
+     * and the kernels read the rows with the leading dimension as stride. The coefficients and the padding are zero.
+     *
+     * With the ColMajor layout, the columns are padded instead, and (i, j) is stored at j * leading_dimension + i. With the Tiled layout,
+     * the leading dimension is the number of stored columns, a multiple of the tile size.
+     *
+     * @param rows number of rows
+     * @param cols number of columns
+     * @param leading_dimension distance between the first coefficients of two consecutive rows, at least cols
+     */
+    template <typename Cont, typename StorageLayout>
+    Matrix<Cont, StorageLayout>::Matrix(int rows, int cols, int leading_dimension)
+        : LinAlg::Matrices::Common::MatrixBase<Matrix<Cont, StorageLayout>>(rows, cols)
+        , m_data(_implementation_details::value_initialized_storage<Cont>(Layout::storage_size(rows, cols, leading_dimension)))
+        , m_ld(leading_dimension)
+    {
+        assert(Layout::valid_leading_dimension(rows, cols, leading_dimension) && "The leading dimension is too small for the layout.");
+    }
+
+    /**
+     * @brief Construct a new Matrix without initializing its coefficients, which must all be written before being read.
+     *
+     * It saves the pass writing zeros over the whole matrix, for instance for the results of the products, which the kernels overwrite.
+     * The coefficients are default initialized by the container: they are left uninitialized with the AlignedAllocator of the ET matrices
+     * and with the RG Container, but a std::vector with the default allocator still zeroes them.
+     *
+     * @param rows number of rows
+     * @param cols number of columns
+     */
+    template <typename Cont, typename StorageLayout>
+    Matrix<Cont, StorageLayout>::Matrix(int rows, int cols, uninitialized_t)
+        : LinAlg::Matrices::Common::MatrixBase<Matrix<Cont, StorageLayout>>(rows, cols)
+        , m_data(Layout::storage_size(rows, cols, Layout::min_leading_dimension(rows, cols)))
+        , m_ld(Layout::min_leading_dimension(rows, cols))
     {
     }
 
-    template <typename Cont>
-    Matrix<Cont>::Matrix(const Matrix& other)
-        : LinAlg::Matrices::Common::MatrixBase<Matrix<Cont>>(other)
+    /**
+     * @brief Construct a new Matrix whose coefficients are the ones already stored in data, in Layout and without padding. The container
+     * is moved into the matrix, hence the coefficients are neither copied nor initialized: a matrix can be built over a file with a MappedArray.
+     *
+     * @param rows number of rows
+     * @param cols number of columns
+     * @param data container of at least rows * cols coefficients
+     */
+    template <typename Cont, typename StorageLayout>
+    Matrix<Cont, StorageLayout>::Matrix(int rows, int cols, Cont&& data)
+        : LinAlg::Matrices::Common::MatrixBase<Matrix<Cont, StorageLayout>>(rows, cols)
+        , m_data(std::move(data))
+        , m_ld(Layout::min_leading_dimension(rows, cols))
+    {
+        assert(std::ranges::size(m_data) >= Layout::storage_size(rows, cols, m_ld) && "The container is too small for the matrix.");
+    }
+
+    /**
+     * @brief Construct a new Matrix object. Copies and moves take the leading dimension of the source.
+     */
+    template <typename Cont, typename StorageLayout>
+    Matrix<Cont, StorageLayout>::Matrix(const Matrix& other)
+        : LinAlg::Matrices::Common::MatrixBase<Matrix<Cont, StorageLayout>>(other)
         , m_data(other.m_data)
+        , m_ld(other.m_ld)
     {
     }
 
-    template <typename Cont>
-    Matrix<Cont>::Matrix(Matrix&& other) noexcept
+    template <typename Cont, typename StorageLayout>
+    Matrix<Cont, StorageLayout>::Matrix(Matrix&& other) noexcept
         : Matrix(0, 0)
     {
         swap(*this, other);
     }
 
-    template <typename Cont>
-    Matrix<Cont>::Matrix(std::initializer_list<std::initializer_list<Scalar>> list)
+    template <typename Cont, typename StorageLayout>
+    Matrix<Cont, StorageLayout>::Matrix(std::initializer_list<std::initializer_list<Scalar>> list)
         : Matrix(list.size(), list.begin()->size())
     {
         this->init_from_list(list);
     }
 
-    template <typename Cont>
-    Matrix<Cont>& Matrix<Cont>::operator=(Matrix other) noexcept
+    template <typename Cont, typename StorageLayout>
+    Matrix<Cont, StorageLayout>& Matrix<Cont, StorageLayout>::operator=(Matrix other) noexcept
     {
         swap(*this, other);
         return *this;
     }
 
-    template <typename Cont>
-    void swap(Matrix<Cont>& lhs, Matrix<Cont>& rhs) noexcept
+    template <typename Cont, typename StorageLayout>
+    void swap(Matrix<Cont, StorageLayout>& lhs, Matrix<Cont, StorageLayout>& rhs) noexcept
     {
         using std::swap;
-        swap(static_cast<MatrixBase<Matrix<Cont>>&>(lhs), static_cast<MatrixBase<Matrix<Cont>>&>(rhs));
+        swap(static_cast<MatrixBase<Matrix<Cont, StorageLayout>>&>(lhs), static_cast<MatrixBase<Matrix<Cont, StorageLayout>>&>(rhs));
         swap(lhs.m_data, rhs.m_data);
+        swap(lhs.m_ld, rhs.m_ld);
+    }
+
+    template <typename Cont, typename StorageLayout>
+    template <typename OtherDerived>
+        requires _implementation_details::SameLayout<OtherDerived, StorageLayout>
+    Matrix<Cont, StorageLayout>::Matrix(const MatrixBase<OtherDerived>& other) noexcept
+        : Matrix(other.rows(), other.cols(), uninitialized)
+    {
+        LinAlg::Matrices::Kernels::assign<Layout>(m_data, static_cast<const OtherDerived&>(other), this->m_rows, this->m_cols, m_ld);
+    }
+
+    template <typename Cont, typename StorageLayout>
+    template <typename OtherDerived>
+        requires(!_implementation_details::SameLayout<OtherDerived, StorageLayout>)
+    Matrix<Cont, StorageLayout>::Matrix(const MatrixBase<OtherDerived>& other) noexcept
+        : Matrix(other.rows(), other.cols(), uninitialized)
+    {
+        LinAlg::Matrices::Kernels::assign<Layout>(m_data, static_cast<const OtherDerived&>(other), this->m_rows, this->m_cols, m_ld);
     }
 
-    template <typename Cont>
+    template <typename Cont, typename StorageLayout>
     template <typename OtherDerived>
-    Matrix<Cont>::Matrix(const MatrixBase<OtherDerived>& other) noexcept
-        : Matrix(other.rows(), other.cols())
+    Matrix<Cont, StorageLayout>::Matrix(const MatrixBase<OtherDerived>& other, int leading_dimension)
+        : Matrix(other.rows(), other.cols(), leading_dimension)
     {
-        for (int i = 0; i < (this->m_rows * this->m_cols); ++i)
-            m_data[i] = other[i];
+        LinAlg::Matrices::Kernels::assign<Layout>(m_data, static_cast<const OtherDerived&>(other), this->m_rows, this->m_cols, m_ld);
     }
 
-    template <typename Cont>
+    template <typename Cont, typename StorageLayout>
     template <typename OtherDerived>
-    Matrix<Cont>& Matrix<Cont>::operator=(const MatrixBase<OtherDerived>& other) noexcept
+    Matrix<Cont, StorageLayout>& Matrix<Cont, StorageLayout>::operator=(const MatrixBase<OtherDerived>& other) noexcept
     {
-        for (int i = 0; i < (this->m_rows * this->m_cols); ++i)
-            m_data[i] = other[i];
+        LinAlg::Matrices::Kernels::assign<Layout>(m_data, static_cast<const OtherDerived&>(other), this->m_rows, this->m_cols, m_ld);
 
         return *this;
     }
 
-    template <typename Cont>
-    void Matrix<Cont>::init_from_list(std::initializer_list<std::initializer_list<Scalar>> list)
+    template <typename Cont, typename StorageLayout>
+    void Matrix<Cont, StorageLayout>::init_from_list(std::initializer_list<std::initializer_list<Scalar>> list)
     {
         int i = 0;
         for (const auto& row : list)
@@ -135,65 +293,66 @@ namespace LinAlg::Matrices::Common
         }
     }
 
-    template <typename Cont>
-    typename Matrix<Cont>::Scalar& Matrix<Cont>::operator[](int i, int j)
+    template <typename Cont, typename StorageLayout>
+    typename Matrix<Cont, StorageLayout>::Scalar& Matrix<Cont, StorageLayout>::operator[](int i, int j)
     {
-        return m_data[i * this->m_cols + j];
+        return m_data[Layout::index(i, j, m_ld)];
     }
 
-    template <typename Cont>
-    typename Matrix<Cont>::Scalar Matrix<Cont>::operator[](int i, int j) const
+    template <typename Cont, typename StorageLayout>
+    typename Matrix<Cont, StorageLayout>::Scalar Matrix<Cont, StorageLayout>::operator[](int i, int j) const
     {
-        return m_data[i * this->m_cols + j];
+        return m_data[Layout::index(i, j, m_ld)];
     }
 
-    template <typename Cont>
-    typename Matrix<Cont>::Scalar& Matrix<Cont>::operator[](int i)
+    // The flattened index is row-major and skips the padding of the rows. The evaluation loops of the kernels avoid the test with Kernels::unpadded_coeff().
+    template <typename Cont, typename StorageLayout>
+    typename Matrix<Cont, StorageLayout>::Scalar& Matrix<Cont, StorageLayout>::operator[](int i)
     {
-        return m_data[i];
+        return m_data[is_padded() ? Layout::index(i / this->m_cols, i % this->m_cols, m_ld) : i];
     }
 
-    template <typename Cont>
-    typename Matrix<Cont>::Scalar Matrix<Cont>::operator[](int i) const
+    template <typename Cont, typename StorageLayout>
+    typename Matrix<Cont, StorageLayout>::Scalar Matrix<Cont, StorageLayout>::operator[](int i) const
     {
-        return m_data[i];
+        return m_data[is_padded() ? Layout::index(i / this->m_cols, i % this->m_cols, m_ld) : i];
     }
 
-    template <typename Cont>
+    template <typename Cont, typename StorageLayout>
     template <typename Func>
-    Matrix<Cont>& Matrix<Cont>::apply_inplace(Func&& f)
+    Matrix<Cont, StorageLayout>& Matrix<Cont, StorageLayout>::apply_inplace(Func&& f)
     {
         std::function apply_f = [&f](Scalar& i) { i = f(i); };
         std::for_each(this->m_data.begin(), this->m_data.end(), apply_f);
         return *this;
     }
 
-    template <typename Cont>
-    Matrix<Cont>& Matrix<Cont>::zero()
+    template <typename Cont, typename StorageLayout>
+    Matrix<Cont, StorageLayout>& Matrix<Cont, StorageLayout>::zero()
     {
         return apply_inplace([](Scalar&) -> Scalar { return 0; });
     }
 
-    template <typename Cont>
-    Matrix<Cont>& Matrix<Cont>::set(const Scalar& val)
+    template <typename Cont, typename StorageLayout>
+    Matrix<Cont, StorageLayout>& Matrix<Cont, StorageLayout>::set(const Scalar& val)
     {
         return apply_inplace([&val](Scalar&) -> Scalar { return val; });
     }
 
-    template <typename Cont>
-    Matrix<Cont> Matrix<Cont>::Constant(int rows, int cols, const Scalar& value)
+    template <typename Cont, typename StorageLayout>
+    Matrix<Cont, StorageLayout> Matrix<Cont, StorageLayout>::Constant(int rows, int cols, const Scalar& value)
     {
         return LinAlg::Matrices::Common::Constant<Scalar>(rows, cols, value);
     }
 
-    template <typename Cont>
-    Matrix<Cont> Matrix<Cont>::Zero(int rows, int cols)
+    template <typename Cont, typename StorageLayout>
+    Matrix<Cont, StorageLayout> Matrix<Cont, StorageLayout>::Zero(int rows, int cols)
     {
         return LinAlg::Matrices::Common::Zero<Scalar>(rows, cols);
     }
 
-    template <typename Cont>
-    Matrix<Cont> Matrix<Cont>::Identity(int n)
+    template <typename Cont, typename StorageLayout>
+    Matrix<Cont, StorageLayout> Matrix<Cont, StorageLayout>::Identity(int n)
     {
         return LinAlg::Matrices::Common::Identity<Scalar>(n);
     }
@@ -213,12 +372,12 @@ namespace LinAlg::Matrices::Common
      * @param seed random seed
      * @return Matrix<T>
      */
-    template <typename Cont>
-    Matrix<Cont> Matrix<Cont>::randn(int rows, int cols, Scalar mean, Scalar stddev, Scalar min_abs_value, std::optional<int> seed)
+    template <typename Cont, typename StorageLayout>
+    Matrix<Cont, StorageLayout> Matrix<Cont, StorageLayout>::randn(int rows, int cols, Scalar mean, Scalar stddev, Scalar min_abs_value, std::optional<int> seed)
     {
         std::mt19937 gen(seed.value_or(std::random_device()()));
         std::normal_distribution<double> dist(mean, stddev);
-        Matrix<Cont> result(rows, cols);
+        Matrix<Cont, StorageLayout> result(rows, cols, uninitialized);
         for (int i = 0; i < rows; ++i)
             for (int j = 0; j < cols; ++j)
             {
@@ -1,47 +1,721 @@
 #pragma once
 
+#include <Matrices/Common/Allocator.hpp>
 #include <Matrices/Common/HelperFunctions.hpp>
+#include <Matrices/Common/SparseMatrix.hpp>
+#include <Matrices/Kernels/Batched.hpp>
+#include <Matrices/Kernels/Gemm.hpp>
+#include <Matrices/Kernels/Sparse.hpp>
+#include <Matrices/Kernels/Syrk.hpp>
 #include <stdafx.hpp>
 
+namespace LinAlg::Matrices::Common::Concepts
+{
+    /// A product of two Constant matrices, which is itself a Constant matrix.
+    template <typename LHS, typename RHS>
+    concept ConstantProduct = structure_of<std::remove_cvref_t<LHS>> == MatrixStructure::Constant && structure_of<std::remove_cvref_t<RHS>> == MatrixStructure::Constant;
+
+    /// A dense product with at least one operand of known structure (see MatrixStructure), computed by structured_mult_into.
+    template <typename LHS, typename RHS>
+    concept StructuredProduct = (structure_of<std::remove_cvref_t<LHS>> != MatrixStructure::General || structure_of<std::remove_cvref_t<RHS>> != MatrixStructure::General)
+        && !ConstantProduct<LHS, RHS> && !SparseMatrixType<LHS> && !SparseMatrixType<RHS>;
+
+    /// A matrix, or expression, whose dimensions are known at compile time.
+    template <typename Mat>
+    concept FixedSizeMatrix = rows_at_compile_time<std::remove_cvref_t<Mat>> != Dynamic && cols_at_compile_time<std::remove_cvref_t<Mat>> != Dynamic;
+
+    /// A product of two matrices whose dimensions are known at compile time, computed without allocation by the fixed size kernel.
+    template <typename LHS, typename RHS>
+    concept FixedSizeProduct = FixedSizeMatrix<LHS> && FixedSizeMatrix<RHS>;
+}
+
 namespace LinAlg::Matrices::Common
 {
     /**
-     * @brief A function to multiply multiple matrices.
+     * @brief Optimal parenthesization of a chain of N matrices.
      *
-     * The pre_eval_expr template parameter is used to force the evaluation of the template expressions before the multiplication.
-     * This is useful since matrix multiplication need to access the elements of the matrices multiple times.
+     * cost[i][j] is the minimal number of multiply-adds needed to compute the product of matrices i..j,
+     * split[i][j] = k means that this product is computed as (i..k) * (k+1..j).
      *
-     * The variadic template Args is used to accept any number of matrices.
+     * @tparam N number of matrices in the chain
+     */
+    template <std::size_t N>
+    struct ChainOrder
+    {
+        std::array<std::array<long long, N>, N> cost {};
+        std::array<std::array<int, N>, N> split {};
+    };
+
+    /**
+     * @brief Solves the matrix chain ordering problem by dynamic programming.
      *
+     * Matrix i has dimensions dims[i] x dims[i + 1]. It is constexpr, so the order can be computed at compile time when the shapes are known.
+     *
+     * @tparam N number of matrices in the chain
+     * @param dims the N + 1 dimensions of the chain
+     * @return ChainOrder<N> the optimal costs and splits
+     */
+    template <std::size_t N>
+    constexpr ChainOrder<N> chain_order(const std::array<int, N + 1>& dims)
+    {
+        ChainOrder<N> order;
+        for (std::size_t length = 1; length < N; ++length)
+            for (std::size_t i = 0; i + length < N; ++i)
+            {
+                const std::size_t j = i + length;
+                order.cost[i][j] = std::numeric_limits<long long>::max();
+                for (std::size_t k = i; k < j; ++k)
+                {
+                    const long long cost = order.cost[i][k] + order.cost[k + 1][j] + static_cast<long long>(dims[i]) * dims[k + 1] * dims[j + 1];
+                    if (cost < order.cost[i][j])
+                    {
+                        order.cost[i][j] = cost;
+                        order.split[i][j] = static_cast<int>(k);
+                    }
+                }
+            }
+        return order;
+    }
+
+    /**
+     * @brief Multiplies multiple matrices, accumulating the products in the scalar type Acc (mixed precision).
+     *
+     * The result keeps the common scalar type of the matrices. For instance, mat_mult<double>(A, B) on float matrices reads and writes floats,
+     * hence moves half the memory of the double product, but accumulates the dot products in double: the error is then dominated by the final
+     * rounding to float instead of growing with the inner dimension. Integer products are always accumulated in a widened type (see widening_mult).
+     * If Acc is void, the products are accumulated in the common scalar type, as with mat_mult<pre_eval_expr>.
+     *
+     * @tparam Acc accumulation type
      * @tparam pre_eval_expr if true, the expressions are evaluated before the multiplication
      * @tparam Args matrices types
      * @param args matrices
      * @return Matrix<T> with T being the common scalar type of the matrices
      */
-    template <bool pre_eval_expr = false, typename... Args>
-    auto mat_mult(Args&&... args)
+    template <typename Acc, bool pre_eval_expr = false, typename... Args>
+    constexpr auto mat_mult(Args&&... args)
     {
         if constexpr (pre_eval_expr)
         {
-            std::tuple<decltype(std::forward<Args>(args).eval())...> matrices(std::forward<Args>(args).eval()...);
-            return mat_mult_impl(matrices);
+            auto matrices = _implementation_details::as_temporary(
+                [&] { return std::tuple<decltype(std::forward<Args>(args).eval())...>(std::forward<Args>(args).eval()...); });
+            return mat_mult_impl<Acc>(matrices);
         }
         else
         {
             std::tuple<Args...> matrices(std::forward<Args>(args)...);
-            return mat_mult_impl(matrices);
+            return mat_mult_impl<Acc>(matrices);
         }
     }
 
-    template <typename Tuple>
-    auto mat_mult_impl(const Tuple& matrices)
+    /**
+     * @brief A function to multiply multiple matrices.
+     *
+     * The pre_eval_expr template parameter is used to force the evaluation of the template expressions before the multiplication.
+     * This is useful when the product accesses the elements of the matrices multiple times. It is not needed by the GEMM kernel,
+     * which evaluates each coefficient of an expression once while packing it.
+     *
+     * The variadic template Args is used to accept any number of matrices. Chains of three or more matrices are evaluated in the order
+     * minimizing the number of operations, given by chain_order(). Products of fixed size matrices (see the backends) are constexpr,
+     * and the inner dimensions of the chain known at compile time are checked at compile time.
+     *
+     * @tparam pre_eval_expr if true, the expressions are evaluated before the multiplication
+     * @tparam Args matrices types
+     * @param args matrices
+     * @return Matrix<T> with T being the common scalar type of the matrices
+     */
+    template <bool pre_eval_expr = false, typename... Args>
+    constexpr auto mat_mult(Args&&... args)
+    {
+        return mat_mult<void, pre_eval_expr>(std::forward<Args>(args)...);
+    }
+
+    namespace _implementation_details
+    {
+        template <typename Acc, int I, int J, typename Tuple, typename Order>
+        constexpr auto chain_product(const Tuple& matrices, const Order& order);
+
+        /**
+         * @brief Returns matrix I if I == J, else the product of matrices I..J.
+         */
+        template <typename Acc, int I, int J, typename Tuple, typename Order>
+        constexpr decltype(auto) chain_operand(const Tuple& matrices, const Order& order)
+        {
+            if constexpr (I == J)
+                return std::get<I>(matrices);
+            else
+                return chain_product<Acc, I, J>(matrices, order);
+        }
+
+        /**
+         * @brief Computes the product of matrices I..J, splitting the chain where given by order.
+         *
+         * The split is only known at runtime, hence all the possible splits are instantiated and the one in order is selected.
+         */
+        template <typename Acc, int I, int J, typename Tuple, typename Order>
+        constexpr auto chain_product(const Tuple& matrices, const Order& order)
+        {
+            using Result = decltype(two_matrix_mult<Acc>(chain_operand<Acc, I, I>(matrices, order), chain_operand<Acc, I + 1, J>(matrices, order)));
+
+            // The products of the sub-chains are temporaries, drawn from the active arena if any, but not the product of the whole chain.
+            std::optional<Result> result;
+            [&]<int... K>(std::integer_sequence<int, K...>)
+            {
+                ((order.split[I][J] == I + K
+                  && (result.emplace(two_matrix_mult<Acc>(as_temporary([&]() -> decltype(auto) { return chain_operand<Acc, I, I + K>(matrices, order); }),
+                                                          as_temporary([&]() -> decltype(auto) { return chain_operand<Acc, I + K + 1, J>(matrices, order); }))),
+                      true))
+                 || ...);
+            }(std::make_integer_sequence<int, J - I> {});
+
+            return std::move(*result);
+        }
+
+        template <typename Tuple>
+        auto chain_dims(const Tuple& matrices)
+        {
+            constexpr std::size_t N_matrices = std::tuple_size_v<Tuple>;
+            std::array<int, N_matrices + 1> dims;
+            [&]<std::size_t... I>(std::index_sequence<I...>)
+            {
+                ((dims[I] = std::get<I>(matrices).rows()), ...);
+            }(std::make_index_sequence<N_matrices> {});
+            dims[N_matrices] = std::get<N_matrices - 1>(matrices).cols();
+            return dims;
+        }
+
+        /**
+         * @brief Returns true if the number of columns of each matrix of the chain is the number of rows of the next one.
+         */
+        template <typename Tuple>
+        constexpr bool chain_dimensions_match(const Tuple& matrices)
+        {
+            return [&]<std::size_t... I>(std::index_sequence<I...>)
+            {
+                return ((std::get<I>(matrices).cols() == std::get<I + 1>(matrices).rows()) && ...);
+            }(std::make_index_sequence<std::tuple_size_v<Tuple> - 1> {});
+        }
+    }
+
+    namespace _implementation_details
+    {
+        /**
+         * @brief The helper matrix class template Mat, instantiated with the scalar type T.
+         */
+        template <typename Mat, typename T>
+        struct rebind_scalar;
+
+        template <template <typename> class Mat, typename U, typename T>
+        struct rebind_scalar<Mat<U>, T>
+        {
+            using type = Mat<T>;
+        };
+
+        template <typename Tuple, typename = std::make_index_sequence<std::tuple_size_v<Tuple>>>
+        struct chain_traits;
+
+        template <typename Tuple, std::size_t... I>
+        struct chain_traits<Tuple, std::index_sequence<I...>>
+        {
+            using Scalar = LinAlg::CommonScalar<std::tuple_element_t<I, Tuple>...>;
+            static constexpr std::array<MatrixStructure, sizeof...(I)> structures { structure_of<std::remove_cvref_t<std::tuple_element_t<I, Tuple>>>... };
+            static constexpr std::array<int, sizeof...(I)> rows { rows_at_compile_time<std::remove_cvref_t<std::tuple_element_t<I, Tuple>>>... };
+            static constexpr std::array<int, sizeof...(I)> cols { cols_at_compile_time<std::remove_cvref_t<std::tuple_element_t<I, Tuple>>>... };
+            /// True if the dimensions of all the matrices are known at compile time.
+            static constexpr bool fixed_size = (Concepts::FixedSizeMatrix<std::tuple_element_t<I, Tuple>> && ...);
+
+            /// Returns the index of the first matrix of the chain with structure s, or -1.
+            static constexpr int find(MatrixStructure s)
+            {
+                for (std::size_t i = 0; i < structures.size(); ++i)
+                    if (structures[i] == s)
+                        return static_cast<int>(i);
+                return -1;
+            }
+
+            /// Returns false if the inner dimensions of two consecutive matrices are known at compile time and differ.
+            static constexpr bool dimensions_match()
+            {
+                for (std::size_t i = 0; i + 1 < sizeof...(I); ++i)
+                    if (!Common::dimensions_match(cols[i], rows[i + 1]))
+                        return false;
+                return true;
+            }
+
+            /// Returns the dimensions of the chain, as given to chain_order, if they are known at compile time.
+            static constexpr std::array<int, sizeof...(I) + 1> fixed_dims()
+            {
+                std::array<int, sizeof...(I) + 1> dims {};
+                std::copy(rows.begin(), rows.end(), dims.begin());
+                dims.back() = cols.back();
+                return dims;
+            }
+
+            /// Returns the indices of the matrices which are not identities, followed by -1.
+            static constexpr std::array<int, sizeof...(I)> non_identities()
+            {
+                std::array<int, sizeof...(I)> indices {};
+                indices.fill(-1);
+                int n = 0;
+                for (std::size_t i = 0; i < structures.size(); ++i)
+                    if (structures[i] != MatrixStructure::Identity)
+                        indices[n++] = static_cast<int>(i);
+                return indices;
+            }
+        };
+    }
+
+    /**
+     * @brief Multiplies a chain of matrices stored in a tuple.
+     *
+     * The structure of the helper matrices is used at compile time: a chain with a Zero matrix returns a lazy Zero matrix of the product shape
+     * without computing anything, and Identity matrices are removed from the chain (the product of identities only is a lazy Identity).
+     * Products with a Constant matrix are computed as broadcasts by the backends (see structured_mult_into), and the product of two Constant
+     * matrices is a lazy Constant matrix.
+     * The order of a chain of fixed size matrices is computed at compile time.
+     */
+    template <typename Acc = void, typename Tuple>
+    constexpr auto mat_mult_impl(const Tuple& matrices)
     {
         constexpr int N_matrices = std::tuple_size_v<Tuple>;
         static_assert(N_matrices >= 2, "At least two matrices are needed for multiplication.");
 
-        if constexpr (N_matrices == 2)
-            return two_matrix_mult(std::get<0>(matrices), std::get<1>(matrices));
+        using Chain = _implementation_details::chain_traits<Tuple>;
+        static_assert(Chain::dimensions_match(), "Matrix dimensions do not match for multiplication.");
+        // Checked on the whole chain, since the helper matrices short-circuit the products which check them.
+        assert(_implementation_details::chain_dimensions_match(matrices) && "Matrix dimensions do not match for multiplication.");
+        using T = typename Chain::Scalar;
+        constexpr int first_zero = Chain::find(MatrixStructure::Zero);
+        constexpr std::array<int, N_matrices> kept = Chain::non_identities();
+        constexpr int N_kept = static_cast<int>(std::ranges::count_if(kept, [](int i) { return i >= 0; }));
+
+        if constexpr (first_zero >= 0)
+        {
+            using Zero = typename _implementation_details::rebind_scalar<std::remove_cvref_t<std::tuple_element_t<first_zero, Tuple>>, T>::type;
+            return Zero(std::get<0>(matrices).rows(), std::get<N_matrices - 1>(matrices).cols());
+        }
+        else if constexpr (N_kept == 0)
+        {
+            using Identity = typename _implementation_details::rebind_scalar<std::remove_cvref_t<std::tuple_element_t<0, Tuple>>, T>::type;
+            return Identity(std::get<0>(matrices).rows());
+        }
+        else if constexpr (N_kept == 1)
+        {
+            // The remaining matrix times an adjacent identity, which the backends compute as a copy.
+            constexpr int i = kept[0];
+            if constexpr (i > 0)
+                return two_matrix_mult<Acc>(std::get<i - 1>(matrices), std::get<i>(matrices));
+            else
+                return two_matrix_mult<Acc>(std::get<0>(matrices), std::get<1>(matrices));
+        }
+        else if constexpr (N_kept < N_matrices)
+            return [&]<std::size_t... I>(std::index_sequence<I...>) { return mat_mult_impl<Acc>(std::forward_as_tuple(std::get<kept[I]>(matrices)...)); }(
+                       std::make_index_sequence<N_kept> {});
+        else if constexpr (N_matrices == 2)
+            return two_matrix_mult<Acc>(std::get<0>(matrices), std::get<1>(matrices));
+        else if constexpr (Chain::fixed_size)
+        {
+            constexpr auto order = chain_order<N_matrices>(Chain::fixed_dims());
+            return _implementation_details::chain_product<Acc, 0, N_matrices - 1>(matrices, order);
+        }
+        else
+        {
+            const auto order = chain_order<N_matrices>(_implementation_details::chain_dims(matrices));
+            return _implementation_details::chain_product<Acc, 0, N_matrices - 1>(matrices, order);
+        }
+    }
+
+    /**
+     * @brief Computes C = alpha * op(A) * op(B) + beta * C into an existing matrix, where op is either the identity or the transpose.
+     *
+     * Contrary to mat_mult, it does not allocate the result, and the GEMM kernel reuses its packing buffers, hence repeated calls do not allocate.
+     * A and B can be matrices or expressions. If beta is zero, the initial values of C are ignored. C must not overlap with A or B.
+     *
+     * @tparam CMat result matrix type, stored contiguously
+     * @tparam LHS left matrix type
+     * @tparam RHS right matrix type
+     * @param C result matrix, with the shape of op(A) * op(B)
+     * @param A left matrix
+     * @param B right matrix
+     * @param alpha scaling of the product
+     * @param beta scaling of C
+     * @param transpose_A if true, op(A) is the transpose of A
+     * @param transpose_B if true, op(B) is the transpose of B
+     */
+    template <Kernels::Concepts::ContiguousMatrix CMat, typename LHS, typename RHS>
+    void gemm_into(CMat& C, const LHS& A, const RHS& B, typename CMat::Scalar alpha = 1, typename CMat::Scalar beta = 0, bool transpose_A = false,
+                   bool transpose_B = false)
+    {
+        const int m = transpose_A ? A.cols() : A.rows();
+        const int k = transpose_A ? A.rows() : A.cols();
+        const int n = transpose_B ? B.rows() : B.cols();
+        assert(k == (transpose_B ? B.cols() : B.rows()) && "Matrix dimensions do not match for multiplication.");
+        assert(C.rows() == m && C.cols() == n && "The result matrix does not have the shape of the product.");
+
+        const auto run = [&](const auto& op_A, const auto& op_B) { Kernels::gemm(m, n, k, op_A, op_B, Kernels::data_ptr(C), Kernels::leading_dimension(C), alpha, beta); };
+        const auto op_A = Kernels::make_operand(A);
+        const auto op_B = Kernels::make_operand(B);
+        if (transpose_A && transpose_B)
+            run(Kernels::transpose(op_A), Kernels::transpose(op_B));
+        else if (transpose_A)
+            run(Kernels::transpose(op_A), op_B);
+        else if (transpose_B)
+            run(op_A, Kernels::transpose(op_B));
+        else
+            run(op_A, op_B);
+    }
+
+    /**
+     * @brief Computes the symmetric product C = alpha * A * A^T + beta * C, or alpha * A^T * A + beta * C, into an existing matrix.
+     *
+     * Only the triangle uplo of the product is computed, which needs half the operations of gemm_into(C, A, A, alpha, beta, false, true),
+     * and the transpose of A is never stored. If mirror is true the triangle is then copied into the other one, otherwise the other triangle
+     * of C is left untouched. A can be a matrix or an expression. If beta is zero, the initial values of C are ignored. C must not overlap with A.
+     *
+     * @tparam CMat result matrix type, stored contiguously
+     * @tparam Mat matrix type
+     * @param C square result matrix, with as many rows as A, or as many columns as A if transpose_A is true
+     * @param A matrix
+     * @param alpha scaling of the product
+     * @param beta scaling of C
+     * @param transpose_A if true, computes A^T * A instead of A * A^T
+     * @param uplo triangle of C to compute
+     * @param mirror if true, the computed triangle is copied into the other one
+     */
+    template <Kernels::Concepts::ContiguousMatrix CMat, typename Mat>
+    void syrk_into(CMat& C, const Mat& A, typename CMat::Scalar alpha = 1, typename CMat::Scalar beta = 0, bool transpose_A = false,
+                   Kernels::Triangle uplo = Kernels::Triangle::Lower, bool mirror = true)
+    {
+        const int n = transpose_A ? A.cols() : A.rows();
+        const int k = transpose_A ? A.rows() : A.cols();
+        assert(C.rows() == n && C.cols() == n && "The result matrix does not have the shape of the symmetric product.");
+
+        const auto op_A = Kernels::make_operand(A);
+        const int ldc = Kernels::leading_dimension(C);
+        if (transpose_A)
+            Kernels::syrk(n, k, Kernels::transpose(op_A), Kernels::data_ptr(C), ldc, uplo, alpha, beta);
+        else
+            Kernels::syrk(n, k, op_A, Kernels::data_ptr(C), ldc, uplo, alpha, beta);
+        if (mirror)
+            Kernels::mirror_triangle(n, Kernels::data_ptr(C), ldc, uplo);
+    }
+
+    /**
+     * @brief Computes the product of two dense matrices (or expressions), one of which at least has a known structure, into the row-major array res.
+     *
+     * The structure is known at compile time, hence no general product is ever computed:
+     * - a product with a Zero matrix is zero;
+     * - a product with an Identity matrix is a copy of the other operand;
+     * - a Constant matrix c times B is the broadcast of the column sums of B scaled by c, and A times a Constant matrix c the broadcast
+     *   of the row sums of A scaled by c, which needs O(n^2) operations instead of O(n^3). The sums are accumulated in Acc if it is not void.
+     * The backends call it from their two_matrix_mult.
+     *
+     * @tparam Acc accumulation type, or void for T
+     * @tparam T scalar type of the result
+     * @tparam LHS left matrix type
+     * @tparam RHS right matrix type
+     * @param lhs left matrix
+     * @param rhs right matrix
+     * @param res pointer to the lhs.rows() x rhs.cols() result. It must not overlap with the operands.
+     */
+    template <typename Acc = void, typename T, typename LHS, typename RHS>
+        requires Concepts::StructuredProduct<LHS, RHS>
+    void structured_mult_into(const LHS& lhs, const RHS& rhs, T* res)
+    {
+        assert(lhs.cols() == rhs.rows() && "Matrix dimensions do not match for multiplication.");
+
+        using U = std::conditional_t<std::is_void_v<Acc>, T, Acc>;
+        constexpr MatrixStructure left = structure_of<std::remove_cvref_t<LHS>>;
+        constexpr MatrixStructure right = structure_of<std::remove_cvref_t<RHS>>;
+        const int m = lhs.rows();
+        const int n = rhs.cols();
+        const int k = lhs.cols();
+        const auto at = [&](int i, int j) -> T& { return res[static_cast<std::ptrdiff_t>(i) * n + j]; };
+        const auto A = Kernels::make_operand(lhs);
+        const auto B = Kernels::make_operand(rhs);
+
+        if constexpr (left == MatrixStructure::Zero || right == MatrixStructure::Zero)
+            std::fill_n(res, static_cast<std::size_t>(m) * n, T(0));
+        else if constexpr (left == MatrixStructure::Identity)
+        {
+            for (int i = 0; i < m; ++i)
+                for (int j = 0; j < n; ++j)
+                    at(i, j) = static_cast<T>(B(i, j));
+        }
+        else if constexpr (right == MatrixStructure::Identity)
+        {
+            for (int i = 0; i < m; ++i)
+                for (int j = 0; j < n; ++j)
+                    at(i, j) = static_cast<T>(A(i, j));
+        }
+        else if constexpr (left == MatrixStructure::Constant)
+        {
+            std::vector<U> col_sums(n, U(0));
+            for (int p = 0; p < k; ++p)
+                for (int j = 0; j < n; ++j)
+                    col_sums[j] += static_cast<U>(B(p, j));
+            const U value = k > 0 && m > 0 ? static_cast<U>(lhs[0, 0]) : U(0);
+            for (int i = 0; i < m; ++i)
+                for (int j = 0; j < n; ++j)
+                    at(i, j) = static_cast<T>(value * col_sums[j]);
+        }
+        else
+        {
+            const U value = k > 0 && n > 0 ? static_cast<U>(rhs[0, 0]) : U(0);
+            for (int i = 0; i < m; ++i)
+            {
+                U row_sum = U(0);
+                for (int p = 0; p < k; ++p)
+                    row_sum += static_cast<U>(A(i, p));
+                std::fill_n(&at(i, 0), n, static_cast<T>(value * row_sum));
+            }
+        }
+    }
+
+    /**
+     * @brief Multiplies two Constant matrices: the result is the lazy Constant matrix whose value is the inner dimension times the product
+     * of the values, computed in O(1).
+     *
+     * @tparam Acc ignored
+     * @tparam LHS left matrix type
+     * @tparam RHS right matrix type
+     * @param lhs left matrix
+     * @param rhs right matrix
+     * @return Constant<T> of the same kind as lhs, with T being the common scalar type of the matrices
+     */
+    template <typename Acc = void, typename LHS, typename RHS>
+        requires Concepts::ConstantProduct<LHS, RHS>
+    auto two_matrix_mult(LHS&& lhs, RHS&& rhs)
+    {
+        assert(lhs.cols() == rhs.rows() && "Matrix dimensions do not match for multiplication.");
+
+        using T = LinAlg::CommonScalar<std::remove_cvref_t<LHS>, std::remove_cvref_t<RHS>>;
+        using Constant = typename _implementation_details::rebind_scalar<std::remove_cvref_t<LHS>, T>::type;
+        const int k = lhs.cols();
+        const T value = k > 0 && lhs.rows() > 0 && rhs.cols() > 0 ? static_cast<T>(k * (static_cast<T>(lhs[0, 0]) * static_cast<T>(rhs[0, 0]))) : T(0);
+        return Constant(lhs.rows(), rhs.cols(), value);
+    }
+
+    namespace _implementation_details
+    {
+        /**
+         * @brief Calls f with a strided operand of a dense matrix of scalar type T. Row-major and column-major matrices and strided views with this type are read in place,
+         * others (expressions, helper and tiled matrices, other scalar types) are evaluated into a temporary first, since the sparse kernels read each
+         * coefficient of the dense operand several times.
+         */
+        template <typename T, typename Mat, typename F>
+        void with_dense_operand(const Mat& mat, const F& f)
+        {
+            if constexpr (Kernels::Concepts::ContiguousMatrixOf<Mat, T>
+                          || ((Kernels::Concepts::ColMajorMatrix<Mat> || Kernels::Concepts::StridedMatrix<Mat>) && std::same_as<typename std::remove_cvref_t<Mat>::Scalar, T>))
+                f(Kernels::make_operand(mat));
+            else
+            {
+                auto evaluated = as_temporary([&] { return std::vector<T, AlignedAllocator<T>>(static_cast<std::size_t>(mat.rows()) * mat.cols()); });
+                for (int i = 0; i < mat.rows(); ++i)
+                    for (int j = 0; j < mat.cols(); ++j)
+                        evaluated[static_cast<std::size_t>(i) * mat.cols() + j] = static_cast<T>(mat[i, j]);
+                f(Kernels::StridedOperand<T> { evaluated.data(), mat.cols(), 1 });
+            }
+        }
+    }
+
+    /**
+     * @brief Computes the product of a sparse matrix with a dense matrix (or expression), in either order, into the row-major array res.
+     *
+     * The kernel is selected on the format of the sparse operand: see Kernels::csr_times_dense, csc_times_dense, dense_times_csr and dense_times_csc.
+     * The backends call it from their two_matrix_mult, hence such products go through mat_mult like dense ones.
+     *
+     * @tparam T scalar type of the result
+     * @tparam LHS left matrix type
+     * @tparam RHS right matrix type
+     * @param lhs left matrix
+     * @param rhs right matrix
+     * @param res pointer to the lhs.rows() x rhs.cols() result. It must not overlap with the operands.
+     */
+    template <typename T, typename LHS, typename RHS>
+        requires Concepts::SparseDenseProduct<LHS, RHS>
+    void sparse_mult_into(const LHS& lhs, const RHS& rhs, T* res)
+    {
+        assert(lhs.cols() == rhs.rows() && "Matrix dimensions do not match for multiplication.");
+
+        const int m = lhs.rows();
+        const int n = rhs.cols();
+        const int k = lhs.cols();
+        if constexpr (Concepts::SparseMatrixType<LHS>)
+            _implementation_details::with_dense_operand<T>(rhs,
+                                                           [&](const auto& B)
+                                                           {
+                                                               if constexpr (LHS::format == SparseFormat::CSR)
+                                                                   Kernels::csr_times_dense(m, n, lhs.operand(), B, res, n);
+                                                               else
+                                                                   Kernels::csc_times_dense(m, n, k, lhs.operand(), B, res, n);
+                                                           });
+        else
+            _implementation_details::with_dense_operand<T>(lhs,
+                                                           [&](const auto& A)
+                                                           {
+                                                               if constexpr (RHS::format == SparseFormat::CSR)
+                                                                   Kernels::dense_times_csr(m, n, k, A, rhs.operand(), res, n);
+                                                               else
+                                                                   Kernels::dense_times_csc(m, n, A, rhs.operand(), res, n);
+                                                           });
+    }
+
+    /**
+     * @brief Multiplies two sparse matrices. The result is a sparse CSR matrix, computed with Kernels::csr_times_csr; CSC operands are converted first.
+     *
+     * It is found by mat_mult like the dense products of the backends. Acc is ignored: the products are accumulated in the common scalar type.
+     *
+     * @tparam Acc ignored
+     * @tparam LHS left matrix type
+     * @tparam RHS right matrix type
+     * @param lhs left matrix
+     * @param rhs right matrix
+     * @return SparseMatrix<T, SparseFormat::CSR> with T being the common scalar type of the matrices
+     */
+    template <typename Acc = void, typename LHS, typename RHS>
+        requires Concepts::BothSparse<LHS, RHS>
+    auto two_matrix_mult(LHS&& lhs, RHS&& rhs)
+    {
+        assert(lhs.cols() == rhs.rows() && "Matrix dimensions do not match for multiplication.");
+
+        using T = LinAlg::CommonScalar<std::remove_cvref_t<LHS>, std::remove_cvref_t<RHS>>;
+        using LMat = std::remove_cvref_t<LHS>;
+        using RMat = std::remove_cvref_t<RHS>;
+        if constexpr (LMat::format == SparseFormat::CSC)
+            return two_matrix_mult<Acc>(SparseMatrix<typename LMat::Scalar, SparseFormat::CSR>(lhs), std::forward<RHS>(rhs));
+        else if constexpr (RMat::format == SparseFormat::CSC)
+            return two_matrix_mult<Acc>(std::forward<LHS>(lhs), SparseMatrix<typename RMat::Scalar, SparseFormat::CSR>(rhs));
+        else
+            return SparseMatrix<T, SparseFormat::CSR>(lhs.rows(), rhs.cols(), Kernels::csr_times_csr<T>(lhs.rows(), rhs.cols(), lhs.operand(), rhs.operand()));
+    }
+
+    /**
+     * @brief Two scratch buffers for the intermediate products of mat_mult_into. They only grow, so that repeated chains do not allocate.
+     *
+     * @tparam T scalar type of the intermediate products
+     */
+    template <typename T>
+    class ChainWorkspace
+    {
+      public:
+        T* buffer(int i, std::size_t size) ///< Returns the buffer i, 0 or 1, with at least size elements.
+        {
+            if (m_buffers[i].size() < size)
+                m_buffers[i].resize(size);
+            return m_buffers[i].data();
+        }
+
+      private:
+        std::array<std::vector<T>, 2> m_buffers;
+    };
+
+    /**
+     * @brief Computes the product of a chain of matrices into an existing matrix C.
+     *
+     * The intermediate products are written alternately in the two buffers of the workspace. Since two buffers only allow a linear evaluation,
+     * the chain is evaluated either from the left or from the right, whichever needs fewer operations; mat_mult may find a better parenthesization.
+     *
+     * @tparam CMat result matrix type, stored contiguously
+     * @tparam Args matrices types
+     * @param C result matrix, with the shape of the product
+     * @param workspace scratch buffers for the intermediate products
+     * @param args matrices or expressions
+     */
+    template <Kernels::Concepts::ContiguousMatrix CMat, typename... Args>
+    void mat_mult_into(CMat& C, ChainWorkspace<typename CMat::Scalar>& workspace, const Args&... args)
+    {
+        using T = typename CMat::Scalar;
+        constexpr int N_matrices = sizeof...(Args);
+        static_assert(N_matrices >= 2, "At least two matrices are needed for multiplication.");
+
+        const auto matrices = std::forward_as_tuple(args...);
+        const auto dims = _implementation_details::chain_dims(matrices);
+        assert(C.rows() == dims[0] && C.cols() == dims[N_matrices] && "The result matrix does not have the shape of the product.");
+
+        long long cost_left = 0;
+        long long cost_right = 0;
+        for (int i = 1; i < N_matrices; ++i)
+            cost_left += static_cast<long long>(dims[0]) * dims[i] * dims[i + 1];
+        for (int i = 0; i + 1 < N_matrices; ++i)
+            cost_right += static_cast<long long>(dims[i]) * dims[i + 1] * dims[N_matrices];
+
+        const T* previous = nullptr;
+        const auto output = [&](int step, int rows, int cols) { return step == N_matrices - 1 ? Kernels::data_ptr(C) : workspace.buffer(step % 2, static_cast<std::size_t>(rows) * cols); };
+        const auto output_ld = [&](int step, int cols) { return step == N_matrices - 1 ? Kernels::leading_dimension(C) : cols; };
+
+        if (cost_left <= cost_right)
+        {
+            // previous holds the product of matrices 0..I-1, of size dims[0] x dims[I].
+            [&]<std::size_t... I>(std::index_sequence<I...>)
+            {
+                (
+                    [&]
+                    {
+                        constexpr int step = I + 1;
+                        const int m = dims[0];
+                        const int k = dims[step];
+                        const int n = dims[step + 1];
+                        T* out = output(step, m, n);
+                        const int ld_out = output_ld(step, n);
+                        if constexpr (step == 1)
+                            Kernels::gemm(m, n, k, Kernels::make_operand(std::get<0>(matrices)), Kernels::make_operand(std::get<1>(matrices)), out, ld_out);
+                        else
+                            Kernels::gemm(m, n, k, Kernels::StridedOperand<T> { previous, k, 1 }, Kernels::make_operand(std::get<step>(matrices)), out, ld_out);
+                        previous = out;
+                    }(),
+                    ...);
+            }(std::make_index_sequence<N_matrices - 1> {});
+        }
         else
-            return two_matrix_mult(std::get<0>(matrices), mat_mult_impl(pop_front(matrices)));
+        {
+            // previous holds the product of matrices I+1..N-1, of size dims[I+1] x dims[N].
+            [&]<std::size_t... J>(std::index_sequence<J...>)
+            {
+                (
+                    [&]
+                    {
+                        constexpr int i = N_matrices - 2 - J;
+                        constexpr int step = J + 1;
+                        const int m = dims[i];
+                        const int k = dims[i + 1];
+                        const int n = dims[N_matrices];
+                        T* out = output(step, m, n);
+                        const int ld_out = output_ld(step, n);
+                        if constexpr (J == 0)
+                            Kernels::gemm(m, n, k, Kernels::make_operand(std::get<i>(matrices)), Kernels::make_operand(std::get<i + 1>(matrices)), out, ld_out);
+                        else
+                            Kernels::gemm(m, n, k, Kernels::make_operand(std::get<i>(matrices)), Kernels::StridedOperand<T> { previous, n, 1 }, out, ld_out);
+                        previous = out;
+                    }(),
+                    ...);
+            }(std::make_index_sequence<N_matrices - 1> {});
+        }
+    }
+
+    /**
+     * @brief Computes the products C[b] = A[b] * B[b] of a batch of small same-shape matrices, stored in contiguous arrays.
+     *
+     * It avoids the per-call overhead and the allocations of mat_mult when multiplying many tiny matrices. See Kernels::batched_gemm for
+     * the layouts; Kernels::interleave converts a contiguous batch into an interleaved one.
+     *
+     * @tparam T scalar type
+     * @param m number of rows of the matrices of A and C
+     * @param n number of columns of the matrices of B and C
+     * @param k number of columns of the matrices of A and rows of the matrices of B
+     * @param batch number of products
+     * @param A left matrices
+     * @param B right matrices
+     * @param C result matrices
+     * @param layout layout of A, B and C
+     */
+    template <typename T>
+    void batched_mat_mult(int m, int n, int k, std::size_t batch, std::span<const T> A, std::span<const T> B, std::span<T> C,
+                          Kernels::BatchLayout layout = Kernels::BatchLayout::Contiguous)
+    {
+        assert(A.size() >= Kernels::batched_size<T>(m, k, batch, layout) && "The left batch is too small.");
+        assert(B.size() >= Kernels::batched_size<T>(k, n, batch, layout) && "The right batch is too small.");
+        assert(C.size() >= Kernels::batched_size<T>(m, n, batch, layout) && "The result batch is too small.");
+        Kernels::batched_gemm(m, n, k, batch, A.data(), B.data(), C.data(), layout);
     }
 }
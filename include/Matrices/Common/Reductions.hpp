@@ -0,0 +1,77 @@
+#pragma once
+
+#include <Matrices/Common/ForwardDeclarations.hpp>
+#include <Matrices/Kernels/Operands.hpp>
+#include <Matrices/Kernels/Reductions.hpp>
+#include <stdafx.hpp>
+
+namespace LinAlg::Matrices::Common
+{
+    namespace _implementation_details
+    {
+        /**
+         * @brief Calls f with a pointer to the coefficients of a contiguous matrix without padding, else with the matrix itself,
+         * read through its flattened operator[].
+         */
+        template <typename Mat, typename F>
+        auto with_reduction_operand(const Mat& mat, F&& f)
+        {
+            if constexpr (Kernels::Concepts::ContiguousMatrix<Mat>)
+                if (Kernels::leading_dimension(mat) == mat.cols())
+                    return f(std::ranges::data(mat.data()));
+            return f(mat);
+        }
+    }
+
+    /**
+     * @brief Returns the sum of the coefficients of a matrix (or expression), accumulated in Acc.
+     *
+     * For instance, sum<double>(mat) on a float matrix reads floats but accumulates in double, which costs about the same as the float sum.
+     *
+     * @tparam Acc accumulation and return type, or void for the scalar type of the matrix
+     * @tparam Mat matrix type
+     * @param mat matrix
+     */
+    template <typename Acc = void, typename Mat>
+    auto sum(const Mat& mat)
+    {
+        using U = std::conditional_t<std::is_void_v<Acc>, LinAlg::CommonScalar<Mat>, Acc>;
+        return _implementation_details::with_reduction_operand(mat, [&](const auto& op) { return Kernels::reduce_sum<U>(mat.rows() * mat.cols(), op); });
+    }
+
+    /**
+     * @brief Returns the sum of the products of the coefficients of two matrices (or expressions) with the same shape, accumulated in Acc.
+     *
+     * @tparam Acc accumulation and return type, or void for the common scalar type of the matrices
+     * @tparam LHS left matrix type
+     * @tparam RHS right matrix type
+     * @param lhs left matrix
+     * @param rhs right matrix
+     */
+    template <typename Acc = void, typename LHS, typename RHS>
+    auto dot(const LHS& lhs, const RHS& rhs)
+    {
+        assert(lhs.rows() == rhs.rows() && lhs.cols() == rhs.cols() && "Matrix dimensions do not match for the dot product.");
+
+        using U = std::conditional_t<std::is_void_v<Acc>, LinAlg::CommonScalar<LHS, RHS>, Acc>;
+        const auto dot_with = [&](const auto& x)
+        {
+            return _implementation_details::with_reduction_operand(rhs, [&](const auto& y) { return Kernels::reduce_dot<U>(lhs.rows() * lhs.cols(), x, y); });
+        };
+        return _implementation_details::with_reduction_operand(lhs, dot_with);
+    }
+
+    /**
+     * @brief Returns the Frobenius norm of a matrix (or expression), the squares being accumulated in Acc.
+     *
+     * @tparam Acc accumulation and return type, or void for the scalar type of the matrix
+     * @tparam Mat matrix type
+     * @param mat matrix
+     */
+    template <typename Acc = void, typename Mat>
+    auto norm(const Mat& mat)
+    {
+        using std::sqrt;
+        return sqrt(dot<Acc>(mat, mat));
+    }
+}
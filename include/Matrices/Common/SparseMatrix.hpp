@@ -0,0 +1,277 @@
+#pragma once
+
+#include <Matrices/Common/Base.hpp>
+#include <Matrices/Kernels/Sparse.hpp>
+
+namespace LinAlg::Matrices::Common
+{
+    /**
+     * @brief A coefficient (row, col, value) used to build a SparseMatrix.
+     *
+     * @tparam T scalar type
+     */
+    template <typename T>
+    struct Triplet
+    {
+        int row;
+        int col;
+        T value;
+    };
+
+    /**
+     * @brief A sparse matrix stored in compressed rows (CSR) or compressed columns (CSC).
+     *
+     * Only the non-zeros are stored, sorted by row then column for CSR, by column then row for CSC. It is read-only: coefficients are accessed
+     * by value through a binary search in their row (or column), hence it can be used wherever a MatrixBase is read, for instance to build
+     * a dense Matrix. Products with dense matrices, through mat_mult, go through the sparse kernels instead (see Kernels::csr_times_dense).
+     * CSR is the natural format for products with a dense matrix on the right, CSC with a dense matrix on the left.
+     *
+     * @tparam T scalar type
+     * @tparam Format storage format
+     */
+    template <typename T, SparseFormat Format>
+    class SparseMatrix : public MatrixBase<SparseMatrix<T, Format>>
+    {
+      public:
+        using Scalar = T;
+        static constexpr SparseFormat format = Format;
+
+        SparseMatrix(int rows = 0, int cols = 0);                               ///< Construct a new SparseMatrix without non-zeros.
+        SparseMatrix(int rows, int cols, Kernels::CompressedArrays<T> arrays); ///< Construct a new SparseMatrix from its compressed arrays.
+        template <SparseFormat OtherFormat>
+            requires(OtherFormat != Format)
+        explicit SparseMatrix(const SparseMatrix<T, OtherFormat>& other); ///< Converts between the CSR and CSC formats.
+
+        static SparseMatrix from_triplets(int rows, int cols, std::span<const Triplet<T>> triplets);
+        template <typename Mat>
+        static SparseMatrix from_dense(const Mat& mat, T tolerance = T(0));
+
+        T operator[](int i, int j) const; ///< Returns the element at row i and column j.
+        T operator[](int i) const;        ///< Returns the element i in the flattened matrix.
+        T operator[](int i, int j);       ///< Returns the element at row i and column j.
+        T operator[](int i);              ///< Returns the element i in the flattened matrix.
+
+        int non_zeros() const;  ///< Returns the number of stored coefficients.
+        int outer_size() const; ///< Returns the number of rows for CSR, of columns for CSC.
+        int inner_size() const; ///< Returns the number of columns for CSR, of rows for CSC.
+
+        std::span<const int> offsets() const { return m_arrays.offsets; }
+        std::span<const int> indices() const { return m_arrays.indices; }
+        std::span<const T> values() const { return m_arrays.values; }
+        std::span<T> values() { return m_arrays.values; } ///< The stored values can be modified, but not the sparsity pattern.
+
+        Kernels::CompressedOperand<T> operand() const; ///< Returns the operand of the sparse kernels.
+
+        auto transpose() const; ///< Returns the transpose, stored in the other format with the same arrays.
+
+      private:
+        Kernels::CompressedArrays<T> m_arrays;
+    };
+
+    namespace _implementation_details
+    {
+        template <typename Mat>
+        inline constexpr bool is_sparse_matrix = false;
+        template <typename T, SparseFormat Format>
+        inline constexpr bool is_sparse_matrix<SparseMatrix<T, Format>> = true;
+    }
+}
+
+namespace LinAlg::Matrices::Common::Concepts
+{
+    template <typename Mat>
+    concept SparseMatrixType = _implementation_details::is_sparse_matrix<std::remove_cvref_t<Mat>>;
+    template <typename LHS, typename RHS>
+    concept BothSparse = SparseMatrixType<LHS> && SparseMatrixType<RHS>;
+    /// A product of a sparse matrix with a dense one, in either order.
+    template <typename LHS, typename RHS>
+    concept SparseDenseProduct = (SparseMatrixType<LHS> && !SparseMatrixType<RHS>) || (!SparseMatrixType<LHS> && SparseMatrixType<RHS>);
+}
+
+/*
+    Implementation
+    -----------------------------------------------------------------------------------------
+*/
+namespace LinAlg::Matrices::Common
+{
+    template <typename T, SparseFormat Format>
+    SparseMatrix<T, Format>::SparseMatrix(int rows, int cols)
+        : MatrixBase<SparseMatrix<T, Format>>(rows, cols)
+    {
+        m_arrays.offsets.assign(outer_size() + 1, 0);
+    }
+
+    template <typename T, SparseFormat Format>
+    SparseMatrix<T, Format>::SparseMatrix(int rows, int cols, Kernels::CompressedArrays<T> arrays)
+        : MatrixBase<SparseMatrix<T, Format>>(rows, cols)
+        , m_arrays(std::move(arrays))
+    {
+        assert(static_cast<int>(m_arrays.offsets.size()) == outer_size() + 1 && "The offsets do not match the outer size.");
+        assert(m_arrays.indices.size() == m_arrays.values.size() && static_cast<int>(m_arrays.indices.size()) == m_arrays.offsets.back()
+               && "The indices and values do not match the offsets.");
+    }
+
+    template <typename T, SparseFormat Format>
+    template <SparseFormat OtherFormat>
+        requires(OtherFormat != Format)
+    SparseMatrix<T, Format>::SparseMatrix(const SparseMatrix<T, OtherFormat>& other)
+        : SparseMatrix(other.rows(), other.cols(), Kernels::swap_compression(other.outer_size(), other.inner_size(), other.operand()))
+    {
+    }
+
+    /**
+     * @brief Builds a sparse matrix from its coefficients, given in any order. The values of duplicated coefficients are summed.
+     *
+     * The triplets are bucketed by inner then by outer index with two counting sorts, hence the cost is linear in their number.
+     *
+     * @param rows number of rows
+     * @param cols number of columns
+     * @param triplets coefficients
+     */
+    template <typename T, SparseFormat Format>
+    SparseMatrix<T, Format> SparseMatrix<T, Format>::from_triplets(int rows, int cols, std::span<const Triplet<T>> triplets)
+    {
+        const auto outer = [](const Triplet<T>& t) { return Format == SparseFormat::CSR ? t.row : t.col; };
+        const auto inner = [](const Triplet<T>& t) { return Format == SparseFormat::CSR ? t.col : t.row; };
+        const int outer_size = Format == SparseFormat::CSR ? rows : cols;
+        const int inner_size = Format == SparseFormat::CSR ? cols : rows;
+
+        Kernels::CompressedArrays<T> by_inner;
+        by_inner.offsets.assign(inner_size + 1, 0);
+        by_inner.indices.resize(triplets.size());
+        by_inner.values.resize(triplets.size());
+        for (const Triplet<T>& t : triplets)
+        {
+            assert(t.row >= 0 && t.row < rows && t.col >= 0 && t.col < cols && "Triplet out of the matrix bounds.");
+            ++by_inner.offsets[inner(t) + 1];
+        }
+        std::partial_sum(by_inner.offsets.begin(), by_inner.offsets.end(), by_inner.offsets.begin());
+        std::vector<int> next(by_inner.offsets.begin(), by_inner.offsets.end() - 1);
+        for (const Triplet<T>& t : triplets)
+        {
+            const int dst = next[inner(t)]++;
+            by_inner.indices[dst] = outer(t);
+            by_inner.values[dst] = t.value;
+        }
+
+        const Kernels::CompressedOperand<T> by_inner_operand { by_inner.offsets.data(), by_inner.indices.data(), by_inner.values.data() };
+        Kernels::CompressedArrays<T> arrays = Kernels::swap_compression(inner_size, outer_size, by_inner_operand);
+
+        // Duplicates are now adjacent: they are summed while compacting the arrays.
+        int nnz = 0;
+        int begin = 0;
+        for (int o = 0; o < outer_size; ++o)
+        {
+            const int first = nnz;
+            const int end = arrays.offsets[o + 1];
+            for (int q = begin; q < end; ++q)
+                if (nnz > first && arrays.indices[nnz - 1] == arrays.indices[q])
+                    arrays.values[nnz - 1] += arrays.values[q];
+                else
+                {
+                    arrays.indices[nnz] = arrays.indices[q];
+                    arrays.values[nnz] = arrays.values[q];
+                    ++nnz;
+                }
+            begin = end;
+            arrays.offsets[o + 1] = nnz;
+        }
+        arrays.indices.resize(nnz);
+        arrays.values.resize(nnz);
+        return SparseMatrix(rows, cols, std::move(arrays));
+    }
+
+    /**
+     * @brief Builds a sparse matrix from the coefficients of a dense matrix (or expression) whose absolute value is larger than tolerance.
+     *
+     * @tparam Mat matrix type
+     * @param mat matrix
+     * @param tolerance coefficients with an absolute value smaller or equal are dropped
+     */
+    template <typename T, SparseFormat Format>
+    template <typename Mat>
+    SparseMatrix<T, Format> SparseMatrix<T, Format>::from_dense(const Mat& mat, T tolerance)
+    {
+        using std::abs;
+        SparseMatrix res(mat.rows(), mat.cols());
+        Kernels::CompressedArrays<T>& arrays = res.m_arrays;
+        for (int o = 0; o < res.outer_size(); ++o)
+        {
+            for (int in = 0; in < res.inner_size(); ++in)
+            {
+                const T value = static_cast<T>(Format == SparseFormat::CSR ? mat[o, in] : mat[in, o]);
+                if (abs(value) > tolerance)
+                {
+                    arrays.indices.push_back(in);
+                    arrays.values.push_back(value);
+                }
+            }
+            arrays.offsets[o + 1] = static_cast<int>(arrays.indices.size());
+        }
+        return res;
+    }
+
+    template <typename T, SparseFormat Format>
+    T SparseMatrix<T, Format>::operator[](int i, int j) const
+    {
+        const int o = Format == SparseFormat::CSR ? i : j;
+        const int in = Format == SparseFormat::CSR ? j : i;
+        const auto first = m_arrays.indices.begin() + m_arrays.offsets[o];
+        const auto last = m_arrays.indices.begin() + m_arrays.offsets[o + 1];
+        const auto it = std::lower_bound(first, last, in);
+        return it != last && *it == in ? m_arrays.values[it - m_arrays.indices.begin()] : T(0);
+    }
+
+    template <typename T, SparseFormat Format>
+    T SparseMatrix<T, Format>::operator[](int i) const
+    {
+        return (*this)[i / this->m_cols, i % this->m_cols];
+    }
+
+    template <typename T, SparseFormat Format>
+    T SparseMatrix<T, Format>::operator[](int i, int j)
+    {
+        return std::as_const(*this)[i, j];
+    }
+
+    template <typename T, SparseFormat Format>
+    T SparseMatrix<T, Format>::operator[](int i)
+    {
+        return std::as_const(*this)[i];
+    }
+
+    template <typename T, SparseFormat Format>
+    int SparseMatrix<T, Format>::non_zeros() const
+    {
+        return static_cast<int>(m_arrays.values.size());
+    }
+
+    template <typename T, SparseFormat Format>
+    int SparseMatrix<T, Format>::outer_size() const
+    {
+        return Format == SparseFormat::CSR ? this->m_rows : this->m_cols;
+    }
+
+    template <typename T, SparseFormat Format>
+    int SparseMatrix<T, Format>::inner_size() const
+    {
+        return Format == SparseFormat::CSR ? this->m_cols : this->m_rows;
+    }
+
+    template <typename T, SparseFormat Format>
+    Kernels::CompressedOperand<T> SparseMatrix<T, Format>::operand() const
+    {
+        return { m_arrays.offsets.data(), m_arrays.indices.data(), m_arrays.values.data() };
+    }
+
+    /**
+     * @brief Returns the transpose of the matrix. The CSR arrays of a matrix are the CSC arrays of its transpose, hence the arrays are copied
+     * as they are, without sorting.
+     */
+    template <typename T, SparseFormat Format>
+    auto SparseMatrix<T, Format>::transpose() const
+    {
+        constexpr SparseFormat other_format = Format == SparseFormat::CSR ? SparseFormat::CSC : SparseFormat::CSR;
+        return SparseMatrix<T, other_format>(this->m_cols, this->m_rows, m_arrays);
+    }
+}
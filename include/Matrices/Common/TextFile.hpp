@@ -0,0 +1,269 @@
+#pragma once
+
+#include <Matrices/Common/Base.hpp>
+#include <Matrices/Common/ForwardDeclarations.hpp>
+#include <Matrices/Common/MappedArray.hpp>
+#include <Matrices/Common/Matrix.hpp>
+#include <Matrices/Kernels/ThreadPool.hpp>
+#include <stdafx.hpp>
+
+namespace LinAlg::Matrices::Common
+{
+    /**
+     * @brief Format of a text matrix file: one row per line, the coefficients being separated by blanks or by commas.
+     */
+    enum class TextFormat
+    {
+        Whitespace, ///< Coefficients separated by spaces or tabs.
+        CSV         ///< Coefficients separated by commas, optionally surrounded by spaces or tabs.
+    };
+
+    template <typename Derived>
+    void write_text(std::ostream& os, const MatrixBase<Derived>& mat, TextFormat format = TextFormat::Whitespace);
+
+    template <typename Derived>
+    void save_text(const std::filesystem::path& path, const MatrixBase<Derived>& mat, TextFormat format = TextFormat::Whitespace);
+
+    template <typename MatrixType>
+    MatrixType parse_text(std::string_view text, TextFormat format = TextFormat::Whitespace);
+
+    template <typename MatrixType>
+    MatrixType load_text(const std::filesystem::path& path, TextFormat format = TextFormat::Whitespace);
+
+    namespace _implementation_details
+    {
+        inline bool is_blank(char c)
+        {
+            return c == ' ' || c == '\t' || c == '\r';
+        }
+
+        inline bool is_blank_line(std::string_view line)
+        {
+            return std::ranges::all_of(line, is_blank);
+        }
+
+        /**
+         * @brief Returns the positions of the chunks of text parsed in parallel: beginnings of lines about chunk_size bytes apart,
+         * followed by text.size().
+         */
+        inline std::vector<std::size_t> split_lines(std::string_view text, std::size_t chunk_size)
+        {
+            std::vector<std::size_t> bounds { 0 };
+            while (text.size() - bounds.back() > chunk_size)
+            {
+                const std::size_t end_of_line = text.find('\n', bounds.back() + chunk_size);
+                if (end_of_line == std::string_view::npos)
+                    break;
+                bounds.push_back(end_of_line + 1);
+            }
+            bounds.push_back(text.size());
+            return bounds;
+        }
+
+        /**
+         * @brief Calls f with every line of text, without its end of line character.
+         */
+        template <typename Func>
+        void for_each_line(std::string_view text, Func&& f)
+        {
+            while (!text.empty())
+            {
+                const std::size_t end_of_line = std::min(text.find('\n'), text.size());
+                f(text.substr(0, end_of_line));
+                text.remove_prefix(std::min(end_of_line + 1, text.size()));
+            }
+        }
+
+        /**
+         * @brief Returns the first line of text which is not blank, without its end of line character, or an empty view.
+         */
+        inline std::string_view first_non_blank_line(std::string_view text)
+        {
+            while (!text.empty())
+            {
+                const std::size_t end_of_line = std::min(text.find('\n'), text.size());
+                const std::string_view line = text.substr(0, end_of_line);
+                if (!is_blank_line(line))
+                    return line;
+                text.remove_prefix(std::min(end_of_line + 1, text.size()));
+            }
+            return {};
+        }
+
+        /**
+         * @brief Parses the coefficients of a line, calling store(j, value) for each one, and returns their number, or an error message.
+         */
+        template <typename T, typename Store>
+        std::variant<int, std::string> parse_line(std::string_view line, TextFormat format, Store&& store)
+        {
+            const char* it = line.data();
+            const char* const end = it + line.size();
+            const auto skip_blanks = [&] { it = std::find_if_not(it, end, is_blank); };
+
+            int j = 0;
+            for (skip_blanks(); it != end; ++j)
+            {
+                T value;
+                const auto [ptr, error] = std::from_chars(it, end, value);
+                if (error != std::errc())
+                    return "cannot read the coefficient " + std::to_string(j + 1);
+                store(j, value);
+                it = ptr;
+                if (it != end && !is_blank(*it) && format == TextFormat::Whitespace)
+                    return "unexpected character after the coefficient " + std::to_string(j + 1);
+                skip_blanks();
+                if (format == TextFormat::CSV && it != end)
+                {
+                    if (*it != ',')
+                        return "expected a comma after the coefficient " + std::to_string(j + 1);
+                    ++it;
+                    skip_blanks();
+                    if (it == end)
+                        return "missing coefficient after the last comma";
+                }
+            }
+            return j;
+        }
+    }
+}
+
+/*
+    Implementation
+    -----------------------------------------------------------------------------------------
+*/
+namespace LinAlg::Matrices::Common
+{
+    /**
+     * @brief Writes a matrix (or an expression) as text, one row per line.
+     *
+     * The coefficients are formatted with std::to_chars into a buffer written to os by large blocks. The floating point numbers are written
+     * in the shortest form which reads back to the same value, hence parse_text restores the matrix exactly. Unlike operator<<, the output
+     * does not depend on the formatting flags of os.
+     *
+     * @param os output stream, opened in binary mode for a file
+     * @param mat matrix or expression
+     * @param format separator of the coefficients
+     */
+    template <typename Derived>
+    void write_text(std::ostream& os, const MatrixBase<Derived>& mat, TextFormat format)
+    {
+        constexpr std::size_t buffer_size = std::size_t(1) << 16;
+        constexpr std::size_t max_length = 64; ///< Upper bound of the length of a coefficient and its separator.
+        const Derived& derived = static_cast<const Derived&>(mat);
+        const char separator = format == TextFormat::CSV ? ',' : ' ';
+
+        std::vector<char> buffer(buffer_size);
+        char* out = buffer.data();
+        char* const end = buffer.data() + buffer_size;
+        for (int i = 0; i < mat.rows(); ++i)
+            for (int j = 0; j < mat.cols(); ++j)
+            {
+                out = std::to_chars(out, end, derived[i, j]).ptr;
+                *out++ = j + 1 < mat.cols() ? separator : '\n';
+                if (end - out < static_cast<std::ptrdiff_t>(max_length))
+                {
+                    os.write(buffer.data(), out - buffer.data());
+                    out = buffer.data();
+                }
+            }
+        os.write(buffer.data(), out - buffer.data());
+    }
+
+    /**
+     * @brief Writes a matrix (or an expression) into a text file with write_text.
+     */
+    template <typename Derived>
+    void save_text(const std::filesystem::path& path, const MatrixBase<Derived>& mat, TextFormat format)
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file)
+            _implementation_details::throw_system_error("Cannot create " + path.string());
+        write_text(file, mat, format);
+        file.close();
+        if (!file)
+            _implementation_details::throw_system_error("Cannot write " + path.string());
+    }
+
+    /**
+     * @brief Parses a matrix written as text, one row per line, on the global thread pool (see Kernels::parallel_for).
+     *
+     * The text is cut at line boundaries into chunks parsed in parallel with std::from_chars, after a first parallel pass counting their rows,
+     * so that each chunk knows the rows it writes. The blank lines are skipped, and all the other lines must have the number of coefficients
+     * of the first one. The errors are thrown as std::runtime_error, with the number of the line.
+     *
+     * @tparam MatrixType type of the matrix, for instance ET::Matrix<double>
+     * @param text rows of the matrix
+     * @param format separator of the coefficients
+     */
+    template <typename MatrixType>
+    MatrixType parse_text(std::string_view text, TextFormat format)
+    {
+        using T = typename MatrixType::Scalar;
+        constexpr std::size_t chunk_size = std::size_t(1) << 18;
+
+        const std::vector<std::size_t> bounds = _implementation_details::split_lines(text, chunk_size);
+        const int n_chunks = static_cast<int>(bounds.size()) - 1;
+        const auto chunk = [&](int c) { return text.substr(bounds[c], bounds[c + 1] - bounds[c]); };
+
+        // First rows and first lines of the chunks.
+        std::vector<int> first_row(n_chunks + 1, 0);
+        std::vector<int> first_line(n_chunks + 1, 0);
+        Kernels::parallel_for(n_chunks, [&](int c)
+        {
+            _implementation_details::for_each_line(chunk(c), [&](std::string_view line)
+            {
+                first_row[c + 1] += !_implementation_details::is_blank_line(line);
+                ++first_line[c + 1];
+            });
+        });
+        std::partial_sum(first_row.begin(), first_row.end(), first_row.begin());
+        std::partial_sum(first_line.begin(), first_line.end(), first_line.begin());
+        const int rows = first_row.back();
+
+        // The number of columns is the one of the first row, the scan stopping there.
+        int cols = 0;
+        if (const auto count = _implementation_details::parse_line<T>(_implementation_details::first_non_blank_line(text), format, [](int, T) {});
+            std::holds_alternative<int>(count))
+            cols = std::get<int>(count);
+        if (rows > 0 && cols == 0)
+            throw std::runtime_error("Cannot read the first row of the matrix");
+
+        MatrixType result(rows, cols, uninitialized);
+        std::vector<std::string> errors(n_chunks);
+        Kernels::parallel_for(n_chunks, [&](int c)
+        {
+            int i = first_row[c];
+            int line_number = first_line[c];
+            _implementation_details::for_each_line(chunk(c), [&](std::string_view line)
+            {
+                ++line_number;
+                if (!errors[c].empty() || _implementation_details::is_blank_line(line))
+                    return;
+                const auto count = _implementation_details::parse_line<T>(line, format, [&](int j, T value)
+                {
+                    if (j < cols)
+                        result[i, j] = value;
+                });
+                if (std::holds_alternative<std::string>(count))
+                    errors[c] = "Line " + std::to_string(line_number) + ": " + std::get<std::string>(count);
+                else if (std::get<int>(count) != cols)
+                    errors[c] = "Line " + std::to_string(line_number) + ": " + std::to_string(std::get<int>(count)) + " coefficients instead of " + std::to_string(cols);
+                ++i;
+            });
+        });
+
+        if (const auto error = std::ranges::find_if_not(errors, &std::string::empty); error != errors.end())
+            throw std::runtime_error(*error);
+        return result;
+    }
+
+    /**
+     * @brief Reads a text matrix file with parse_text. The file is mapped rather than read into a string.
+     */
+    template <typename MatrixType>
+    MatrixType load_text(const std::filesystem::path& path, TextFormat format)
+    {
+        const MappedArray<char> text = MappedArray<char>::open(path);
+        return parse_text<MatrixType>(std::string_view(text.data(), text.size()), format);
+    }
+}
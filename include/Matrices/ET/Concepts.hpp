@@ -8,17 +8,19 @@ namespace LinAlg::Matrices::ET::Concepts
 
 }
 
-namespace LinAlg::Matrices::ET
+namespace LinAlg::Matrices::ET::Concepts
 {
     template <typename T>
-    class Matrix;
-}
+    inline constexpr bool is_dynamic_matrix = false;
+
+    template <typename T, typename Layout>
+    inline constexpr bool is_dynamic_matrix<Matrix<T, Dynamic, Dynamic, Layout>> = true;
+
+    template <typename T>
+    inline constexpr bool is_dynamic_matrix<MappedMatrix<T>> = true;
 
-namespace LinAlg::Matrices::ET::Concepts
-{
     template <typename T>
-    concept MatrixType
-        = std::is_base_of_v<MatrixBase<std::remove_cvref_t<T>>, std::remove_cvref_t<T>> || std::is_same_v<Matrix<typename LinAlg::traits<std::remove_cvref_t<T>>::Scalar>, std::remove_cvref_t<T>>;
+    concept MatrixType = std::is_base_of_v<MatrixBase<std::remove_cvref_t<T>>, std::remove_cvref_t<T>> || is_dynamic_matrix<std::remove_cvref_t<T>>;
     template <typename T>
     concept ScalarType = std::is_integral_v<std::remove_cvref_t<T>> || std::is_floating_point_v<std::remove_cvref_t<T>>;
 
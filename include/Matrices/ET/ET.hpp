@@ -1,6 +1,13 @@
 #pragma once
 
+#include <Matrices/Common/BinaryFile.hpp>
+#include <Matrices/Common/Reductions.hpp>
+#include <Matrices/Common/SparseMatrix.hpp>
+#include <Matrices/Common/TextFile.hpp>
 #include <Matrices/ET/Expressions.hpp>
+#include <Matrices/ET/FixedMatrix.hpp>
 #include <Matrices/ET/HelperMatrices.hpp>
+#include <Matrices/ET/MappedMatrix.hpp>
 #include <Matrices/ET/Matrix.hpp>
 #include <Matrices/ET/MatrixMultiplication.hpp>
+#include <Matrices/ET/View.hpp>
@@ -21,18 +21,58 @@ namespace LinAlg::Matrices::ET
             return t;
         }
 
-        template <typename Tuple>
-        auto& first_matrix(const Tuple& tuple)
+        template <Concepts::MatrixType T>
+        auto subscript(const T& t, int i, int j)
+        {
+            return t[i, j];
+        }
+
+        template <Concepts::ScalarType T>
+        auto subscript(const T& t, int, int)
+        {
+            return t;
+        }
+
+        template <Concepts::MatrixType T>
+        auto unpadded_subscript(const T& t, int i)
+        {
+            return Kernels::unpadded_coeff(t, i);
+        }
+
+        template <Concepts::ScalarType T>
+        auto unpadded_subscript(const T& t, int)
+        {
+            return t;
+        }
+
+        template <typename T>
+        bool padded(const T& t)
+        {
+            if constexpr (Concepts::MatrixType<T>)
+                return Kernels::is_padded(t);
+            else
+                return false;
+        }
+
+        template <typename T>
+        constexpr bool row_major_matrix()
         {
-            using LinAlg::Matrices::Common::pop_front;
-            constexpr int N_args = std::tuple_size_v<Tuple>;
+            if constexpr (Concepts::MatrixType<T>)
+                return Kernels::is_row_major<T>;
+            else
+                return false;
+        }
 
-            static_assert(N_args > 0, "No matrices in the tuple.");
+        // The first matrix is looked up by index in the tuple itself: the arguments stored by value, as the views, must not be read from a copy.
+        template <std::size_t I = 0, typename Tuple>
+        auto& first_matrix(const Tuple& tuple)
+        {
+            static_assert(I < std::tuple_size_v<Tuple>, "No matrices in the tuple.");
 
-            if constexpr (Concepts::MatrixType<decltype(std::get<0>(tuple))>)
-                return std::get<0>(tuple);
+            if constexpr (Concepts::MatrixType<std::tuple_element_t<I, Tuple>>)
+                return std::get<I>(tuple);
             else
-                return first_matrix(pop_front(tuple));
+                return first_matrix<I + 1>(tuple);
         }
     }
 
@@ -41,6 +81,11 @@ namespace LinAlg::Matrices::ET
     {
       public:
         using Scalar = LinAlg::CommonScalar<Args...>;
+        /// The shape of the fixed size matrices of the expression, if any, else Dynamic.
+        static constexpr int RowsAtCompileTime = Common::common_dimension({ Common::rows_at_compile_time<std::remove_cvref_t<Args>>... });
+        static constexpr int ColsAtCompileTime = Common::common_dimension({ Common::cols_at_compile_time<std::remove_cvref_t<Args>>... });
+        /// Whether one of the matrices of the expression at least is row-major: the expression is then evaluated row by row (see Kernels::assign).
+        static constexpr bool IsRowMajor = (_implementation_details::row_major_matrix<Args>() || ...);
 
         template <typename Func, typename... Matrices>
         Expr(Func&& callable, Matrices&&... mats)
@@ -67,10 +112,31 @@ namespace LinAlg::Matrices::ET
             return std::apply(f, m_args);
         }
 
-        Scalar operator[](int i, int j) const { return operator[](i*(this->m_cols) + j); }
+        Scalar operator[](int i, int j) const
+        {
+            using _implementation_details::subscript;
+
+            const auto f = [this, i, j](const Args&... args) { return m_callable(subscript(args, i, j)...); };
+            return std::apply(f, m_args);
+        }
+
+        /// Whether one of the matrices of the expression has padded rows.
+        bool is_padded() const
+        {
+            return std::apply([](const Args&... args) { return (_implementation_details::padded(args) || ...); }, m_args);
+        }
+
+        /// The flattened coefficient i, if the expression is not padded, read without the padding tests of the matrices (see Kernels::unpadded_coeff()).
+        Scalar unpadded_coeff(int i) const
+        {
+            using _implementation_details::unpadded_subscript;
+
+            const auto f = [this, i](const Args&... args) { return m_callable(unpadded_subscript(args, i)...); };
+            return std::apply(f, m_args);
+        }
 
-        Matrix<Scalar> eval() const& = delete;
-        Matrix<Scalar> eval() const&& { return Matrix<Scalar>(*this); }
+        Matrix<Scalar, RowsAtCompileTime, ColsAtCompileTime> eval() const& = delete;
+        Matrix<Scalar, RowsAtCompileTime, ColsAtCompileTime> eval() const&& { return Matrix<Scalar, RowsAtCompileTime, ColsAtCompileTime>(*this); }
 
       private:
         std::tuple<Args...> m_args;
@@ -85,7 +151,10 @@ namespace LinAlg::Matrices::ET
     auto operator+(LHS&& lhs, RHS&& rhs)
     {
         if constexpr (Concepts::BothMatrices<LHS, RHS>)
+        {
+            static_assert(Common::shapes_match<LHS, RHS>, "Matrix dimensions do not match for addition.");
             assert(lhs.rows() == rhs.rows() && lhs.cols() == rhs.cols() && "Matrix dimensions do not match for addition.");
+        }
 
         return Expr([](auto const& l, auto const& r) { return l + r; }, std::forward<LHS>(lhs), std::forward<RHS>(rhs));
     }
@@ -95,7 +164,10 @@ namespace LinAlg::Matrices::ET
     auto operator-(LHS&& lhs, RHS&& rhs)
     {
         if constexpr (Concepts::BothMatrices<LHS, RHS>)
+        {
+            static_assert(Common::shapes_match<LHS, RHS>, "Matrix dimensions do not match for substraction.");
             assert(lhs.rows() == rhs.rows() && lhs.cols() == rhs.cols() && "Matrix dimensions do not match for substraction.");
+        }
 
         return Expr([](auto const& l, auto const& r) { return l - r; }, std::forward<LHS>(lhs), std::forward<RHS>(rhs));
     }
@@ -105,7 +177,10 @@ namespace LinAlg::Matrices::ET
     auto operator*(LHS&& lhs, RHS&& rhs)
     {
         if constexpr (Concepts::BothMatrices<LHS, RHS>)
+        {
+            static_assert(Common::shapes_match<LHS, RHS>, "Matrix dimensions do not match for coefficient wise multiplication.");
             assert(lhs.rows() == rhs.rows() && lhs.cols() == rhs.cols() && "Matrix dimensions do not match for coefficient wise multiplication.");
+        }
 
         return Expr([](auto const& l, auto const& r) { return l * r; }, std::forward<LHS>(lhs), std::forward<RHS>(rhs));
     }
@@ -115,7 +190,10 @@ namespace LinAlg::Matrices::ET
     auto operator/(LHS&& lhs, RHS&& rhs)
     {
         if constexpr (Concepts::BothMatrices<LHS, RHS>)
+        {
+            static_assert(Common::shapes_match<LHS, RHS>, "Matrix dimensions do not match for coefficient wise division.");
             assert(lhs.rows() == rhs.rows() && lhs.cols() == rhs.cols() && "Matrix dimensions do not match for coefficient wise division.");
+        }
 
         return Expr([](auto const& l, auto const& r) { return l / r; }, std::forward<LHS>(lhs), std::forward<RHS>(rhs));
     }
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <Matrices/ET/ForwardDeclarations.hpp>
+#include <Matrices/ET/Matrix.hpp>
+
+namespace LinAlg::Matrices::ET
+{
+    /**
+     * @brief A matrix whose dimensions are known at compile time, for instance Matrix<double, 4, 4>.
+     *
+     * The coefficients are stored in a std::array inside the object, hence the matrix lives on the stack and is never allocated.
+     * All its members are constexpr, and so are the products of fixed size matrices through mat_mult (see the fixed size two_matrix_mult):
+     * they can be computed at compile time. It takes part in the expressions like the dynamic Matrix, and operations between fixed size matrices
+     * with different shapes do not compile. The dimensions given at runtime, for instance to the constructors taking rows and cols,
+     * are only checked by assertions.
+     *
+     * @tparam T scalar type
+     * @tparam Rows number of rows
+     * @tparam Cols number of columns
+     */
+    template <typename T, int Rows, int Cols>
+        requires(Rows != Dynamic && Cols != Dynamic)
+    class Matrix<T, Rows, Cols> : public MatrixBase<Matrix<T, Rows, Cols>>, public _implementation_details::ViewFactory<Matrix<T, Rows, Cols>>
+    {
+        static_assert(Rows > 0 && Cols > 0, "The dimensions of a fixed size Matrix must be positive.");
+
+      public:
+        using Scalar = T;
+        static constexpr int RowsAtCompileTime = Rows;
+        static constexpr int ColsAtCompileTime = Cols;
+
+        constexpr Matrix() ///< Construct a new Matrix with zero coefficients.
+            : MatrixBase<Matrix>(Rows, Cols)
+        {
+        }
+
+        constexpr Matrix(int rows, int cols) ///< Construct a new Matrix with zero coefficients. The dimensions must be Rows and Cols.
+            : Matrix()
+        {
+            assert(rows == Rows && cols == Cols && "Matrix dimensions do not match the fixed dimensions.");
+        }
+
+        constexpr Matrix(const Matrix& other) ///< Copy constructor.
+            : MatrixBase<Matrix>(Rows, Cols)
+            , m_data(other.m_data)
+        {
+        }
+
+        constexpr Matrix(std::initializer_list<std::initializer_list<Scalar>> list) ///< Construct a new Matrix object from embedded initializer lists.
+            : Matrix()
+        {
+            assert(list.size() == Rows && "Wrong number of rows in the initializer list.");
+            int i = 0;
+            for (const auto& row : list)
+            {
+                assert(row.size() == Cols && "Wrong number of columns in the initializer list.");
+                std::copy(row.begin(), row.end(), m_data.begin() + i++ * Cols);
+            }
+        }
+
+        template <typename OtherDerived>
+        constexpr Matrix(const MatrixBase<OtherDerived>& other) ///< Construct a new Matrix object from a MatrixBase object. It forces expressions to be evaluated.
+            : Matrix()
+        {
+            *this = other;
+        }
+
+        constexpr Matrix& operator=(const Matrix& other) ///< Copy assignment.
+        {
+            m_data = other.m_data;
+            return *this;
+        }
+
+        template <typename OtherDerived>
+        constexpr Matrix& operator=(const MatrixBase<OtherDerived>& other) ///< Copy assignment from a MatrixBase object. It forces expressions to be evaluated.
+        {
+            static_assert(Common::shapes_match<Matrix, OtherDerived>, "Matrix dimensions do not match the fixed dimensions.");
+            assert(other.rows() == Rows && other.cols() == Cols && "Matrix dimensions do not match the fixed dimensions.");
+            const OtherDerived& derived = static_cast<const OtherDerived&>(other);
+            for (int i = 0; i < Rows * Cols; ++i)
+                m_data[i] = static_cast<Scalar>(derived[i]);
+            return *this;
+        }
+
+        static constexpr int rows() { return Rows; }        ///< Returns the number of rows.
+        static constexpr int cols() { return Cols; }        ///< Returns the number of columns.
+        static constexpr int size() { return Rows * Cols; } ///< Returns the number of elements.
+
+        constexpr Scalar& operator[](int i, int j) { return m_data[i * Cols + j]; }      ///< Access the element at row i and column j.
+        constexpr Scalar operator[](int i, int j) const { return m_data[i * Cols + j]; } ///< Access the element at row i and column j.
+        constexpr Scalar& operator[](int i) { return m_data[i]; }                        ///< Access the element i in the flattened matrix.
+        constexpr Scalar operator[](int i) const { return m_data[i]; }                   ///< Access the element i in the flattened matrix.
+
+        constexpr std::array<Scalar, Rows * Cols>& data() { return m_data; }
+        constexpr const std::array<Scalar, Rows * Cols>& data() const { return m_data; }
+
+        template <typename Func>
+        auto apply(Func&& f) const ///< Returns an expression applying the function f to all elements.
+        {
+            return Expr(std::forward<Func>(f), *this);
+        }
+
+        template <typename Func>
+        constexpr Matrix& apply_inplace(Func&& f) ///< Applies the function f to all elements inplace.
+        {
+            for (Scalar& x : m_data)
+                x = f(x);
+            return *this;
+        }
+
+        constexpr Matrix& zero() { return set(Scalar(0)); } ///< Sets all elements to zero.
+        constexpr Matrix& set(const Scalar& val)            ///< Sets all elements to val.
+        {
+            m_data.fill(val);
+            return *this;
+        }
+
+        /// Returns a Matrix with constant coefficients.
+        static constexpr Matrix Constant(const Scalar& value) { return Matrix().set(value); }
+        /// Returns a Matrix with constant coefficients. The dimensions must be Rows and Cols.
+        static constexpr Matrix Constant(int rows, int cols, const Scalar& value) { return Matrix(rows, cols).set(value); }
+        /// Returns the zero Matrix. The dimensions must be Rows and Cols.
+        static constexpr Matrix Zero(int rows = Rows, int cols = Cols) { return Matrix(rows, cols); }
+        /// Returns the identity Matrix. The size must be Rows.
+        static constexpr Matrix Identity(int n = Rows)
+        {
+            static_assert(Rows == Cols, "The identity matrix is square.");
+            Matrix res(n, n);
+            for (int i = 0; i < Rows; ++i)
+                res[i, i] = Scalar(1);
+            return res;
+        }
+        /// Returns a Matrix with normally distributed coefficients, see the dynamic Matrix. The dimensions must be Rows and Cols.
+        static Matrix randn(int rows = Rows, int cols = Cols, Scalar mean = 0, Scalar stddev = 1, Scalar min_abs_value = 0,
+                            std::optional<int> seed = std::nullopt)
+        {
+            return Matrix(Matrix<Scalar>::randn(rows, cols, mean, stddev, min_abs_value, seed));
+        }
+
+      private:
+        std::array<Scalar, Rows * Cols> m_data {};
+    };
+
+    using Matrix2d = Matrix<double, 2, 2>;
+    using Matrix3d = Matrix<double, 3, 3>;
+    using Matrix4d = Matrix<double, 4, 4>;
+    using Matrix2f = Matrix<float, 2, 2>;
+    using Matrix3f = Matrix<float, 3, 3>;
+    using Matrix4f = Matrix<float, 4, 4>;
+}
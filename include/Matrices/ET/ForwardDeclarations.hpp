@@ -7,17 +7,33 @@ namespace LinAlg::Matrices::ET
     template <typename Derived>
     using MatrixBase = LinAlg::Matrices::Common::MatrixBase<Derived>;
 
-    template <typename T>
+    using LinAlg::Matrices::Common::Dynamic;
+
+    using LinAlg::Matrices::Common::ColMajor;
+    using LinAlg::Matrices::Common::RowMajor;
+    using LinAlg::Matrices::Common::Tiled;
+
+    /**
+     * @brief A dense matrix. Its storage is allocated on the heap if its dimensions are Dynamic, the default, and stored inline in the
+     * object if they are known at compile time. The dynamic matrices can be stored in another Layout than RowMajor.
+     */
+    template <typename T, int Rows = Dynamic, int Cols = Dynamic, typename Layout = RowMajor>
     class Matrix;
 
     template <typename Callable, typename... Args>
     class Expr;
+
+    template <typename T>
+    class StridedView;
+
+    template <typename T>
+    class MappedMatrix;
 }
 
 namespace LinAlg
 {
-    template <typename T>
-    struct traits<LinAlg::Matrices::ET::Matrix<T>>
+    template <typename T, int Rows, int Cols, typename Layout>
+    struct traits<LinAlg::Matrices::ET::Matrix<T, Rows, Cols, Layout>>
     {
         using Scalar = T;
     };
@@ -27,4 +43,16 @@ namespace LinAlg
     {
         using Scalar = CommonScalar<Args...>;
     };
+
+    template <typename T>
+    struct traits<LinAlg::Matrices::ET::MappedMatrix<T>>
+    {
+        using Scalar = T;
+    };
+
+    template <typename T>
+    struct traits<LinAlg::Matrices::ET::StridedView<T>>
+    {
+        using Scalar = std::remove_const_t<T>;
+    };
 }
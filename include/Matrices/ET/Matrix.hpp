@@ -2,15 +2,27 @@
 
 #include <Matrices/Common/Matrix.hpp>
 #include <Matrices/ET/ForwardDeclarations.hpp>
+#include <Matrices/ET/View.hpp>
 
 namespace LinAlg::Matrices::ET
 {
-    template <typename T>
-    class Matrix : public LinAlg::Matrices::Common::Matrix<std::vector<T>>
+    /**
+     * @brief A matrix whose dimensions are known at runtime, stored in a std::vector aligned to a cache line. Its rows can be padded,
+     * see the Common::Matrix constructor taking a leading dimension. Its blocks, rows, columns, diagonal and transpose are available
+     * as views without copy, unless it is Tiled (see ViewFactory).
+     *
+     * @tparam T scalar type
+     * @tparam Layout layout of the coefficients: RowMajor, ColMajor or Tiled
+     */
+    template <typename T, int Rows, int Cols, typename Layout>
+    class Matrix : public LinAlg::Matrices::Common::Matrix<std::vector<T, Common::AlignedAllocator<T>>, Layout>,
+                   public _implementation_details::ViewFactory<Matrix<T, Rows, Cols, Layout>>
     {
+        static_assert(Rows == Dynamic && Cols == Dynamic, "The rows and columns of a Matrix are either both fixed or both Dynamic.");
+
       public:
         using Scalar = T;
-        using LinAlg::Matrices::Common::Matrix<std::vector<T>>::Matrix;
+        using LinAlg::Matrices::Common::Matrix<std::vector<T, Common::AlignedAllocator<T>>, Layout>::Matrix;
 
         template <typename Func>
         auto apply(Func&& f) const ///< Returns an expression applying the function f to all elements.
@@ -22,4 +34,12 @@ namespace LinAlg::Matrices::ET
     using Matrixd = Matrix<double>;
     using Matrixf = Matrix<float>;
     using Matrixi = Matrix<int>;
+    using Matrixi8 = Matrix<std::int8_t>;
+    using Matrixi16 = Matrix<std::int16_t>;
+    using Matrixi64 = Matrix<std::int64_t>;
+
+    template <typename T>
+    using ColMajorMatrix = Matrix<T, Dynamic, Dynamic, ColMajor>; ///< A dynamic matrix stored column by column.
+    template <typename T, int TileSize = Common::cache_line_size / sizeof(T)>
+    using TiledMatrix = Matrix<T, Dynamic, Dynamic, Tiled<TileSize>>; ///< A dynamic matrix stored by tiles, whose rows are a cache line by default.
 }
@@ -1,27 +1,230 @@
 #pragma once
 
 #include <Matrices/Common/MatrixMultiplication.hpp>
+#include <Matrices/ET/FixedMatrix.hpp>
 #include <Matrices/ET/ForwardDeclarations.hpp>
+#include <Matrices/Kernels/Fixed.hpp>
+#include <Matrices/Kernels/Gemm.hpp>
+#include <Matrices/Kernels/Gemv.hpp>
+#include <Matrices/Kernels/IntGemm.hpp>
+#include <Matrices/Kernels/Strassen.hpp>
+#include <Matrices/Kernels/Syrk.hpp>
 
 namespace LinAlg::Matrices::ET
 {
-    template <typename LHS, typename RHS>
+    namespace _implementation_details
+    {
+        template <typename T, typename LHS, typename RHS>
+        void naive_two_matrix_mult(const LHS& lhs, const RHS& rhs, Matrix<T>& res)
+        {
+            for (int i = 0; i < lhs.rows(); ++i)
+                for (int j = 0; j < rhs.cols(); ++j)
+                {
+
+                    res[i, j] = lhs[i, 0] * rhs[0, j];
+                    for (int k = 1; k < lhs.cols(); ++k)
+                        res[i, j] += lhs[i, k] * rhs[k, j];
+                }
+        }
+    }
+
+    /**
+     * @brief Multiplies two matrices.
+     *
+     * Products with a column or row vector go through the GEMV kernels. Other floating point products go through the cache blocked GEMM kernel,
+     * integer products through the integer kernel, which accumulates in a widened type (see widening_mult to get the widened result).
+     *
+     * Expression operands are not evaluated into temporaries: the GEMM kernel evaluates each coefficient once, while packing it in its panels.
+     * Floating point products are accumulated in Acc if it is not void, for instance in double for float matrices.
+     *
+     * @tparam Acc accumulation type, or void for the common scalar type
+     * @tparam LHS left matrix type
+     * @tparam RHS right matrix type
+     * @param lhs left matrix
+     * @param rhs right matrix
+     * @return Matrix<T> with T being the common scalar type of the matrices
+     */
+    template <typename Acc = void, typename LHS, typename RHS>
     auto two_matrix_mult(LHS&& lhs, RHS&& rhs)
     {
         assert(lhs.cols() == rhs.rows() && "Matrix dimensions do not match for multiplication.");
 
         using T = LinAlg::CommonScalar<std::remove_cvref_t<LHS>, std::remove_cvref_t<RHS>>;
-        Matrix<T> res(lhs.rows(), rhs.cols());
+        Matrix<T> res(lhs.rows(), rhs.cols(), Common::uninitialized);
 
-        for (int i = 0; i < lhs.rows(); ++i)
-            for (int j = 0; j < rhs.cols(); ++j)
-            {
+        if (Kernels::matrix_vector_product<Acc>(lhs, rhs, Kernels::data_ptr(res)))
+            return res;
 
-                res[i, j] = lhs[i, 0] * rhs[0, j];
-                for (int k = 1; k < lhs.cols(); ++k)
-                    res[i, j] += lhs[i, k] * rhs[k, j];
-            }
+        if constexpr (std::is_floating_point_v<T>)
+            Kernels::gemm<Acc>(lhs.rows(), rhs.cols(), lhs.cols(), Kernels::make_operand(lhs), Kernels::make_operand(rhs), Kernels::data_ptr(res), res.cols());
+        else if constexpr (std::is_integral_v<T>)
+            Kernels::int_gemm(lhs.rows(), rhs.cols(), lhs.cols(), Kernels::make_operand(lhs), Kernels::make_operand(rhs), Kernels::data_ptr(res), res.cols());
+        else
+            _implementation_details::naive_two_matrix_mult(lhs, rhs, res);
+        return res;
+    }
+
+    /**
+     * @brief Multiplies two matrices whose dimensions are known at compile time, without allocation, with the inlined fixed size kernel
+     * (see Kernels::fixed_gemm). It is constexpr.
+     *
+     * Inner dimensions which differ do not compile. Expressions are evaluated first into a fixed size matrix on the stack.
+     *
+     * @tparam Acc accumulation type, or void for the common scalar type
+     * @tparam LHS left matrix type
+     * @tparam RHS right matrix type
+     * @param lhs left matrix
+     * @param rhs right matrix
+     * @return Matrix<T, M, N> with T being the common scalar type of the matrices, M the rows of lhs and N the columns of rhs
+     */
+    template <typename Acc = void, typename LHS, typename RHS>
+        requires Common::Concepts::FixedSizeProduct<LHS, RHS>
+    constexpr auto two_matrix_mult(LHS&& lhs, RHS&& rhs)
+    {
+        constexpr int M = Common::rows_at_compile_time<std::remove_cvref_t<LHS>>;
+        constexpr int K = Common::cols_at_compile_time<std::remove_cvref_t<LHS>>;
+        constexpr int N = Common::cols_at_compile_time<std::remove_cvref_t<RHS>>;
+        static_assert(K == Common::rows_at_compile_time<std::remove_cvref_t<RHS>>, "Matrix dimensions do not match for multiplication.");
 
+        using T = LinAlg::CommonScalar<std::remove_cvref_t<LHS>, std::remove_cvref_t<RHS>>;
+        if constexpr (!Kernels::Concepts::ContiguousMatrix<LHS>)
+            return two_matrix_mult<Acc>(Matrix<T, M, K>(lhs), std::forward<RHS>(rhs));
+        else if constexpr (!Kernels::Concepts::ContiguousMatrix<RHS>)
+            return two_matrix_mult<Acc>(std::forward<LHS>(lhs), Matrix<T, K, N>(rhs));
+        else
+        {
+            Matrix<T, M, N> res;
+            Kernels::fixed_gemm<M, N, K, Acc>(lhs.data().data(), rhs.data().data(), res.data().data());
+            return res;
+        }
+    }
+
+    /**
+     * @brief Multiplies two matrices, one of which at least is a Zero, Identity or Constant helper matrix, without a general product
+     * (see Common::structured_mult_into).
+     *
+     * @tparam Acc accumulation type, or void for the common scalar type
+     * @tparam LHS left matrix type
+     * @tparam RHS right matrix type
+     * @param lhs left matrix
+     * @param rhs right matrix
+     * @return Matrix<T> with T being the common scalar type of the matrices
+     */
+    template <typename Acc = void, typename LHS, typename RHS>
+        requires Common::Concepts::StructuredProduct<LHS, RHS>
+    auto two_matrix_mult(LHS&& lhs, RHS&& rhs)
+    {
+        using T = LinAlg::CommonScalar<std::remove_cvref_t<LHS>, std::remove_cvref_t<RHS>>;
+        Matrix<T> res(lhs.rows(), rhs.cols(), Common::uninitialized);
+        Common::structured_mult_into<Acc>(lhs, rhs, Kernels::data_ptr(res));
+        return res;
+    }
+
+    /**
+     * @brief Multiplies a sparse matrix with a dense matrix (or expression), in either order, with the sparse kernels (see Common::sparse_mult_into).
+     *
+     * Acc is ignored: the products are accumulated in the common scalar type.
+     *
+     * @tparam Acc ignored
+     * @tparam LHS left matrix type
+     * @tparam RHS right matrix type
+     * @param lhs left matrix
+     * @param rhs right matrix
+     * @return Matrix<T> with T being the common scalar type of the matrices
+     */
+    template <typename Acc = void, typename LHS, typename RHS>
+        requires Common::Concepts::SparseDenseProduct<LHS, RHS>
+    auto two_matrix_mult(LHS&& lhs, RHS&& rhs)
+    {
+        using T = LinAlg::CommonScalar<std::remove_cvref_t<LHS>, std::remove_cvref_t<RHS>>;
+        Matrix<T> res(lhs.rows(), rhs.cols(), Common::uninitialized);
+        Common::sparse_mult_into(lhs, rhs, Kernels::data_ptr(res));
+        return res;
+    }
+
+    /**
+     * @brief Multiplies two integer matrices and returns the result in a widened integer type.
+     *
+     * The products are accumulated in 32 bit for 8 bit and int16 matrices and in 64 bit otherwise, unsigned for unsigned matrices, or in Acc if it is wider.
+     * For instance, widening_mult<std::int64_t>(lhs, rhs) computes the exact product of two int16 matrices whatever their size.
+     *
+     * @tparam Acc scalar type of the result. By default, the accumulator type Kernels::widened_t of the common scalar type.
+     * @tparam LHS left matrix type
+     * @tparam RHS right matrix type
+     * @param lhs left matrix
+     * @param rhs right matrix
+     * @return Matrix<Acc>
+     */
+    template <typename Acc = void, typename LHS, typename RHS>
+    auto widening_mult(LHS&& lhs, RHS&& rhs)
+    {
+        assert(lhs.cols() == rhs.rows() && "Matrix dimensions do not match for multiplication.");
+
+        using T = LinAlg::CommonScalar<std::remove_cvref_t<LHS>, std::remove_cvref_t<RHS>>;
+        static_assert(std::is_integral_v<T>, "Widening multiplication is only available for integer matrices.");
+        using R = std::conditional_t<std::is_void_v<Acc>, Kernels::widened_t<T>, Acc>;
+
+        Matrix<R> res(lhs.rows(), rhs.cols(), Common::uninitialized);
+        Kernels::int_gemm(lhs.rows(), rhs.cols(), lhs.cols(), Kernels::make_operand(lhs), Kernels::make_operand(rhs), Kernels::data_ptr(res), res.cols());
+        return res;
+    }
+
+    /**
+     * @brief Multiplies two floating point matrices with the Strassen-Winograd algorithm.
+     *
+     * Opt-in alternative to mat_mult for large products: it needs fewer operations, at the cost of a slightly larger rounding error.
+     * Operands which are expressions, or whose scalar type differs from the result one, are evaluated first.
+     *
+     * @tparam LHS left matrix type
+     * @tparam RHS right matrix type
+     * @param lhs left matrix
+     * @param rhs right matrix
+     * @param cutoff size below which the standard product is used
+     * @return Matrix<T> with T being the common scalar type of the matrices
+     */
+    template <typename LHS, typename RHS>
+    auto strassen_mult(LHS&& lhs, RHS&& rhs, int cutoff = Kernels::strassen_default_cutoff)
+    {
+        assert(lhs.cols() == rhs.rows() && "Matrix dimensions do not match for multiplication.");
+
+        using T = LinAlg::CommonScalar<std::remove_cvref_t<LHS>, std::remove_cvref_t<RHS>>;
+        static_assert(std::is_floating_point_v<T>, "Strassen multiplication is only available for floating point matrices.");
+
+        if constexpr (!Kernels::Concepts::ContiguousMatrixOf<LHS, T>)
+            return strassen_mult(Matrix<T>(lhs), std::forward<RHS>(rhs), cutoff);
+        else if constexpr (!Kernels::Concepts::ContiguousMatrixOf<RHS, T>)
+            return strassen_mult(std::forward<LHS>(lhs), Matrix<T>(rhs), cutoff);
+        else
+        {
+            Matrix<T> res(lhs.rows(), rhs.cols(), Common::uninitialized);
+            Kernels::strassen(lhs.rows(), rhs.cols(), lhs.cols(), Kernels::data_ptr(lhs), Kernels::leading_dimension(lhs), Kernels::data_ptr(rhs),
+                              Kernels::leading_dimension(rhs), Kernels::data_ptr(res), res.cols(), cutoff);
+            return res;
+        }
+    }
+
+    /**
+     * @brief Computes the symmetric product A * A^T, or A^T * A if transpose_A is true, for instance a Gram or covariance matrix.
+     *
+     * Only one triangle is computed, which needs half the operations of mat_mult(A, transpose(A)); see Common::syrk_into.
+     * If mirror is false, the other triangle of the result is zero.
+     *
+     * @tparam Mat matrix type
+     * @param A matrix
+     * @param transpose_A if true, computes A^T * A instead of A * A^T
+     * @param uplo triangle to compute
+     * @param mirror if true, the computed triangle is copied into the other one
+     * @return Matrix<T> with T being the scalar type of A
+     */
+    template <typename Mat>
+    auto syrk(const Mat& A, bool transpose_A = false, Kernels::Triangle uplo = Kernels::Triangle::Lower, bool mirror = true)
+    {
+        using T = LinAlg::CommonScalar<Mat>;
+        const int n = transpose_A ? A.cols() : A.rows();
+        Matrix<T> res(n, n, Common::uninitialized);
+        if (!mirror)
+            std::fill_n(Kernels::data_ptr(res), static_cast<std::size_t>(n) * n, T(0));
+        Common::syrk_into(res, A, T(1), T(0), transpose_A, uplo, mirror);
         return res;
     }
 }
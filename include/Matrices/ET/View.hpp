@@ -0,0 +1,154 @@
+#pragma once
+
+#include <Matrices/Common/Base.hpp>
+#include <Matrices/ET/ForwardDeclarations.hpp>
+#include <Matrices/Kernels/Operands.hpp>
+#include <stdafx.hpp>
+
+namespace LinAlg::Matrices::ET
+{
+    namespace _implementation_details
+    {
+        /**
+         * @brief Adds the members returning views of the coefficients of Derived: block(), transpose(), row(), col() and diagonal().
+         *
+         * Derived is a matrix stored row-major or column-major (not Tiled), or a StridedView. The views of a const matrix are read-only.
+         *
+         * @tparam Derived matrix type
+         */
+        template <typename Derived>
+        class ViewFactory
+        {
+          public:
+            auto block(int i, int j, int rows, int cols) { return view(derived(), i, j, rows, cols); } ///< The rows x cols block starting at (i, j).
+            auto block(int i, int j, int rows, int cols) const { return view(derived(), i, j, rows, cols); }
+            auto row(int i) { return view(derived(), i, 0, 1, derived().cols()); } ///< The row i, as a 1 x cols matrix.
+            auto row(int i) const { return view(derived(), i, 0, 1, derived().cols()); }
+            auto col(int j) { return view(derived(), 0, j, derived().rows(), 1); } ///< The column j, as a rows x 1 matrix.
+            auto col(int j) const { return view(derived(), 0, j, derived().rows(), 1); }
+            auto transpose() { return transposed(derived()); } ///< The transpose, whose rows are the columns of the matrix.
+            auto transpose() const { return transposed(derived()); }
+            auto diagonal() { return diagonal_of(derived()); } ///< The diagonal, as a min(rows, cols) x 1 matrix.
+            auto diagonal() const { return diagonal_of(derived()); }
+
+          private:
+            Derived& derived() { return static_cast<Derived&>(*this); }
+            const Derived& derived() const { return static_cast<const Derived&>(*this); }
+
+            /// Returns the pointer to the first coefficient and the strides between the rows and the columns of mat, read-only if mat is const.
+            template <typename Mat>
+            static auto storage(Mat& mat)
+            {
+                if constexpr (requires { mat.row_stride(); })
+                {
+                    using Pointer = std::conditional_t<std::is_const_v<Mat>, const typename Mat::Scalar*, decltype(mat.data())>;
+                    return std::tuple(static_cast<Pointer>(mat.data()), mat.row_stride(), mat.col_stride());
+                }
+                else
+                {
+                    static_assert(Kernels::Concepts::ContiguousMatrix<Mat> || Kernels::Concepts::ColMajorMatrix<Mat>,
+                                  "Views need a matrix stored row-major or column-major.");
+                    const int ld = Kernels::leading_dimension(mat);
+                    if constexpr (Kernels::Concepts::ContiguousMatrix<Mat>)
+                        return std::tuple(std::ranges::data(mat.data()), ld, 1);
+                    else
+                        return std::tuple(std::ranges::data(mat.data()), 1, ld);
+                }
+            }
+
+            template <typename Mat>
+            static auto view(Mat& mat, int i, int j, int rows, int cols)
+            {
+                assert(i >= 0 && j >= 0 && rows >= 0 && cols >= 0 && i + rows <= mat.rows() && j + cols <= mat.cols() && "View out of the matrix.");
+                const auto [data, row_stride, col_stride] = storage(mat);
+                return StridedView(data + static_cast<std::ptrdiff_t>(i) * row_stride + static_cast<std::ptrdiff_t>(j) * col_stride, rows, cols, row_stride, col_stride);
+            }
+
+            template <typename Mat>
+            static auto transposed(Mat& mat)
+            {
+                const auto [data, row_stride, col_stride] = storage(mat);
+                return StridedView(data, mat.cols(), mat.rows(), col_stride, row_stride);
+            }
+
+            template <typename Mat>
+            static auto diagonal_of(Mat& mat)
+            {
+                const auto [data, row_stride, col_stride] = storage(mat);
+                return StridedView(data, std::min(mat.rows(), mat.cols()), 1, row_stride + col_stride, 1);
+            }
+        };
+    }
+
+    /**
+     * @brief A non-owning view of coefficients of a matrix, such as a block, the transpose, a row, a column or the diagonal (see ViewFactory).
+     *
+     * It stores a pointer to the first coefficient and the strides between two rows and two columns, hence it never allocates. It takes part
+     * in the expressions and the products like a Matrix, and the kernels read it in place (see Kernels::make_operand). If T is not const,
+     * it can be written to: assigning a matrix or an expression to a view writes its coefficients into the viewed matrix.
+     *
+     * The view is invalidated with the storage of the matrix. As the expressions are evaluated coefficient by coefficient, the right hand side
+     * of an assignment must not read coefficients it overwrites, as in m = m.transpose(): evaluate it first with Matrix(m.transpose()).
+     *
+     * @tparam T scalar type, const for a read-only view
+     */
+    template <typename T>
+    class StridedView : public MatrixBase<StridedView<T>>, public _implementation_details::ViewFactory<StridedView<T>>
+    {
+      public:
+        using Scalar = std::remove_const_t<T>;
+
+        StridedView(T* data, int rows, int cols, int row_stride, int col_stride)
+            : MatrixBase<StridedView>(rows, cols)
+            , m_data(data)
+            , m_row_stride(row_stride)
+            , m_col_stride(col_stride)
+        {
+        }
+
+        StridedView(const StridedView&) = default;
+        StridedView(StridedView&&) noexcept = default;
+
+        StridedView& operator=(const StridedView& other) ///< Copies the coefficients viewed by other into the ones of this view.
+        {
+            return *this = static_cast<const MatrixBase<StridedView>&>(other);
+        }
+
+        template <typename OtherDerived>
+        StridedView& operator=(const MatrixBase<OtherDerived>& other) ///< Writes the coefficients of a matrix or an expression into the viewed ones.
+        {
+            static_assert(!std::is_const_v<T>, "Cannot assign to a read-only view.");
+            assert(other.rows() == this->m_rows && other.cols() == this->m_cols && "Matrix dimensions do not match for assignment.");
+            const OtherDerived& derived = static_cast<const OtherDerived&>(other);
+            // The inner loop runs along the smallest stride.
+            if (m_col_stride <= m_row_stride)
+                for (int i = 0; i < this->m_rows; ++i)
+                    for (int j = 0; j < this->m_cols; ++j)
+                        (*this)[i, j] = derived[i, j];
+            else
+                for (int j = 0; j < this->m_cols; ++j)
+                    for (int i = 0; i < this->m_rows; ++i)
+                        (*this)[i, j] = derived[i, j];
+            return *this;
+        }
+
+        T& operator[](int i, int j) const { return m_data[static_cast<std::ptrdiff_t>(i) * m_row_stride + static_cast<std::ptrdiff_t>(j) * m_col_stride]; }
+        T& operator[](int i) const { return (*this)[i / this->m_cols, i % this->m_cols]; } ///< Access the element i in the flattened view.
+
+        T* data() const { return m_data; }                 ///< Returns a pointer to the first coefficient.
+        int row_stride() const { return m_row_stride; }    ///< Returns the distance between two consecutive rows.
+        int col_stride() const { return m_col_stride; }    ///< Returns the distance between two consecutive columns.
+        /// Returns whether the flattened coefficient i is not data()[i], i.e. the view is not a whole row-major matrix.
+        bool is_padded() const { return m_col_stride != 1 || (m_row_stride != this->m_cols && this->m_rows > 1); }
+
+        Matrix<Scalar> eval() const { return Matrix<Scalar>(*this); } ///< Copies the viewed coefficients into a Matrix.
+
+      private:
+        T* m_data;
+        int m_row_stride;
+        int m_col_stride;
+    };
+
+    template <typename T>
+    StridedView(T*, int, int, int, int) -> StridedView<T>;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <Matrices/Kernels/Dispatch.hpp>
+#include <Matrices/Kernels/Operands.hpp>
+#include <stdafx.hpp>
+
+namespace LinAlg::Matrices::Kernels
+{
+    namespace _implementation_details
+    {
+        /**
+         * @brief The dense evaluation loop into a matrix stored in Layout, dispatched on the instruction set by assign().
+         */
+        template <typename Layout>
+        struct Assign
+        {
+            template <typename Cont, typename Other>
+            static void run(Cont& data, const Other& other, int rows, int cols, int ld)
+            {
+                if constexpr (requires { std::ranges::data(data); })
+                    run_on(std::ranges::data(data), other, rows, cols, ld);
+                else
+                    run_on(data, other, rows, cols, ld);
+            }
+
+            template <typename Out, typename Other>
+            static void run_on(Out&& out, const Other& other, int rows, int cols, int ld)
+            {
+                if constexpr (Layout::is_row_major && is_row_major<Other>)
+                {
+                    if (ld == cols && !is_padded(other))
+                        for (int i = 0; i < rows * cols; ++i)
+                            out[i] = unpadded_coeff(other, i);
+                    else
+                        for (int i = 0; i < rows; ++i)
+                            for (int j = 0; j < cols; ++j)
+                                out[i * ld + j] = other[i, j];
+                }
+                else
+                    run_blocked(out, other, rows, cols, ld);
+            }
+
+            /**
+             * @brief Evaluates other by square blocks, column by column inside a block, when other or the output is not row-major.
+             *
+             * Column-major data is then read or written contiguously, while the rows of a row-major one stay in cache from a column of the block
+             * to the next: converting a matrix between layouts is a blocked transposition.
+             */
+            template <typename Out, typename Other>
+            static void run_blocked(Out&& out, const Other& other, int rows, int cols, int ld)
+            {
+                constexpr int block = 32;
+                for (int i0 = 0; i0 < rows; i0 += block)
+                    for (int j0 = 0; j0 < cols; j0 += block)
+                    {
+                        const int i1 = std::min(i0 + block, rows);
+                        const int j1 = std::min(j0 + block, cols);
+                        for (int j = j0; j < j1; ++j)
+                            for (int i = i0; i < i1; ++i)
+                                out[Layout::index(i, j, ld)] = other[i, j];
+                    }
+            }
+        };
+    }
+
+    /**
+     * @brief Writes the coefficients of the matrix (or expression) other into data, which stores a rows x cols matrix in Layout with leading dimension ld.
+     *
+     * The loop, together with the inlined evaluation of the expression, is compiled for several instruction sets and the one selected by active_isa() is run.
+     * Between row-major matrices, if neither data nor the matrices of other are padded, they are processed as flattened matrices, else row by row.
+     * If data or other is not row-major, they are processed by blocks (see Assign::run_blocked).
+     *
+     * @tparam Layout layout of data, see Common::RowMajor
+     * @tparam Cont container type
+     * @tparam Other matrix or expression type
+     * @param data container to write to
+     * @param other matrix or expression to evaluate
+     * @param rows number of rows
+     * @param cols number of columns
+     * @param ld leading dimension of data
+     */
+    template <typename Layout, typename Cont, typename Other>
+    void assign(Cont& data, const Other& other, int rows, int cols, int ld)
+    {
+        dispatch<_implementation_details::Assign<Layout>>(data, other, rows, cols, ld);
+    }
+}
@@ -0,0 +1,277 @@
+#pragma once
+
+#include <Matrices/Kernels/Dispatch.hpp>
+#include <Matrices/Kernels/Gemm.hpp>
+#include <Matrices/Kernels/ThreadPool.hpp>
+#include <stdafx.hpp>
+
+namespace LinAlg::Matrices::Kernels
+{
+    /**
+     * @brief Storage of a batch of same-shape row-major matrices.
+     */
+    enum class BatchLayout
+    {
+        Contiguous, ///< The matrices are stored one after the other.
+        Interleaved ///< The matrices are stored by groups of batch_lanes, element (i, j) of the matrices of a group being contiguous.
+    };
+
+    /**
+     * @brief Number of matrices in a group of an interleaved batch: one cache line, hence one or a few vector registers, per element.
+     */
+    template <typename T>
+    inline constexpr int batch_lanes = std::max<int>(1, 64 / sizeof(T));
+
+    /**
+     * @brief Largest square size for which the batched product has an unrolled kernel. Larger or rectangular matrices use a generic kernel.
+     */
+    inline constexpr int batched_max_unrolled_size = 16;
+
+    /**
+     * @brief Returns the number of elements needed to store a batch of rows x cols matrices with the given layout.
+     *
+     * Interleaved batches are padded to a whole number of groups.
+     */
+    template <typename T>
+    std::size_t batched_size(int rows, int cols, std::size_t batch, BatchLayout layout)
+    {
+        if (layout == BatchLayout::Interleaved)
+            batch = (batch + batch_lanes<T> - 1) / batch_lanes<T> * batch_lanes<T>;
+        return batch * static_cast<std::size_t>(rows) * cols;
+    }
+
+    /**
+     * @brief Returns the index of the element (i, j) of the matrix b in an interleaved batch of rows x cols matrices.
+     */
+    template <typename T>
+    std::size_t interleaved_index(int rows, int cols, std::size_t b, int i, int j)
+    {
+        constexpr std::size_t W = batch_lanes<T>;
+        return (b / W) * W * rows * cols + (static_cast<std::size_t>(i) * cols + j) * W + b % W;
+    }
+
+    /**
+     * @brief Converts a contiguous batch of rows x cols matrices into an interleaved one. The padding matrices of dst are set to zero.
+     */
+    template <typename T>
+    void interleave(int rows, int cols, std::size_t batch, const T* src, T* dst)
+    {
+        std::fill(dst, dst + batched_size<T>(rows, cols, batch, BatchLayout::Interleaved), T(0));
+        const std::size_t size = static_cast<std::size_t>(rows) * cols;
+        for (std::size_t b = 0; b < batch; ++b)
+            for (int i = 0; i < rows; ++i)
+                for (int j = 0; j < cols; ++j)
+                    dst[interleaved_index<T>(rows, cols, b, i, j)] = src[b * size + static_cast<std::size_t>(i) * cols + j];
+    }
+
+    /**
+     * @brief Converts an interleaved batch of rows x cols matrices into a contiguous one.
+     */
+    template <typename T>
+    void deinterleave(int rows, int cols, std::size_t batch, const T* src, T* dst)
+    {
+        const std::size_t size = static_cast<std::size_t>(rows) * cols;
+        for (std::size_t b = 0; b < batch; ++b)
+            for (int i = 0; i < rows; ++i)
+                for (int j = 0; j < cols; ++j)
+                    dst[b * size + static_cast<std::size_t>(i) * cols + j] = src[interleaved_index<T>(rows, cols, b, i, j)];
+    }
+
+    namespace _implementation_details
+    {
+        /**
+         * @brief Sizes of the batched product, either known at compile time (S > 0, square S x S matrices) or at runtime (S == 0).
+         */
+        template <int S>
+        struct BatchedShape
+        {
+            static constexpr int m = S;
+            static constexpr int n = S;
+            static constexpr int k = S;
+        };
+
+        template <>
+        struct BatchedShape<0>
+        {
+            int m;
+            int n;
+            int k;
+        };
+
+        /**
+         * @brief Computes the batch_lanes products of an interleaved group. Each element operation is applied to the matrices of the group at once,
+         * hence it vectorizes whatever the size of the matrices. Columns of the result are computed by 4, to reuse the loaded elements of A.
+         */
+        template <typename T, int S>
+        void interleaved_group_product(BatchedShape<S> shape, const T* __restrict a, const T* __restrict b, T* __restrict c)
+        {
+            constexpr int W = batch_lanes<T>;
+            constexpr int NJ = 4;
+            const int m = shape.m;
+            const int n = shape.n;
+            const int k = shape.k;
+
+            for (int i = 0; i < m; ++i)
+            {
+                int j0 = 0;
+                for (; j0 + NJ <= n; j0 += NJ)
+                {
+                    T acc[NJ][W] = {};
+                    for (int p = 0; p < k; ++p)
+                    {
+                        const T* a_ip = a + (i * k + p) * W;
+                        for (int jj = 0; jj < NJ; ++jj)
+                            for (int l = 0; l < W; ++l)
+                                acc[jj][l] += a_ip[l] * b[(p * n + j0 + jj) * W + l];
+                    }
+                    for (int jj = 0; jj < NJ; ++jj)
+                        std::copy(acc[jj], acc[jj] + W, c + (i * n + j0 + jj) * W);
+                }
+                for (; j0 < n; ++j0)
+                {
+                    T acc[W] = {};
+                    for (int p = 0; p < k; ++p)
+                        for (int l = 0; l < W; ++l)
+                            acc[l] += a[(i * k + p) * W + l] * b[(p * n + j0) * W + l];
+                    std::copy(acc, acc + W, c + (i * n + j0) * W);
+                }
+            }
+        }
+
+        /**
+         * @brief Products of the groups [g0, g1) of interleaved batches.
+         */
+        template <int S>
+        struct BatchedGemmInterleaved
+        {
+            template <typename T>
+            static void run(BatchedShape<S> shape, std::size_t g0, std::size_t g1, const T* A, const T* B, T* C)
+            {
+                constexpr std::size_t W = batch_lanes<T>;
+                const std::size_t size_A = W * shape.m * shape.k;
+                const std::size_t size_B = W * shape.k * shape.n;
+                const std::size_t size_C = W * shape.m * shape.n;
+                for (std::size_t g = g0; g < g1; ++g)
+                    interleaved_group_product(shape, A + g * size_A, B + g * size_B, C + g * size_C);
+            }
+        };
+
+        /**
+         * @brief Products of the matrices [b0, b1) of contiguous batches.
+         *
+         * Compilers do not vectorize the unrolled product of a single small matrix well, hence the matrices are interleaved by groups of
+         * batch_lanes into packing buffers, multiplied with the interleaved kernel, and the results are scattered back.
+         */
+        template <int S>
+        struct BatchedGemmContiguous
+        {
+            template <typename T>
+            static void run(BatchedShape<S> shape, std::size_t b0, std::size_t b1, const T* A, const T* B, T* C)
+            {
+                constexpr std::size_t W = batch_lanes<T>;
+                const std::size_t size_A = static_cast<std::size_t>(shape.m) * shape.k;
+                const std::size_t size_B = static_cast<std::size_t>(shape.k) * shape.n;
+                const std::size_t size_C = static_cast<std::size_t>(shape.m) * shape.n;
+                T* packed_A = packing_buffer<T, 0>(W * size_A);
+                T* packed_B = packing_buffer<T, 1>(W * size_B);
+                T* packed_C = packing_buffer<T, 2>(W * size_C);
+
+                const auto pack = [](const T* __restrict src, std::size_t size, std::size_t lanes, T* __restrict dst)
+                {
+                    if (lanes < W)
+                        std::fill(dst, dst + size * W, T(0));
+                    for (std::size_t e = 0; e < size; ++e)
+                        for (std::size_t l = 0; l < lanes; ++l)
+                            dst[e * W + l] = src[l * size + e];
+                };
+
+                for (std::size_t b = b0; b < b1; b += W)
+                {
+                    const std::size_t lanes = std::min(W, b1 - b);
+                    pack(A + b * size_A, size_A, lanes, packed_A);
+                    pack(B + b * size_B, size_B, lanes, packed_B);
+                    interleaved_group_product(shape, packed_A, packed_B, packed_C);
+
+                    T* __restrict c = C + b * size_C;
+                    for (std::size_t l = 0; l < lanes; ++l)
+                        for (std::size_t e = 0; e < size_C; ++e)
+                            c[l * size_C + e] = packed_C[e * W + l];
+                }
+            }
+        };
+
+        /**
+         * @brief Runs Kernel<S> on the matrices (or groups) [0, count), split in chunks on the thread pool if the batch is large enough.
+         */
+        template <template <int> class Kernel, int S, typename T>
+        void run_batched(BatchedShape<S> shape, std::size_t count, std::size_t flops_per_item, const T* A, const T* B, T* C)
+        {
+            // Chunks of at least 2^16 multiply-adds amortize the scheduling of the tasks.
+            const std::size_t min_chunk = std::max<std::size_t>(1, (std::size_t(1) << 16) / std::max<std::size_t>(flops_per_item, 1));
+            const std::size_t n_tasks = std::min<std::size_t>((count + min_chunk - 1) / min_chunk, 8 * static_cast<std::size_t>(num_threads()));
+            if (num_threads() <= 1 || n_tasks < 2)
+            {
+                dispatch<Kernel<S>>(shape, std::size_t(0), count, A, B, C);
+                return;
+            }
+
+            const std::size_t per_task = (count + n_tasks - 1) / n_tasks;
+            parallel_for(static_cast<int>(n_tasks),
+                         [&](int task)
+                         {
+                             const std::size_t first = std::min(count, task * per_task);
+                             dispatch<Kernel<S>>(shape, first, std::min(count, first + per_task), A, B, C);
+                         });
+        }
+
+        /**
+         * @brief Selects the unrolled kernel of size S + 1 if m == n == k == S + 1, the generic one otherwise.
+         */
+        template <template <int> class Kernel, typename T, int... S>
+        void run_batched_sizes(std::integer_sequence<int, S...>, int m, int n, int k, std::size_t count, std::size_t flops_per_item, const T* A,
+                               const T* B, T* C)
+        {
+            const bool unrolled =
+                (m == n && n == k) && ((m == S + 1 && (run_batched<Kernel, S + 1>(BatchedShape<S + 1> {}, count, flops_per_item, A, B, C), true)) || ...);
+            if (!unrolled)
+                run_batched<Kernel, 0>(BatchedShape<0> { m, n, k }, count, flops_per_item, A, B, C);
+        }
+    }
+
+    /**
+     * @brief Computes the products C[b] = A[b] * B[b] of a batch of small row-major matrices.
+     *
+     * The batch is meant for many independent tiny products (typically 2 x 2 to 16 x 16), for which the per-call overhead of mat_mult,
+     * and the allocation of its result, cost more than the arithmetic. Square matrices up to batched_max_unrolled_size have kernels with
+     * compile-time sizes. batch_lanes products are computed at once, one per vector lane. With the interleaved layout the operands are read
+     * in place; with the contiguous layout they are interleaved group by group into packing buffers first, which costs some extra memory accesses.
+     * The batch is split in chunks on the thread pool, and the kernels are compiled for several instruction sets, the one selected by active_isa()
+     * being run.
+     *
+     * @tparam T scalar type
+     * @param m number of rows of the matrices of A and C
+     * @param n number of columns of the matrices of B and C
+     * @param k number of columns of the matrices of A and rows of the matrices of B
+     * @param batch number of products
+     * @param A left matrices, with batched_size<T>(m, k, batch, layout) elements
+     * @param B right matrices, with batched_size<T>(k, n, batch, layout) elements
+     * @param C result matrices, with batched_size<T>(m, n, batch, layout) elements. It must not overlap with A or B.
+     * @param layout layout of A, B and C
+     */
+    template <typename T>
+    void batched_gemm(int m, int n, int k, std::size_t batch, const T* A, const T* B, T* C, BatchLayout layout = BatchLayout::Contiguous)
+    {
+        if (batch == 0 || m <= 0 || n <= 0)
+            return;
+
+        const std::size_t flops = static_cast<std::size_t>(m) * n * std::max(k, 1);
+        const auto sizes = std::make_integer_sequence<int, batched_max_unrolled_size> {};
+        if (layout == BatchLayout::Interleaved)
+        {
+            constexpr std::size_t W = batch_lanes<T>;
+            _implementation_details::run_batched_sizes<_implementation_details::BatchedGemmInterleaved>(sizes, m, n, k, (batch + W - 1) / W, W * flops, A, B, C);
+        }
+        else
+            _implementation_details::run_batched_sizes<_implementation_details::BatchedGemmContiguous>(sizes, m, n, k, batch, flops, A, B, C);
+    }
+}
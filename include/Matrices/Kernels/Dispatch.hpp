@@ -0,0 +1,177 @@
+#pragma once
+
+#include <stdafx.hpp>
+
+/*
+    The hot kernels are compiled once per instruction set through the target attribute, and the variant is selected at runtime from CPUID.
+    Functions carrying these attributes are flattened, so that the whole kernel (loops, inlined expressions, micro-kernels) is code generated
+    for the given instruction set.
+*/
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define LINALG_ISA_DISPATCH 1
+#define LINALG_TARGET_SSE4 [[gnu::target("sse4.2"), gnu::flatten]]
+#define LINALG_TARGET_AVX2 [[gnu::target("avx2,fma"), gnu::flatten]]
+#define LINALG_TARGET_AVX512 [[gnu::target("avx512f,avx512vl,avx512bw,avx512dq,avx2,fma"), gnu::flatten]]
+#define LINALG_TARGET_AVX512VNNI [[gnu::target("avx512f,avx512vl,avx512bw,avx512dq,avx512vnni,avx2,fma"), gnu::flatten]]
+#else
+#define LINALG_ISA_DISPATCH 0
+#endif
+
+namespace LinAlg::Matrices::Kernels
+{
+    /**
+     * @brief The instruction sets for which the kernels are compiled. They are ordered, each one being a superset of the previous ones.
+     */
+    enum class ISA
+    {
+        Generic,
+        SSE4,
+        AVX2,
+        AVX512,
+        AVX512VNNI ///< AVX512 with the integer dot product instructions.
+    };
+
+    /**
+     * @brief Returns the name of the instruction set, as accepted by the LINALG_ISA environment variable.
+     */
+    inline const char* isa_name(ISA isa)
+    {
+        switch (isa)
+        {
+        case ISA::SSE4:
+            return "sse4";
+        case ISA::AVX2:
+            return "avx2";
+        case ISA::AVX512:
+            return "avx512";
+        case ISA::AVX512VNNI:
+            return "avx512vnni";
+        default:
+            return "generic";
+        }
+    }
+
+    /**
+     * @brief Parses an instruction set name. Returns std::nullopt for unknown names.
+     */
+    inline std::optional<ISA> parse_isa(std::string_view name)
+    {
+        for (ISA isa : { ISA::Generic, ISA::SSE4, ISA::AVX2, ISA::AVX512, ISA::AVX512VNNI })
+            if (name == isa_name(isa))
+                return isa;
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Returns the best instruction set supported by the CPU.
+     */
+    inline ISA detect_isa()
+    {
+#if LINALG_ISA_DISPATCH
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl") && __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512dq"))
+            return __builtin_cpu_supports("avx512vnni") ? ISA::AVX512VNNI : ISA::AVX512;
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+            return ISA::AVX2;
+        if (__builtin_cpu_supports("sse4.2"))
+            return ISA::SSE4;
+#endif
+        return ISA::Generic;
+    }
+
+    namespace _implementation_details
+    {
+        inline std::atomic<ISA>& isa_state()
+        {
+            static std::atomic<ISA> isa = []
+            {
+                ISA detected = detect_isa();
+                if (const char* env = std::getenv("LINALG_ISA"))
+                    if (auto forced = parse_isa(env))
+                        return std::min(*forced, detected);
+                return detected;
+            }();
+            return isa;
+        }
+    }
+
+    /**
+     * @brief Returns the instruction set used by the kernels.
+     *
+     * It is selected once, at the first call, as the best one supported by the CPU. The LINALG_ISA environment variable (generic, sse4, avx2, avx512, avx512vnni)
+     * forces a lower instruction set, which is useful to benchmark the variants against each other.
+     */
+    inline ISA active_isa()
+    {
+        return _implementation_details::isa_state().load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Forces the instruction set used by the kernels. Instruction sets not supported by the CPU are lowered to the best supported one.
+     *
+     * @return the instruction set actually selected
+     */
+    inline ISA set_isa(ISA isa)
+    {
+        isa = std::min(isa, detect_isa());
+        _implementation_details::isa_state().store(isa, std::memory_order_relaxed);
+        return isa;
+    }
+
+    namespace _implementation_details
+    {
+#if LINALG_ISA_DISPATCH
+        template <typename Impl, typename... Args>
+        LINALG_TARGET_SSE4 void run_sse4(Args&&... args)
+        {
+            Impl::run(std::forward<Args>(args)...);
+        }
+
+        template <typename Impl, typename... Args>
+        LINALG_TARGET_AVX2 void run_avx2(Args&&... args)
+        {
+            Impl::run(std::forward<Args>(args)...);
+        }
+
+        template <typename Impl, typename... Args>
+        LINALG_TARGET_AVX512 void run_avx512(Args&&... args)
+        {
+            Impl::run(std::forward<Args>(args)...);
+        }
+
+        template <typename Impl, typename... Args>
+        LINALG_TARGET_AVX512VNNI void run_avx512vnni(Args&&... args)
+        {
+            Impl::run(std::forward<Args>(args)...);
+        }
+#endif
+    }
+
+    /**
+     * @brief Runs Impl::run(args...) compiled for the active instruction set.
+     *
+     * @tparam Impl a type with a static run method implementing the kernel
+     * @tparam Args argument types
+     * @param args arguments forwarded to Impl::run
+     */
+    template <typename Impl, typename... Args>
+    void dispatch(Args&&... args)
+    {
+#if LINALG_ISA_DISPATCH
+        switch (active_isa())
+        {
+        case ISA::AVX512VNNI:
+            return _implementation_details::run_avx512vnni<Impl>(std::forward<Args>(args)...);
+        case ISA::AVX512:
+            return _implementation_details::run_avx512<Impl>(std::forward<Args>(args)...);
+        case ISA::AVX2:
+            return _implementation_details::run_avx2<Impl>(std::forward<Args>(args)...);
+        case ISA::SSE4:
+            return _implementation_details::run_sse4<Impl>(std::forward<Args>(args)...);
+        default:
+            break;
+        }
+#endif
+        Impl::run(std::forward<Args>(args)...);
+    }
+}
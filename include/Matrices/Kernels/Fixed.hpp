@@ -0,0 +1,97 @@
+#pragma once
+
+#include <Matrices/Kernels/Dispatch.hpp>
+#include <stdafx.hpp>
+
+namespace LinAlg::Matrices::Kernels
+{
+    /**
+     * @brief Number of multiply-adds from which fixed_gemm() runs the kernel compiled for the active instruction set instead of inlining it.
+     * Below, the dispatch costs more than the wider instructions save.
+     */
+    inline constexpr int fixed_gemm_dispatch_size = 8 * 8 * 8;
+
+    namespace _implementation_details
+    {
+        /**
+         * @brief Computes the TM x TN tile of C whose first coefficient is C[0], from the transposed rows of A and the columns of B it needs.
+         * The tile is accumulated in registers, as in the micro-kernel of gemm().
+         */
+        template <int M, int N, int K, int TM, int TN, typename S, typename V, typename T>
+        constexpr void fixed_tile(const S* a_t, const V* B, T* C)
+        {
+            S acc[TM][TN] = {};
+            for (int p = 0; p < K; ++p)
+                for (int i = 0; i < TM; ++i)
+                    for (int j = 0; j < TN; ++j)
+                        acc[i][j] += a_t[p * M + i] * static_cast<S>(B[p * N + j]);
+
+            for (int i = 0; i < TM; ++i)
+                for (int j = 0; j < TN; ++j)
+                    C[i * N + j] = static_cast<T>(acc[i][j]);
+        }
+
+        /**
+         * @brief The product of fixed_gemm(), split in tiles of at most MR x NR coefficients whose sizes are all known at compile time.
+         *
+         * A is first copied transposed, as the A panels of gemm(): its rows are contiguous along the inner dimension, and read as they are,
+         * GCC vectorizes the fully unrolled product along it and spends its time shuffling the coefficients.
+         */
+        template <int M, int N, int K, typename Acc>
+        struct FixedGemm
+        {
+            template <typename U, typename V, typename T>
+            static constexpr void run(const U* A, const V* B, T* C)
+            {
+                using S = std::conditional_t<std::is_void_v<Acc>, T, Acc>;
+                constexpr int MR = std::min(M, 4);
+                constexpr int NR = std::min<int>(N, std::max<int>(1, 64 / sizeof(S)));
+
+                S a_t[K * M];
+                for (int i = 0; i < M; ++i)
+                    for (int p = 0; p < K; ++p)
+                        a_t[p * M + i] = static_cast<S>(A[i * K + p]);
+
+                // Every tile has its offsets and sizes known at compile time, the last ones are narrower if M or N is not a multiple of MR or NR.
+                constexpr int m_tiles = (M + MR - 1) / MR;
+                constexpr int n_tiles = (N + NR - 1) / NR;
+                [&]<int... I>(std::integer_sequence<int, I...>)
+                {
+                    (
+                        [&]<int... J>(std::integer_sequence<int, J...>)
+                        {
+                            constexpr int i0 = I * MR;
+                            (fixed_tile<M, N, K, std::min(MR, M - i0), std::min(NR, N - J * NR)>(a_t + i0, B + J * NR, C + i0 * N + J * NR), ...);
+                        }(std::make_integer_sequence<int, n_tiles> {}),
+                        ...);
+                }(std::make_integer_sequence<int, m_tiles> {});
+            }
+        };
+    }
+
+    /**
+     * @brief Computes the product C = A * B of row-major matrices whose dimensions are known at compile time.
+     *
+     * Meant for the fixed size matrices, typically 2 x 2 to 16 x 16, for which the packing and the blocking of gemm() do not pay off.
+     * All the loops have compile-time trip counts and are unrolled by the compiler. Small products are inlined at the call site, larger ones
+     * (from fixed_gemm_dispatch_size multiply-adds) run the kernel compiled for the active instruction set. It is constexpr,
+     * hence products can be computed at compile time.
+     *
+     * @tparam M number of rows of A and C
+     * @tparam N number of columns of B and C
+     * @tparam K number of columns of A and rows of B
+     * @tparam Acc accumulation type, or void for the scalar type of C
+     * @param A pointer to the M x K coefficients of A
+     * @param B pointer to the K x N coefficients of B
+     * @param C pointer to the M x N coefficients of C. It must not overlap with A or B.
+     */
+    template <int M, int N, int K, typename Acc = void, typename T, typename U, typename V>
+    constexpr void fixed_gemm(const U* A, const V* B, T* C)
+    {
+        using Impl = _implementation_details::FixedGemm<M, N, K, Acc>;
+        if (std::is_constant_evaluated() || M * N * K < fixed_gemm_dispatch_size)
+            Impl::run(A, B, C);
+        else
+            dispatch<Impl>(A, B, C);
+    }
+}
@@ -0,0 +1,368 @@
+#pragma once
+
+#include <Matrices/Kernels/Dispatch.hpp>
+#include <Matrices/Kernels/Operands.hpp>
+#include <Matrices/Kernels/ThreadPool.hpp>
+#include <stdafx.hpp>
+
+namespace LinAlg::Matrices::Kernels
+{
+    /**
+     * @brief Cache blocking parameters of the GEMM kernel.
+     *
+     * The micro-kernel keeps an MR x NR tile of the result in registers. A KC x NR sliver of the packed B panel is meant to stay in L1,
+     * the packed MC x KC block of A in L2 and the packed KC x NC panel of B in L3.
+     *
+     * @tparam T scalar type
+     */
+    template <typename T>
+    struct BlockSizes
+    {
+        static constexpr int MR = 4;
+        /// One cache line of B per step of the micro-kernel, two for types smaller than 8 bytes: with a single line, GCC vectorizes the float
+        /// micro-kernel across steps of the inner dimension and spills the tile to the stack, which is about 5 times slower.
+        static constexpr int NR = (sizeof(T) < 8 ? 128 : 64) / sizeof(T);
+        static constexpr int KC = 256;
+        static constexpr int MC = 128;
+        static constexpr int NC = 2048;
+    };
+
+    /**
+     * @brief Returns true if the problem is large enough for packing to pay off.
+     */
+    inline bool gemm_is_profitable(int m, int n, int k)
+    {
+        return static_cast<long long>(m) * n * k >= 16 * 16 * 16;
+    }
+
+    /**
+     * @brief Returns true if the problem is large enough to be split across threads.
+     */
+    inline bool gemm_is_parallel(int m, int n, int k)
+    {
+        return num_threads() > 1 && static_cast<long long>(m) * n * k >= 128 * 128 * 128;
+    }
+
+    namespace _implementation_details
+    {
+        /**
+         * @brief Packs the mc x kc block of A starting at (i0, p0) into row panels of height MR.
+         *
+         * Inside a panel the elements are stored column after column, so that the micro-kernel reads MR contiguous values per step.
+         * Rows beyond mc are padded with zeros.
+         */
+        template <typename T, int MR, typename OpA>
+        void pack_A(int mc, int kc, const OpA& A, int i0, int p0, T* packed)
+        {
+            for (int ir = 0; ir < mc; ir += MR)
+            {
+                const int mr = std::min(MR, mc - ir);
+                for (int p = 0; p < kc; ++p)
+                {
+                    for (int i = 0; i < mr; ++i)
+                        packed[i] = static_cast<T>(A(i0 + ir + i, p0 + p));
+                    for (int i = mr; i < MR; ++i)
+                        packed[i] = T(0);
+                    packed += MR;
+                }
+            }
+        }
+
+        /**
+         * @brief Packs the kc x nc panel of B starting at (p0, j0) into column panels of width NR.
+         *
+         * Inside a panel the elements are stored row after row, so that the micro-kernel reads NR contiguous values per step.
+         * Columns beyond nc are padded with zeros.
+         */
+        template <typename T, int NR, typename OpB>
+        void pack_B(int kc, int nc, const OpB& B, int p0, int j0, T* packed)
+        {
+            for (int jr = 0; jr < nc; jr += NR)
+            {
+                const int nr = std::min(NR, nc - jr);
+                for (int p = 0; p < kc; ++p)
+                {
+                    for (int j = 0; j < nr; ++j)
+                        packed[j] = static_cast<T>(B(p0 + p, j0 + jr + j));
+                    for (int j = nr; j < NR; ++j)
+                        packed[j] = T(0);
+                    packed += NR;
+                }
+            }
+        }
+
+        /**
+         * @brief Computes an MR x NR tile of A*B from packed panels and stores alpha * A*B + beta * C in C.
+         *
+         * The full tile is always computed on the zero padded panels, only the mr x nr valid part is written back.
+         * If beta is zero, C is not read, so that it may hold uninitialized values.
+         * The tile is accumulated in the type T of the panels, and converted to the type R of C when written back.
+         */
+        template <typename T, int MR, int NR, typename R>
+        void micro_kernel(int kc, const T* __restrict a, const T* __restrict b, R* __restrict c, int ldc, int mr, int nr, T alpha, T beta)
+        {
+            T acc[MR][NR] = {};
+            for (int p = 0; p < kc; ++p)
+            {
+                for (int i = 0; i < MR; ++i)
+                    for (int j = 0; j < NR; ++j)
+                        acc[i][j] += a[i] * b[j];
+                a += MR;
+                b += NR;
+            }
+
+            for (int i = 0; i < mr; ++i)
+            {
+                R* c_row = c + static_cast<std::ptrdiff_t>(i) * ldc;
+                if (beta == T(0))
+                    for (int j = 0; j < nr; ++j)
+                        c_row[j] = static_cast<R>(alpha * acc[i][j]);
+                else if (beta == T(1))
+                    for (int j = 0; j < nr; ++j)
+                        c_row[j] = static_cast<R>(c_row[j] + alpha * acc[i][j]);
+                else
+                    for (int j = 0; j < nr; ++j)
+                        c_row[j] = static_cast<R>(beta * c_row[j] + alpha * acc[i][j]);
+            }
+        }
+
+        /**
+         * @brief Multiplies a packed mc x kc block of A with a packed kc x nc panel of B, looping over the micro-tiles.
+         */
+        template <typename T, int MR, int NR, typename R>
+        void macro_kernel(int mc, int nc, int kc, const T* packed_A, const T* packed_B, R* c, int ldc, T alpha, T beta)
+        {
+            for (int jr = 0; jr < nc; jr += NR)
+            {
+                const int nr = std::min(NR, nc - jr);
+                for (int ir = 0; ir < mc; ir += MR)
+                {
+                    const int mr = std::min(MR, mc - ir);
+                    micro_kernel<T, MR, NR>(kc, packed_A + static_cast<std::ptrdiff_t>(ir) * kc, packed_B + static_cast<std::ptrdiff_t>(jr) * kc,
+                                            c + static_cast<std::ptrdiff_t>(ir) * ldc + jr, ldc, mr, nr, alpha, beta);
+                }
+            }
+        }
+
+        /**
+         * @brief Returns a packing buffer of at least size elements. Buffers are kept per thread and only grow, so that repeated products do not allocate.
+         */
+        template <typename T, int Id>
+        T* packing_buffer(std::size_t size)
+        {
+            thread_local std::vector<T> buffer;
+            if (buffer.size() < size)
+                buffer.resize(size);
+            return buffer.data();
+        }
+
+        template <typename Op>
+        inline constexpr bool is_stored_operand = false;
+        template <typename U>
+        inline constexpr bool is_stored_operand<StridedOperand<U>> = true;
+
+        /**
+         * @brief Calls f with op, or, if op is evaluated lazily (an expression) and reread is true, with a StridedOperand over its rows x cols
+         * coefficients evaluated once into a buffer.
+         *
+         * The kernels read a lazily evaluated operand as many times as they pack or load it, which would evaluate its coefficients several times:
+         * on every tile of the parallel product, for every column panel of a product wider than NC, and for every output coefficient of a
+         * small product. Evaluating it once keeps each coefficient of an expression evaluated exactly once, at the price of a temporary.
+         */
+        template <typename Op, typename F>
+        void with_evaluated_operand(int rows, int cols, const Op& op, bool reread, F&& f)
+        {
+            if constexpr (!is_stored_operand<Op>)
+                if (reread && rows > 0 && cols > 0)
+                {
+                    using U = std::remove_cvref_t<decltype(op(0, 0))>;
+                    std::vector<U> buffer(static_cast<std::size_t>(rows) * cols);
+                    const int n_tasks = std::min(rows, 4 * num_threads());
+                    parallel_for(n_tasks,
+                                 [&](int task)
+                                 {
+                                     for (int i = rows * task / n_tasks; i < rows * (task + 1) / n_tasks; ++i)
+                                         for (int j = 0; j < cols; ++j)
+                                             buffer[static_cast<std::size_t>(i) * cols + j] = op(i, j);
+                                 });
+                    f(StridedOperand<U> { buffer.data(), cols, 1 });
+                    return;
+                }
+            f(op);
+        }
+
+        /**
+         * @brief Products too small for packing to pay off, computed directly from the operands, accumulating in T.
+         */
+        struct SmallGemm
+        {
+            template <typename R, typename OpA, typename OpB, typename T>
+            static void run(int m, int n, int k, const OpA& A, const OpB& B, R* C, int ldc, T alpha, T beta)
+            {
+                for (int i = 0; i < m; ++i)
+                {
+                    R* c_row = C + static_cast<std::ptrdiff_t>(i) * ldc;
+                    for (int j = 0; j < n; ++j)
+                    {
+                        T sum = T(0);
+                        for (int p = 0; p < k; ++p)
+                            sum += static_cast<T>(A(i, p)) * static_cast<T>(B(p, j));
+                        c_row[j] = static_cast<R>(beta == T(0) ? alpha * sum : beta * c_row[j] + alpha * sum);
+                    }
+                }
+            }
+        };
+
+        /**
+         * @brief The blocked GEMM algorithm, dispatched on the instruction set by gemm(). The panels are packed, and the products accumulated, in T,
+         * over the whole inner dimension even if R is narrower.
+         */
+        struct Gemm
+        {
+            template <typename R, typename OpA, typename OpB, typename T>
+            static void run(int m, int n, int k, const OpA& A, const OpB& B, R* C, int ldc, T alpha, T beta)
+            {
+                using BS = BlockSizes<T>;
+                constexpr int MR = BS::MR;
+                constexpr int NR = BS::NR;
+
+                if (m <= 0 || n <= 0)
+                    return;
+                if (k <= 0)
+                {
+                    for (int i = 0; i < m; ++i)
+                    {
+                        R* c_row = C + static_cast<std::ptrdiff_t>(i) * ldc;
+                        for (int j = 0; j < n; ++j)
+                            c_row[j] = static_cast<R>(beta == T(0) ? T(0) : beta * c_row[j]);
+                    }
+                    return;
+                }
+
+                const int kc_max = std::min(BS::KC, k);
+                const int mc_max = std::min(BS::MC, (m + MR - 1) / MR * MR);
+                const int nc_max = std::min(BS::NC, (n + NR - 1) / NR * NR);
+                T* packed_A = _implementation_details::packing_buffer<T, 0>(static_cast<std::size_t>(mc_max) * kc_max);
+                T* packed_B = _implementation_details::packing_buffer<T, 1>(static_cast<std::size_t>(kc_max) * nc_max);
+
+                // In mixed precision, the sums over the KC deep slices are kept in T in a scratch block, so that C only holds the final rounding.
+                // The slices of B are then packed again for every block of rows, which costs about 1 / MC of the products.
+                if constexpr (!std::is_same_v<R, T>)
+                    if (k > BS::KC)
+                    {
+                        T* block = _implementation_details::packing_buffer<T, 5>(static_cast<std::size_t>(mc_max) * nc_max);
+                        for (int jc = 0; jc < n; jc += BS::NC)
+                        {
+                            const int nc = std::min(BS::NC, n - jc);
+                            for (int ic = 0; ic < m; ic += BS::MC)
+                            {
+                                const int mc = std::min(BS::MC, m - ic);
+                                for (int pc = 0; pc < k; pc += BS::KC)
+                                {
+                                    const int kc = std::min(BS::KC, k - pc);
+                                    _implementation_details::pack_B<T, NR>(kc, nc, B, pc, jc, packed_B);
+                                    _implementation_details::pack_A<T, MR>(mc, kc, A, ic, pc, packed_A);
+                                    _implementation_details::macro_kernel<T, MR, NR>(mc, nc, kc, packed_A, packed_B, block, nc, alpha, pc > 0 ? T(1) : T(0));
+                                }
+
+                                for (int i = 0; i < mc; ++i)
+                                {
+                                    const T* block_row = block + static_cast<std::ptrdiff_t>(i) * nc;
+                                    R* c_row = C + static_cast<std::ptrdiff_t>(ic + i) * ldc + jc;
+                                    for (int j = 0; j < nc; ++j)
+                                        c_row[j] = static_cast<R>(beta == T(0) ? block_row[j] : beta * c_row[j] + block_row[j]);
+                                }
+                            }
+                        }
+                        return;
+                    }
+
+                for (int jc = 0; jc < n; jc += BS::NC)
+                {
+                    const int nc = std::min(BS::NC, n - jc);
+                    for (int pc = 0; pc < k; pc += BS::KC)
+                    {
+                        const int kc = std::min(BS::KC, k - pc);
+                        const T beta_pc = pc > 0 ? T(1) : beta;
+                        _implementation_details::pack_B<T, NR>(kc, nc, B, pc, jc, packed_B);
+
+                        for (int ic = 0; ic < m; ic += BS::MC)
+                        {
+                            const int mc = std::min(BS::MC, m - ic);
+                            _implementation_details::pack_A<T, MR>(mc, kc, A, ic, pc, packed_A);
+                            _implementation_details::macro_kernel<T, MR, NR>(mc, nc, kc, packed_A, packed_B, C + static_cast<std::ptrdiff_t>(ic) * ldc + jc, ldc, alpha, beta_pc);
+                        }
+                    }
+                }
+            }
+        };
+    }
+
+    /**
+     * @brief Computes C = alpha * A * B + beta * C with a cache blocked, panel packing algorithm.
+     *
+     * The loops follow the classical Goto/BLIS structure: the output is split into NC wide column panels, the inner dimension into KC deep slices
+     * and the rows into MC high blocks. Each slice of B and each block of A are packed into contiguous buffers once, and the micro-kernel
+     * computes MR x NR tiles of C from them. Sizes which are not multiples of the block sizes are handled by zero padding the packed panels.
+     *
+     * The operands only need to provide a call operator (i, j), hence any strided or lazily evaluated matrix can be packed.
+     * The kernel is compiled for several instruction sets and the one selected by active_isa() is run.
+     * Large products are split into 2D tiles of C, which are computed independently on the thread pool.
+     * Small products are computed directly from the operands, without packing.
+     * The coefficients of a lazily evaluated operand are evaluated exactly once: while packing if it is packed once, else into a temporary first.
+     * The packing buffers are reused between calls, hence the kernel does not allocate once warmed up.
+     * If beta is zero, C is not read. C must not overlap with the operands.
+     *
+     * The panels are packed, and the products accumulated, in the scalar type of C unless another accumulation type Acc is given. For instance,
+     * gemm<double> on float operands and result reads and writes floats but accumulates in double (mixed precision).
+     *
+     * @tparam Acc accumulation type, or void for the scalar type of C
+     * @tparam T scalar type of the result
+     * @tparam OpA type of the left operand
+     * @tparam OpB type of the right operand
+     * @param m number of rows of A and C
+     * @param n number of columns of B and C
+     * @param k number of columns of A and rows of B
+     * @param A left operand
+     * @param B right operand
+     * @param C pointer to the first element of the row-major result
+     * @param ldc leading dimension of C
+     * @param alpha scaling of the product
+     * @param beta scaling of C
+     */
+    template <typename Acc = void, typename T, typename OpA, typename OpB>
+    void gemm(int m, int n, int k, const OpA& A, const OpB& B, T* C, int ldc, std::type_identity_t<T> alpha = T(1), std::type_identity_t<T> beta = T(0))
+    {
+        using U = std::conditional_t<std::is_void_v<Acc>, T, Acc>;
+        using BS = BlockSizes<U>;
+        const U alpha_acc = static_cast<U>(alpha);
+        const U beta_acc = static_cast<U>(beta);
+        const bool small = !gemm_is_profitable(m, n, k);
+        const bool parallel = !small && gemm_is_parallel(m, n, k);
+
+        // Each tile of the parallel product packs its own panels of A and B, the serial product packs A again for every NC wide panel of B,
+        // and the small product reads the operands once per output coefficient.
+        const bool reread_A = small ? n > 1 : parallel || n > BS::NC;
+        const bool reread_B = small ? m > 1 : parallel;
+        _implementation_details::with_evaluated_operand(m, k, A, reread_A, [&](const auto& A_once)
+        {
+            _implementation_details::with_evaluated_operand(k, n, B, reread_B, [&](const auto& B_once)
+            {
+                using OpA_once = std::remove_cvref_t<decltype(A_once)>;
+                using OpB_once = std::remove_cvref_t<decltype(B_once)>;
+                if (small)
+                    _implementation_details::SmallGemm::run(m, n, k, A_once, B_once, C, ldc, alpha_acc, beta_acc);
+                else if (!parallel)
+                    dispatch<_implementation_details::Gemm>(m, n, k, A_once, B_once, C, ldc, alpha_acc, beta_acc);
+                else
+                    parallel_for_tiles(m, n, BS::MR, BS::NR,
+                                       [&](int i0, int i1, int j0, int j1)
+                                       {
+                                           dispatch<_implementation_details::Gemm>(i1 - i0, j1 - j0, k, OffsetOperand<OpA_once> { A_once, i0, 0 },
+                                                                                   OffsetOperand<OpB_once> { B_once, 0, j0 }, C + static_cast<std::ptrdiff_t>(i0) * ldc + j0,
+                                                                                   ldc, alpha_acc, beta_acc);
+                                       });
+            });
+        });
+    }
+}
@@ -0,0 +1,244 @@
+#pragma once
+
+#include <Matrices/Kernels/Dispatch.hpp>
+#include <Matrices/Kernels/Gemm.hpp>
+#include <Matrices/Kernels/IntGemm.hpp>
+#include <Matrices/Kernels/Operands.hpp>
+#include <Matrices/Kernels/ThreadPool.hpp>
+#include <stdafx.hpp>
+
+namespace LinAlg::Matrices::Kernels
+{
+    /**
+     * @brief Returns true if the matrix-vector product is large enough to be split across threads.
+     */
+    inline bool gemv_is_parallel(int m, int n)
+    {
+        return num_threads() > 1 && static_cast<long long>(m) * n >= 256 * 256;
+    }
+
+    namespace _implementation_details
+    {
+        template <typename Op, typename T>
+        constexpr bool is_strided_operand_of = false;
+        template <typename T>
+        constexpr bool is_strided_operand_of<StridedOperand<T>, T> = true;
+
+        template <typename Acc, typename T>
+        using accumulator_t = std::conditional_t<std::is_void_v<Acc>, T, Acc>;
+
+        /**
+         * @brief Accumulation type of matrix_vector_product(): Acc, or for void the widened type of the integer products (see widened_t).
+         */
+        template <typename Acc, typename T>
+        struct vector_product_accumulator
+        {
+            using type = Acc;
+        };
+
+        template <typename T>
+            requires std::is_integral_v<T>
+        struct vector_product_accumulator<void, T>
+        {
+            using type = widened_t<T>;
+        };
+
+        /**
+         * @brief Dot product of two contiguous arrays, accumulated in Acc. Two cache lines of independent partial sums let the compiler vectorize the loop
+         * and hide the latency of the additions.
+         */
+        template <typename Acc, typename T>
+        Acc dot(int k, const T* __restrict a, const T* __restrict x)
+        {
+            constexpr int lanes = std::max<int>(1, 128 / sizeof(Acc));
+            Acc acc[lanes] = {};
+            int p = 0;
+            for (; p + lanes <= k; p += lanes)
+                for (int l = 0; l < lanes; ++l)
+                    acc[l] += static_cast<Acc>(a[p + l]) * static_cast<Acc>(x[p + l]);
+
+            Acc sum = Acc(0);
+            for (int l = 0; l < lanes; ++l)
+                sum += acc[l];
+            for (; p < k; ++p)
+                sum += static_cast<Acc>(a[p]) * static_cast<Acc>(x[p]);
+            return sum;
+        }
+
+        /**
+         * @brief Computes the rows [i0, i1) of y = A * x, accumulating in Acc (the scalar type of y if void).
+         */
+        template <typename Acc>
+        struct Gemv
+        {
+            template <typename T, typename OpA>
+            static void run(int i0, int i1, int k, const OpA& A, const T* x, T* y)
+            {
+                using U = accumulator_t<Acc, T>;
+                if constexpr (is_strided_operand_of<OpA, T>)
+                    if (A.col_stride == 1)
+                    {
+                        for (int i = i0; i < i1; ++i)
+                            y[i] = static_cast<T>(dot<U>(k, A.data + static_cast<std::ptrdiff_t>(i) * A.row_stride, x));
+                        return;
+                    }
+
+                for (int i = i0; i < i1; ++i)
+                {
+                    U sum = U(0);
+                    for (int p = 0; p < k; ++p)
+                        sum += static_cast<U>(A(i, p)) * static_cast<U>(x[p]);
+                    y[i] = static_cast<T>(sum);
+                }
+            }
+        };
+
+        /**
+         * @brief Computes the columns [j0, j1) of y = x * B, adding the rows of B scaled by the coefficients of x.
+         *
+         * If Acc differs from the scalar type of y, the columns are accumulated in a buffer of type Acc and converted at the end.
+         */
+        template <typename Acc>
+        struct Gevm
+        {
+            template <typename T, typename OpB>
+            static void run(int j0, int j1, int k, const T* x, const OpB& B, T* __restrict y)
+            {
+                using U = accumulator_t<Acc, T>;
+                U* __restrict acc;
+                if constexpr (std::is_same_v<U, T>)
+                    acc = y + j0;
+                else
+                    acc = packing_buffer<U, 3>(static_cast<std::size_t>(j1 - j0));
+                std::fill(acc, acc + (j1 - j0), U(0));
+
+                if constexpr (is_strided_operand_of<OpB, T>)
+                    if (B.col_stride == 1)
+                    {
+                        for (int p = 0; p < k; ++p)
+                        {
+                            const U xp = x[p];
+                            const T* __restrict b_row = B.data + static_cast<std::ptrdiff_t>(p) * B.row_stride + j0;
+                            for (int j = 0; j < j1 - j0; ++j)
+                                acc[j] += xp * static_cast<U>(b_row[j]);
+                        }
+                    }
+                    else
+                        accumulate(j0, j1, k, x, B, acc);
+                else
+                    accumulate(j0, j1, k, x, B, acc);
+
+                if constexpr (!std::is_same_v<U, T>)
+                    for (int j = 0; j < j1 - j0; ++j)
+                        y[j0 + j] = static_cast<T>(acc[j]);
+            }
+
+            template <typename T, typename OpB, typename U>
+            static void accumulate(int j0, int j1, int k, const T* x, const OpB& B, U* __restrict acc)
+            {
+                for (int p = 0; p < k; ++p)
+                    for (int j = j0; j < j1; ++j)
+                        acc[j - j0] += static_cast<U>(x[p]) * static_cast<U>(B(p, j));
+            }
+        };
+    }
+
+    /**
+     * @brief Computes the matrix-vector product y = A * x.
+     *
+     * The product is bound by the bandwidth needed to stream A. Rows of a contiguous A are reduced with a vectorized dot product,
+     * and large products are split in blocks of rows on the thread pool. The dot products are accumulated in Acc, or in T if it is void.
+     *
+     * @tparam Acc accumulation type, or void
+     * @tparam T scalar type of the vectors
+     * @tparam OpA type of the matrix operand
+     * @param m number of rows of A and size of y
+     * @param k number of columns of A and size of x
+     * @param A matrix operand
+     * @param x pointer to the contiguous vector x
+     * @param y pointer to the contiguous vector y
+     */
+    template <typename Acc = void, typename T, typename OpA>
+    void gemv(int m, int k, const OpA& A, const T* x, T* y)
+    {
+        using Impl = _implementation_details::Gemv<Acc>;
+        if (!gemv_is_parallel(m, k))
+        {
+            dispatch<Impl>(0, m, k, A, x, y);
+            return;
+        }
+
+        const int rows_per_task = std::max(1, m / (4 * num_threads()));
+        parallel_for((m + rows_per_task - 1) / rows_per_task,
+                     [&](int task) { dispatch<Impl>(task * rows_per_task, std::min(m, (task + 1) * rows_per_task), k, A, x, y); });
+    }
+
+    /**
+     * @brief Computes the vector-matrix product y = x * B.
+     *
+     * Rows of a contiguous B are accumulated into y with vectorized axpy updates. Large products are split in blocks of columns on the thread pool,
+     * blocks being multiples of a cache line so that threads never write to the same line. The sums are accumulated in Acc, or in T if it is void.
+     *
+     * @tparam Acc accumulation type, or void
+     * @tparam T scalar type of the vectors
+     * @tparam OpB type of the matrix operand
+     * @param k number of rows of B and size of x
+     * @param n number of columns of B and size of y
+     * @param x pointer to the contiguous vector x
+     * @param B matrix operand
+     * @param y pointer to the contiguous vector y
+     */
+    template <typename Acc = void, typename T, typename OpB>
+    void gevm(int k, int n, const T* x, const OpB& B, T* y)
+    {
+        using Impl = _implementation_details::Gevm<Acc>;
+        if (!gemv_is_parallel(k, n))
+        {
+            dispatch<Impl>(0, n, k, x, B, y);
+            return;
+        }
+
+        constexpr int line = std::max<int>(1, 64 / sizeof(T));
+        const int cols_per_task = std::max(line, (n / (4 * num_threads()) + line - 1) / line * line);
+        parallel_for((n + cols_per_task - 1) / cols_per_task,
+                     [&](int task) { dispatch<Impl>(task * cols_per_task, std::min(n, (task + 1) * cols_per_task), k, x, B, y); });
+    }
+
+    /**
+     * @brief Computes res = lhs * rhs with gemv() if rhs is a column vector, or with gevm() if lhs is a row vector.
+     *
+     * Vectors which are not stored contiguously with scalar type T (expressions, helper matrices) are evaluated into a temporary first.
+     * The products are accumulated in Acc. If it is void, they are accumulated in T for floating point types, and in the widened type
+     * widened_t<T> for integer types, like the integer matrix products of int_gemm().
+     *
+     * @return true if the product has been computed, false if none of the operands is a vector
+     */
+    template <typename Acc = void, typename T, typename LHS, typename RHS>
+    bool matrix_vector_product(const LHS& lhs, const RHS& rhs, T* res)
+    {
+        const auto with_vector = [](const auto& vec, auto&& f)
+        {
+            if constexpr (Concepts::ContiguousMatrixOf<decltype(vec), T>)
+                if (vec.rows() == 1 || leading_dimension(vec) == 1)
+                {
+                    f(data_ptr(vec));
+                    return;
+                }
+
+            // Expressions, other scalar types, and padded column vectors whose coefficients are not contiguous.
+            std::vector<T> values(static_cast<std::size_t>(vec.rows()) * vec.cols());
+            for (int i = 0; i < static_cast<int>(values.size()); ++i)
+                values[i] = static_cast<T>(vec[i]);
+            f(values.data());
+        };
+
+        using Accumulator = typename _implementation_details::vector_product_accumulator<Acc, T>::type;
+        if (rhs.cols() == 1)
+            with_vector(rhs, [&](const T* x) { gemv<Accumulator>(lhs.rows(), lhs.cols(), make_operand(lhs), x, res); });
+        else if (lhs.rows() == 1)
+            with_vector(lhs, [&](const T* x) { gevm<Accumulator>(rhs.rows(), rhs.cols(), x, make_operand(rhs), res); });
+        else
+            return false;
+        return true;
+    }
+}
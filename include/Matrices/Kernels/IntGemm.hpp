@@ -0,0 +1,166 @@
+#pragma once
+
+#include <Matrices/Kernels/Dispatch.hpp>
+#include <Matrices/Kernels/Gemm.hpp>
+#include <Matrices/Kernels/Operands.hpp>
+#include <Matrices/Kernels/ThreadPool.hpp>
+#include <stdafx.hpp>
+
+namespace LinAlg::Matrices::Kernels
+{
+    namespace _implementation_details
+    {
+        /**
+         * @brief True if every value of the types U can be represented in V.
+         */
+        template <typename V, typename... U>
+        inline constexpr bool holds_values_v = (... && (std::in_range<V>(std::numeric_limits<U>::min()) && std::in_range<V>(std::numeric_limits<U>::max())));
+    }
+
+    /**
+     * @brief Types used by the integer product of inputs of types UA and UB.
+     *
+     * Inputs whose values all fit in 16 bit (int8, uint8 and int16) are packed as 16 bit integers and accumulated in 32 bit, so that the dot
+     * products map to pmaddwd (or vpdpwssd with VNNI). Wider inputs are packed in the narrowest type holding the values of both, unsigned if
+     * both are unsigned, and accumulated in 64 bit, unsigned if both inputs are unsigned. For instance, uint16 inputs are packed as uint32
+     * and accumulated in uint64, and int8 x uint16 inputs are packed as int32 and accumulated in int64.
+     *
+     * @tparam UA integer scalar type of the left input
+     * @tparam UB integer scalar type of the right input
+     */
+    template <typename UA, typename UB = UA>
+    struct IntegerProductTypes
+    {
+        static_assert(std::is_integral_v<UA> && std::is_integral_v<UB>, "IntegerProductTypes is only defined for integer types.");
+
+        static constexpr bool is_unsigned = std::is_unsigned_v<UA> && std::is_unsigned_v<UB>;
+        static_assert(is_unsigned || _implementation_details::holds_values_v<std::int64_t, UA, UB>,
+                      "The integer product of a signed and a 64 bit unsigned input is not supported.");
+
+        using Packed = std::conditional_t<_implementation_details::holds_values_v<std::int16_t, UA, UB>, std::int16_t,
+                                          std::conditional_t<is_unsigned, std::conditional_t<_implementation_details::holds_values_v<std::uint32_t, UA, UB>, std::uint32_t, std::uint64_t>,
+                                                             std::conditional_t<_implementation_details::holds_values_v<std::int32_t, UA, UB>, std::int32_t, std::int64_t>>>;
+        using Accumulator = std::conditional_t<std::is_same_v<Packed, std::int16_t>, std::int32_t, std::conditional_t<is_unsigned, std::uint64_t, std::int64_t>>;
+    };
+
+    /**
+     * @brief Accumulator type of the integer product of matrices with scalar type U.
+     */
+    template <typename U>
+    using widened_t = typename IntegerProductTypes<U>::Accumulator;
+
+    namespace _implementation_details
+    {
+        template <typename Op>
+        using operand_scalar_t = std::remove_cvref_t<decltype(std::declval<const Op&>()(0, 0))>;
+
+        /**
+         * @brief The blocked integer product, dispatched on the instruction set by int_gemm().
+         *
+         * Rows of A and columns of B are packed contiguously over the whole inner dimension, so that each coefficient is a single dot product
+         * accumulated in registers and converted to R only once. The dot products are computed in 4 x 4 tiles, which the compiler maps to
+         * pmaddwd (vpdpwssd with VNNI) on 16 bit packed values. Columns are processed in blocks whose packed columns fit in L2.
+         * Sums are accumulated in R if it is wider than the default accumulator.
+         */
+        struct IntGemm
+        {
+            template <typename R, typename OpA, typename OpB>
+            static void run(int m, int n, int k, const OpA& A, const OpB& B, R* C, int ldc)
+            {
+                using UA = operand_scalar_t<OpA>;
+                using UB = operand_scalar_t<OpB>;
+                using Types = IntegerProductTypes<UA, UB>;
+                using P = typename Types::Packed;
+                using Acc = std::conditional_t<(sizeof(R) > sizeof(typename Types::Accumulator)), R, typename Types::Accumulator>;
+
+                constexpr int MR = 4;
+                constexpr int NR = 4;
+                const int nc_max = std::clamp<int>(256 * 1024 / (sizeof(P) * std::max(k, 1)), NR, std::max(n, NR));
+                P* packed_A = packing_buffer<P, 0>(static_cast<std::size_t>(MR) * k);
+                P* packed_B = packing_buffer<P, 1>(static_cast<std::size_t>(nc_max) * k);
+
+                for (int jc = 0; jc < n; jc += nc_max)
+                {
+                    const int nc = std::min(nc_max, n - jc);
+                    for (int j = 0; j < nc; ++j)
+                        for (int p = 0; p < k; ++p)
+                            packed_B[static_cast<std::ptrdiff_t>(j) * k + p] = static_cast<P>(B(p, jc + j));
+
+                    for (int ir = 0; ir < m; ir += MR)
+                    {
+                        const int mr = std::min(MR, m - ir);
+                        for (int i = 0; i < mr; ++i)
+                            for (int p = 0; p < k; ++p)
+                                packed_A[static_cast<std::ptrdiff_t>(i) * k + p] = static_cast<P>(A(ir + i, p));
+
+                        R* c_block = C + static_cast<std::ptrdiff_t>(ir) * ldc + jc;
+                        int j = 0;
+                        if (mr == MR)
+                            for (; j + NR <= nc; j += NR)
+                                micro_kernel<Acc, MR, NR>(k, packed_A, packed_B + static_cast<std::ptrdiff_t>(j) * k, c_block + j, ldc);
+                        for (; j < nc; ++j)
+                            micro_kernel<Acc, 1, 1>(k, packed_A, packed_B + static_cast<std::ptrdiff_t>(j) * k, c_block + j, ldc, mr);
+                    }
+                }
+            }
+
+            /**
+             * @brief Computes the MR x NR tile of C from MR packed rows of A and NR packed columns of B, each of length k.
+             *
+             * Each coefficient is a dot product accumulated in its own register, so that every loaded vector of A and B is used NR and MR times.
+             * The tile is repeated over the first rows rows of A.
+             */
+            template <typename Acc, int MR, int NR, typename P, typename R>
+            static void micro_kernel(int k, const P* __restrict a, const P* __restrict b, R* c, int ldc, int rows = MR)
+            {
+                for (int i0 = 0; i0 < rows; i0 += MR)
+                {
+                    Acc sum[MR][NR] = {};
+                    for (int p = 0; p < k; ++p)
+                        for (int i = 0; i < MR; ++i)
+                            for (int j = 0; j < NR; ++j)
+                                sum[i][j] += static_cast<Acc>(a[static_cast<std::ptrdiff_t>(i0 + i) * k + p]) * static_cast<Acc>(b[static_cast<std::ptrdiff_t>(j) * k + p]);
+
+                    for (int i = 0; i < MR; ++i)
+                        for (int j = 0; j < NR; ++j)
+                            c[static_cast<std::ptrdiff_t>(i0 + i) * ldc + j] = static_cast<R>(sum[i][j]);
+                }
+            }
+        };
+    }
+
+    /**
+     * @brief Computes C = A * B for integer operands, accumulating in a widened integer type.
+     *
+     * The coefficients are accumulated in 32 bit for 8 bit and int16 inputs and in 64 bit otherwise (see IntegerProductTypes), or in R if it is wider,
+     * and converted to R at the end. Hence intermediate sums do not overflow as long as they fit in the accumulator. The kernel is compiled for several instruction sets and the one selected by
+     * active_isa() is run. Large products are split into 2D tiles of C, which are computed independently on the thread pool.
+     *
+     * @tparam R scalar type of the result
+     * @tparam OpA type of the left operand
+     * @tparam OpB type of the right operand
+     * @param m number of rows of A and C
+     * @param n number of columns of B and C
+     * @param k number of columns of A and rows of B
+     * @param A left operand
+     * @param B right operand
+     * @param C pointer to the first element of the row-major result
+     * @param ldc leading dimension of C
+     */
+    template <typename R, typename OpA, typename OpB>
+    void int_gemm(int m, int n, int k, const OpA& A, const OpB& B, R* C, int ldc)
+    {
+        if (!gemm_is_parallel(m, n, k))
+        {
+            dispatch<_implementation_details::IntGemm>(m, n, k, A, B, C, ldc);
+            return;
+        }
+
+        parallel_for_tiles(m, n, 1, 16,
+                           [&](int i0, int i1, int j0, int j1)
+                           {
+                               dispatch<_implementation_details::IntGemm>(i1 - i0, j1 - j0, k, OffsetOperand<OpA> { A, i0, 0 }, OffsetOperand<OpB> { B, 0, j0 },
+                                                                          C + static_cast<std::ptrdiff_t>(i0) * ldc + j0, ldc);
+                           });
+    }
+}
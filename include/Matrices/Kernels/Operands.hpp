@@ -0,0 +1,231 @@
+#pragma once
+
+#include <stdafx.hpp>
+
+namespace LinAlg::Matrices::Kernels
+{
+    /**
+     * @brief Whether the matrix (or expression) Mat is stored row by row, as the matrices whose Layout does not say otherwise.
+     * An expression declares it with its IsRowMajor member, true if one of its matrices at least is row-major.
+     */
+    template <typename Mat>
+    inline constexpr bool is_row_major = []
+    {
+        using M = std::remove_cvref_t<Mat>;
+        if constexpr (requires { M::Layout::is_row_major; })
+            return M::Layout::is_row_major;
+        else if constexpr (requires { M::IsRowMajor; })
+            return M::IsRowMajor;
+        else
+            return true;
+    }();
+}
+
+namespace LinAlg::Matrices::Kernels::Concepts
+{
+    /**
+     * @brief A matrix whose coefficients are stored in row-major order and can be accessed through a pointer.
+     *
+     * The rows are contiguous, and leading_dimension() apart if the matrix has such a member (padded rows), else cols() apart.
+     */
+    template <typename Mat>
+    concept ContiguousMatrix = is_row_major<Mat> && requires(const std::remove_cvref_t<Mat>& m) {
+        { std::ranges::data(m.data()) } -> std::convertible_to<const typename std::remove_cvref_t<Mat>::Scalar*>;
+    };
+
+    /**
+     * @brief A matrix whose coefficients are stored in column-major order and can be accessed through a pointer. The columns are contiguous,
+     * and leading_dimension() apart.
+     */
+    template <typename Mat>
+    concept ColMajorMatrix = std::remove_cvref_t<Mat>::Layout::is_col_major && requires(const std::remove_cvref_t<Mat>& m) {
+        { std::ranges::data(m.data()) } -> std::convertible_to<const typename std::remove_cvref_t<Mat>::Scalar*>;
+        { m.leading_dimension() } -> std::convertible_to<int>;
+    };
+
+    /**
+     * @brief A view of coefficients stored in memory with arbitrary strides between the rows and the columns, as a block or a transpose
+     * (see ET::StridedView). data() returns a pointer to the first coefficient.
+     */
+    template <typename Mat>
+    concept StridedMatrix = requires(const std::remove_cvref_t<Mat>& m) {
+        { m.data() } -> std::convertible_to<const typename std::remove_cvref_t<Mat>::Scalar*>;
+        { m.row_stride() } -> std::convertible_to<int>;
+        { m.col_stride() } -> std::convertible_to<int>;
+    };
+
+    /**
+     * @brief A ContiguousMatrix with scalar type T.
+     */
+    template <typename Mat, typename T>
+    concept ContiguousMatrixOf = ContiguousMatrix<Mat> && std::same_as<typename std::remove_cvref_t<Mat>::Scalar, T>;
+}
+
+namespace LinAlg::Matrices::Kernels
+{
+    /**
+     * @brief A read-only operand of the kernels, given by a pointer and the strides between rows and columns.
+     *
+     * A row-major matrix with leading dimension ld has row_stride = ld and col_stride = 1.
+     *
+     * @tparam U scalar type of the stored elements
+     */
+    template <typename U>
+    struct StridedOperand
+    {
+        const U* data;
+        int row_stride;
+        int col_stride;
+
+        U operator()(int i, int j) const { return data[static_cast<std::ptrdiff_t>(i) * row_stride + static_cast<std::ptrdiff_t>(j) * col_stride]; }
+    };
+
+    /**
+     * @brief An operand shifted by a given row and column offset, used to process sub-blocks of a larger operand.
+     *
+     * @tparam Op type of the underlying operand
+     */
+    template <typename Op>
+    struct OffsetOperand
+    {
+        const Op& op;
+        int row;
+        int col;
+
+        auto operator()(int i, int j) const { return op(row + i, col + j); }
+    };
+
+    /**
+     * @brief An operand reading the coefficients through the matrix call operator [i, j]. Used for expressions and helper matrices,
+     * which are not stored in memory.
+     *
+     * @tparam Mat matrix type
+     */
+    template <typename Mat>
+    struct ElementOperand
+    {
+        const Mat& mat;
+
+        auto operator()(int i, int j) const { return mat[i, j]; }
+    };
+
+    /**
+     * @brief The transpose of an operand.
+     *
+     * @tparam Op type of the underlying operand
+     */
+    template <typename Op>
+    struct TransposedOperand
+    {
+        Op op;
+
+        auto operator()(int i, int j) const { return op(j, i); }
+    };
+
+    /**
+     * @brief Returns the transpose of an operand. Strided operands are transposed by swapping their strides.
+     */
+    template <typename Op>
+    auto transpose(const Op& op)
+    {
+        return TransposedOperand<Op> { op };
+    }
+
+    template <typename U>
+    StridedOperand<U> transpose(const StridedOperand<U>& op)
+    {
+        return { op.data, op.col_stride, op.row_stride };
+    }
+
+    /**
+     * @brief Returns the distance between the first coefficients of two consecutive rows of a contiguous row-major matrix,
+     * or of two consecutive columns of a column-major one.
+     */
+    template <typename Mat>
+        requires Concepts::ContiguousMatrix<Mat> || Concepts::ColMajorMatrix<Mat>
+    int leading_dimension(const Mat& mat)
+    {
+        if constexpr (requires { mat.leading_dimension(); })
+            return mat.leading_dimension();
+        else
+            return mat.cols();
+    }
+
+    /**
+     * @brief Returns whether the matrix mat, or one of the matrices of the expression mat, has padded rows.
+     */
+    template <typename Mat>
+    bool is_padded(const Mat& mat)
+    {
+        if constexpr (requires { mat.is_padded(); })
+            return mat.is_padded();
+        else
+            return false;
+    }
+
+    /**
+     * @brief Returns the flattened coefficient i of a matrix (or expression) which is not padded (see is_padded()).
+     *
+     * Stored matrices are read at data()[i], without the test on the padding of their flattened operator[]: inside a loop calling
+     * an opaque function, the compiler cannot hoist that test and reevaluates it for every coefficient.
+     */
+    template <typename Mat>
+    auto unpadded_coeff(const Mat& mat, int i)
+    {
+        if constexpr (requires { mat.unpadded_coeff(i); })
+            return mat.unpadded_coeff(i);
+        else if constexpr (Concepts::ContiguousMatrix<Mat>)
+            return std::ranges::data(mat.data())[i];
+        else
+            return mat[i];
+    }
+
+    /**
+     * @brief Wraps a contiguous row-major matrix into a StridedOperand.
+     */
+    template <Concepts::ContiguousMatrix Mat>
+    auto make_operand(const Mat& mat)
+    {
+        using U = typename std::remove_cvref_t<Mat>::Scalar;
+        return StridedOperand<U> { std::ranges::data(mat.data()), leading_dimension(mat), 1 };
+    }
+
+    /**
+     * @brief Wraps a column-major matrix into a StridedOperand, whose rows are one coefficient apart.
+     */
+    template <Concepts::ColMajorMatrix Mat>
+    auto make_operand(const Mat& mat)
+    {
+        using U = typename std::remove_cvref_t<Mat>::Scalar;
+        return StridedOperand<U> { std::ranges::data(mat.data()), 1, leading_dimension(mat) };
+    }
+
+    /**
+     * @brief Wraps a strided view into a StridedOperand with its strides, so that blocks and transposes are read in place.
+     */
+    template <Concepts::StridedMatrix Mat>
+    auto make_operand(const Mat& mat)
+    {
+        using U = typename std::remove_cvref_t<Mat>::Scalar;
+        return StridedOperand<U> { mat.data(), mat.row_stride(), mat.col_stride() };
+    }
+
+    /**
+     * @brief Wraps a matrix which is not stored in memory with strides (expressions, helper and tiled matrices) into an ElementOperand.
+     */
+    template <typename Mat>
+        requires(!Concepts::ContiguousMatrix<Mat> && !Concepts::ColMajorMatrix<Mat> && !Concepts::StridedMatrix<Mat>)
+    auto make_operand(const Mat& mat)
+    {
+        return ElementOperand<std::remove_cvref_t<Mat>> { mat };
+    }
+
+    /**
+     * @brief Returns a pointer to the first coefficient of a contiguous row-major matrix.
+     */
+    template <Concepts::ContiguousMatrix Mat>
+    auto* data_ptr(Mat& mat)
+    {
+        return std::ranges::data(mat.data());
+    }
+}
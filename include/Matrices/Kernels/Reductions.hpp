@@ -0,0 +1,106 @@
+#pragma once
+
+#include <Matrices/Kernels/Dispatch.hpp>
+#include <Matrices/Kernels/ThreadPool.hpp>
+#include <stdafx.hpp>
+
+namespace LinAlg::Matrices::Kernels
+{
+    /**
+     * @brief Number of coefficients reduced by a task of the parallel reductions. It does not depend on the number of threads,
+     * hence the result of a reduction is the same whatever the number of threads.
+     */
+    inline constexpr int reduction_chunk = 1 << 14;
+
+    namespace _implementation_details
+    {
+        /**
+         * @brief Writes the sum of the terms f(i), i in [i0, i1), accumulated in Acc, into out.
+         *
+         * Two cache lines of independent partial sums let the compiler vectorize the loop and hide the latency of the additions.
+         * The evaluation of the terms, hence of the expressions they read, is inlined in the loop.
+         */
+        struct Reduce
+        {
+            template <typename Acc, typename F>
+            static void run(int i0, int i1, const F& f, Acc& out)
+            {
+                constexpr int lanes = std::max<int>(1, 128 / sizeof(Acc));
+                Acc acc[lanes] = {};
+                int i = i0;
+                for (; i + lanes <= i1; i += lanes)
+                    for (int l = 0; l < lanes; ++l)
+                        acc[l] += f(i + l);
+
+                Acc sum = Acc(0);
+                for (int l = 0; l < lanes; ++l)
+                    sum += acc[l];
+                for (; i < i1; ++i)
+                    sum += f(i);
+                out = sum;
+            }
+        };
+
+        /**
+         * @brief Reduces the size coefficients of f by chunks of reduction_chunk, on the thread pool if there are several chunks.
+         * The partial sums of the chunks are added in order.
+         */
+        template <typename Acc, typename F>
+        Acc reduce(int size, const F& f)
+        {
+            const int n_chunks = (size + reduction_chunk - 1) / reduction_chunk;
+            const auto reduce_chunk = [&](int chunk, Acc& out)
+            { dispatch<Reduce>(chunk * reduction_chunk, std::min(size, (chunk + 1) * reduction_chunk), f, out); };
+
+            Acc total = Acc(0);
+            if (num_threads() <= 1 || n_chunks < 2)
+                for (int chunk = 0; chunk < n_chunks; ++chunk)
+                {
+                    Acc partial;
+                    reduce_chunk(chunk, partial);
+                    total += partial;
+                }
+            else
+            {
+                std::vector<Acc> partials(n_chunks);
+                parallel_for(n_chunks, [&](int chunk) { reduce_chunk(chunk, partials[chunk]); });
+                for (Acc partial : partials)
+                    total += partial;
+            }
+            return total;
+        }
+    }
+
+    /**
+     * @brief Returns the sum of x[0], ..., x[size - 1], accumulated in Acc.
+     *
+     * The sum is bound by the bandwidth needed to stream x, hence float data accumulated in double costs about the same as a float sum
+     * and half a double one. The loop is compiled for several instruction sets and large sums are split in chunks on the thread pool.
+     *
+     * @tparam Acc accumulation type
+     * @tparam X pointer type, or matrix type accessed through its flattened operator[]
+     * @param size number of coefficients
+     * @param x coefficients
+     */
+    template <typename Acc, typename X>
+    Acc reduce_sum(int size, const X& x)
+    {
+        return _implementation_details::reduce<Acc>(size, [&](int i) { return static_cast<Acc>(x[i]); });
+    }
+
+    /**
+     * @brief Returns the sum of x[i] * y[i] for i in [0, size), accumulated in Acc. See reduce_sum.
+     *
+     * @tparam Acc accumulation type
+     * @tparam X pointer type, or matrix type accessed through its flattened operator[]
+     * @tparam Y pointer type, or matrix type accessed through its flattened operator[]
+     * @param size number of coefficients
+     * @param x left coefficients
+     * @param y right coefficients
+     */
+    template <typename Acc, typename X, typename Y>
+    Acc reduce_dot(int size, const X& x, const Y& y)
+    {
+        return _implementation_details::reduce<Acc>(size, [&](int i) { return static_cast<Acc>(x[i]) * static_cast<Acc>(y[i]); });
+    }
+}
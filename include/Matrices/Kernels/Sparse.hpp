@@ -0,0 +1,419 @@
+#pragma once
+
+#include <Matrices/Kernels/Dispatch.hpp>
+#include <Matrices/Kernels/Gemv.hpp>
+#include <Matrices/Kernels/Operands.hpp>
+#include <Matrices/Kernels/ThreadPool.hpp>
+#include <stdafx.hpp>
+
+namespace LinAlg::Matrices::Kernels
+{
+    /**
+     * @brief The arrays of a compressed sparse matrix (CSR or CSC).
+     *
+     * The non-zeros of the outer index o (a row for CSR, a column for CSC) are stored in [offsets[o], offsets[o + 1]), sorted by inner index.
+     *
+     * @tparam T scalar type
+     */
+    template <typename T>
+    struct CompressedArrays
+    {
+        std::vector<int> offsets; ///< outer size + 1 offsets into indices and values.
+        std::vector<int> indices; ///< Inner index of each non-zero.
+        std::vector<T> values;    ///< Value of each non-zero.
+    };
+
+    /**
+     * @brief A read-only compressed sparse operand of the kernels, pointing to the arrays of a CompressedArrays.
+     *
+     * @tparam T scalar type
+     */
+    template <typename T>
+    struct CompressedOperand
+    {
+        const int* offsets;
+        const int* indices;
+        const T* values;
+    };
+
+    /**
+     * @brief Returns true if a sparse product with nnz non-zeros and n dense columns is large enough to be split across threads.
+     */
+    inline bool sparse_is_parallel(long long nnz, int n)
+    {
+        return num_threads() > 1 && nnz * std::max(n, 1) >= 1 << 15;
+    }
+
+    namespace _implementation_details
+    {
+        /**
+         * @brief Splits the outer indices of a compressed operand into n_tasks ranges [bounds[t], bounds[t + 1]).
+         *
+         * The ranges are balanced by their number of non-zeros plus their number of outer indices, so that banded and power-law matrices,
+         * whose rows have very different lengths, are split evenly.
+         */
+        inline std::vector<int> outer_bounds(int outer, const int* offsets, int n_tasks)
+        {
+            const long long total = static_cast<long long>(offsets[outer]) + outer;
+            std::vector<int> bounds(n_tasks + 1);
+            for (int t = 0; t <= n_tasks; ++t)
+            {
+                const long long target = total * t / n_tasks;
+                bounds[t] = *std::ranges::partition_point(std::views::iota(0, outer + 1), [&](int o) { return offsets[o] + static_cast<long long>(o) < target; });
+            }
+            return bounds;
+        }
+
+        /**
+         * @brief Calls f(o0, o1) on ranges of outer indices balanced by outer_bounds, on the thread pool if parallel is true.
+         */
+        template <typename F>
+        void parallel_for_outer(int outer, const int* offsets, bool parallel, const F& f)
+        {
+            const int n_tasks = std::min(outer, 4 * num_threads());
+            if (!parallel || n_tasks < 2)
+            {
+                f(0, outer);
+                return;
+            }
+
+            const std::vector<int> bounds = outer_bounds(outer, offsets, n_tasks);
+            parallel_for(n_tasks,
+                         [&](int t)
+                         {
+                             if (bounds[t] < bounds[t + 1])
+                                 f(bounds[t], bounds[t + 1]);
+                         });
+        }
+
+        /**
+         * @brief Rows [i0, i1) of C = A * B, where A is CSR and B dense. Each non-zero of a row of A adds a scaled row of B to the row of C,
+         * which vectorizes when B is stored row-major. Products with a vector (n == 1) are accumulated in a register instead.
+         */
+        struct CsrTimesDense
+        {
+            template <typename T, typename S, typename OpB>
+            static void run(int i0, int i1, int n, const CompressedOperand<S>& A, const OpB& B, T* C, int ldc)
+            {
+                for (int i = i0; i < i1; ++i)
+                {
+                    T* __restrict c_row = C + static_cast<std::ptrdiff_t>(i) * ldc;
+                    if (n == 1)
+                    {
+                        T sum = T(0);
+                        for (int q = A.offsets[i]; q < A.offsets[i + 1]; ++q)
+                            sum += static_cast<T>(A.values[q]) * static_cast<T>(B(A.indices[q], 0));
+                        c_row[0] = sum;
+                        continue;
+                    }
+
+                    std::fill(c_row, c_row + n, T(0));
+                    for (int q = A.offsets[i]; q < A.offsets[i + 1]; ++q)
+                    {
+                        const T a = static_cast<T>(A.values[q]);
+                        if constexpr (is_strided_operand_of<OpB, T>)
+                            if (B.col_stride == 1)
+                            {
+                                const T* __restrict b_row = B.data + static_cast<std::ptrdiff_t>(A.indices[q]) * B.row_stride;
+                                for (int j = 0; j < n; ++j)
+                                    c_row[j] += a * b_row[j];
+                                continue;
+                            }
+                        for (int j = 0; j < n; ++j)
+                            c_row[j] += a * static_cast<T>(B(A.indices[q], j));
+                    }
+                }
+            }
+        };
+
+        /**
+         * @brief Adds the contribution of the columns [p0, p1) of A to the columns [j0, j1) of C = A * B, where A is CSC and B dense.
+         * Each non-zero (i, p) of A adds a scaled part of row p of B to row i of C.
+         */
+        struct CscTimesDense
+        {
+            template <typename T, typename S, typename OpB>
+            static void run(int p0, int p1, int j0, int j1, const CompressedOperand<S>& A, const OpB& B, T* C, int ldc)
+            {
+                for (int p = p0; p < p1; ++p)
+                    for (int q = A.offsets[p]; q < A.offsets[p + 1]; ++q)
+                    {
+                        const T a = static_cast<T>(A.values[q]);
+                        T* __restrict c_row = C + static_cast<std::ptrdiff_t>(A.indices[q]) * ldc;
+                        for (int j = j0; j < j1; ++j)
+                            c_row[j] += a * static_cast<T>(B(p, j));
+                    }
+            }
+        };
+
+        /**
+         * @brief Rows [i0, i1) of C = A * B, where A is dense and B is CSR. Each coefficient (i, p) of A adds a scaled row p of B to row i of C.
+         */
+        struct DenseTimesCsr
+        {
+            template <typename T, typename S, typename OpA>
+            static void run(int i0, int i1, int n, int k, const OpA& A, const CompressedOperand<S>& B, T* C, int ldc)
+            {
+                for (int i = i0; i < i1; ++i)
+                {
+                    T* __restrict c_row = C + static_cast<std::ptrdiff_t>(i) * ldc;
+                    std::fill(c_row, c_row + n, T(0));
+                    for (int p = 0; p < k; ++p)
+                    {
+                        const T a = static_cast<T>(A(i, p));
+                        for (int q = B.offsets[p]; q < B.offsets[p + 1]; ++q)
+                            c_row[B.indices[q]] += a * static_cast<T>(B.values[q]);
+                    }
+                }
+            }
+        };
+
+        /**
+         * @brief Rows [i0, i1) of C = A * B, where A is dense and B is CSC. Each coefficient (i, j) of C is the sparse dot product of row i of A
+         * with column j of B.
+         */
+        struct DenseTimesCsc
+        {
+            template <typename T, typename S, typename OpA>
+            static void run(int i0, int i1, int n, const OpA& A, const CompressedOperand<S>& B, T* C, int ldc)
+            {
+                for (int i = i0; i < i1; ++i)
+                {
+                    T* __restrict c_row = C + static_cast<std::ptrdiff_t>(i) * ldc;
+                    for (int j = 0; j < n; ++j)
+                    {
+                        T sum = T(0);
+                        for (int q = B.offsets[j]; q < B.offsets[j + 1]; ++q)
+                            sum += static_cast<T>(A(i, B.indices[q])) * static_cast<T>(B.values[q]);
+                        c_row[j] = sum;
+                    }
+                }
+            }
+        };
+    }
+
+    /**
+     * @brief Computes C = A * B, where A is an m x k CSR matrix and B a dense k x n operand (SpMM, or SpMV if n == 1).
+     *
+     * The rows of C are independent, hence large products are split on the thread pool in row ranges holding about the same number of non-zeros.
+     * The kernel is compiled for several instruction sets and the one selected by active_isa() is run. C must not overlap with B.
+     *
+     * @tparam T scalar type of the result
+     * @tparam S scalar type of the sparse operand
+     * @tparam OpB type of the dense operand
+     * @param m number of rows of A and C
+     * @param n number of columns of B and C
+     * @param A sparse operand
+     * @param B dense operand
+     * @param C pointer to the first element of the row-major result
+     * @param ldc leading dimension of C
+     */
+    template <typename T, typename S, typename OpB>
+    void csr_times_dense(int m, int n, const CompressedOperand<S>& A, const OpB& B, T* C, int ldc)
+    {
+        if (m <= 0 || n <= 0)
+            return;
+        _implementation_details::parallel_for_outer(m, A.offsets, sparse_is_parallel(A.offsets[m], n),
+                                                    [&](int i0, int i1) { dispatch<_implementation_details::CsrTimesDense>(i0, i1, n, A, B, C, ldc); });
+    }
+
+    /**
+     * @brief Computes C = A * B, where A is an m x k CSC matrix and B a dense k x n operand.
+     *
+     * The columns of A scatter into the rows of C. Products with several columns are split on the thread pool by column blocks of C.
+     * Products with a vector are split by ranges of columns of A, each accumulated into its own vector, and the vectors are then added in order.
+     *
+     * @tparam T scalar type of the result
+     * @tparam S scalar type of the sparse operand
+     * @tparam OpB type of the dense operand
+     * @param m number of rows of A and C
+     * @param n number of columns of B and C
+     * @param k number of columns of A and rows of B
+     * @param A sparse operand
+     * @param B dense operand
+     * @param C pointer to the first element of the row-major result
+     * @param ldc leading dimension of C
+     */
+    template <typename T, typename S, typename OpB>
+    void csc_times_dense(int m, int n, int k, const CompressedOperand<S>& A, const OpB& B, T* C, int ldc)
+    {
+        if (m <= 0 || n <= 0)
+            return;
+        for (int i = 0; i < m; ++i)
+            std::fill_n(C + static_cast<std::ptrdiff_t>(i) * ldc, n, T(0));
+
+        const bool parallel = sparse_is_parallel(A.offsets[k], n);
+        if (!parallel)
+        {
+            dispatch<_implementation_details::CscTimesDense>(0, k, 0, n, A, B, C, ldc);
+            return;
+        }
+
+        if (n > 1)
+        {
+            const int n_blocks = std::min(n, num_threads());
+            parallel_for(n_blocks, [&](int b) { dispatch<_implementation_details::CscTimesDense>(0, k, n * b / n_blocks, n * (b + 1) / n_blocks, A, B, C, ldc); });
+            return;
+        }
+
+        const int n_tasks = std::min(k, 4 * num_threads());
+        const std::vector<int> bounds = _implementation_details::outer_bounds(k, A.offsets, n_tasks);
+        std::vector<std::vector<T>> partials(n_tasks);
+        parallel_for(n_tasks,
+                     [&](int t)
+                     {
+                         partials[t].assign(m, T(0));
+                         dispatch<_implementation_details::CscTimesDense>(bounds[t], bounds[t + 1], 0, 1, A, B, partials[t].data(), 1);
+                     });
+        for (const std::vector<T>& y : partials)
+            for (int i = 0; i < m; ++i)
+                C[static_cast<std::ptrdiff_t>(i) * ldc] += y[i];
+    }
+
+    /**
+     * @brief Computes C = A * B, where A is a dense m x k operand and B a k x n CSR matrix. The rows of C are computed on the thread pool for large products.
+     *
+     * @tparam T scalar type of the result
+     * @tparam S scalar type of the sparse operand
+     * @tparam OpA type of the dense operand
+     * @param m number of rows of A and C
+     * @param n number of columns of B and C
+     * @param k number of columns of A and rows of B
+     * @param A dense operand
+     * @param B sparse operand
+     * @param C pointer to the first element of the row-major result
+     * @param ldc leading dimension of C
+     */
+    template <typename T, typename S, typename OpA>
+    void dense_times_csr(int m, int n, int k, const OpA& A, const CompressedOperand<S>& B, T* C, int ldc)
+    {
+        if (m <= 0 || n <= 0)
+            return;
+        const auto run_rows = [&](int i0, int i1) { dispatch<_implementation_details::DenseTimesCsr>(i0, i1, n, k, A, B, C, ldc); };
+        if (!sparse_is_parallel(B.offsets[k], m))
+        {
+            run_rows(0, m);
+            return;
+        }
+        const int n_tasks = std::min(m, 4 * num_threads());
+        parallel_for(n_tasks, [&](int t) { run_rows(m * t / n_tasks, m * (t + 1) / n_tasks); });
+    }
+
+    /**
+     * @brief Computes C = A * B, where A is a dense m x k operand and B a k x n CSC matrix. The rows of C are computed on the thread pool for large products.
+     *
+     * @tparam T scalar type of the result
+     * @tparam S scalar type of the sparse operand
+     * @tparam OpA type of the dense operand
+     * @param m number of rows of A and C
+     * @param n number of columns of B and C
+     * @param A dense operand
+     * @param B sparse operand
+     * @param C pointer to the first element of the row-major result
+     * @param ldc leading dimension of C
+     */
+    template <typename T, typename S, typename OpA>
+    void dense_times_csc(int m, int n, const OpA& A, const CompressedOperand<S>& B, T* C, int ldc)
+    {
+        if (m <= 0 || n <= 0)
+            return;
+        const auto run_rows = [&](int i0, int i1) { dispatch<_implementation_details::DenseTimesCsc>(i0, i1, n, A, B, C, ldc); };
+        if (!sparse_is_parallel(B.offsets[n], m))
+        {
+            run_rows(0, m);
+            return;
+        }
+        const int n_tasks = std::min(m, 4 * num_threads());
+        parallel_for(n_tasks, [&](int t) { run_rows(m * t / n_tasks, m * (t + 1) / n_tasks); });
+    }
+
+    /**
+     * @brief Computes the product C = A * B of two CSR matrices, A being m x k and B k x n, with Gustavson's algorithm.
+     *
+     * Each row of C is accumulated in a dense scratch row, the non-zeros touched being tracked so that the scratch row is never cleared.
+     * Products which cancel out are kept as explicit zeros.
+     *
+     * @tparam T scalar type of the result
+     * @tparam SA scalar type of the left operand
+     * @tparam SB scalar type of the right operand
+     * @param m number of rows of A and C
+     * @param n number of columns of B and C
+     * @param A left sparse operand
+     * @param B right sparse operand
+     * @return CompressedArrays<T> the CSR arrays of C
+     */
+    template <typename T, typename SA, typename SB>
+    CompressedArrays<T> csr_times_csr(int m, int n, const CompressedOperand<SA>& A, const CompressedOperand<SB>& B)
+    {
+        CompressedArrays<T> C;
+        C.offsets.assign(m + 1, 0);
+        std::vector<T> row(n);
+        std::vector<int> last_row(n, -1);
+        std::vector<int> row_indices;
+
+        for (int i = 0; i < m; ++i)
+        {
+            row_indices.clear();
+            for (int p = A.offsets[i]; p < A.offsets[i + 1]; ++p)
+            {
+                const T a = static_cast<T>(A.values[p]);
+                const int k = A.indices[p];
+                for (int q = B.offsets[k]; q < B.offsets[k + 1]; ++q)
+                {
+                    const int j = B.indices[q];
+                    if (last_row[j] != i)
+                    {
+                        last_row[j] = i;
+                        row[j] = a * static_cast<T>(B.values[q]);
+                        row_indices.push_back(j);
+                    }
+                    else
+                        row[j] += a * static_cast<T>(B.values[q]);
+                }
+            }
+
+            std::ranges::sort(row_indices);
+            for (int j : row_indices)
+            {
+                C.indices.push_back(j);
+                C.values.push_back(row[j]);
+            }
+            C.offsets[i + 1] = static_cast<int>(C.indices.size());
+        }
+        return C;
+    }
+
+    /**
+     * @brief Returns the compressed arrays with outer and inner indices swapped: the CSC arrays of a CSR matrix, or the CSR arrays of a CSC one.
+     *
+     * It is a counting sort on the inner indices, hence the inner indices of the result are sorted.
+     *
+     * @tparam T scalar type
+     * @param outer outer size of A
+     * @param inner inner size of A
+     * @param A sparse operand
+     */
+    template <typename T>
+    CompressedArrays<T> swap_compression(int outer, int inner, const CompressedOperand<T>& A)
+    {
+        const int nnz = A.offsets[outer];
+        CompressedArrays<T> res;
+        res.offsets.assign(inner + 1, 0);
+        res.indices.resize(nnz);
+        res.values.resize(nnz);
+
+        for (int q = 0; q < nnz; ++q)
+            ++res.offsets[A.indices[q] + 1];
+        std::partial_sum(res.offsets.begin(), res.offsets.end(), res.offsets.begin());
+
+        std::vector<int> next(res.offsets.begin(), res.offsets.end() - 1);
+        for (int o = 0; o < outer; ++o)
+            for (int q = A.offsets[o]; q < A.offsets[o + 1]; ++q)
+            {
+                const int dst = next[A.indices[q]]++;
+                res.indices[dst] = o;
+                res.values[dst] = A.values[q];
+            }
+        return res;
+    }
+}
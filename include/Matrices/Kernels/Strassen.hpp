@@ -0,0 +1,162 @@
+#pragma once
+
+#include <Matrices/Kernels/Gemm.hpp>
+#include <stdafx.hpp>
+
+namespace LinAlg::Matrices::Kernels
+{
+    /**
+     * @brief Default size below which strassen() falls back to gemm(). Measured with the mult_two_mat_strassen benchmarks.
+     */
+    inline constexpr int strassen_default_cutoff = 256;
+
+    namespace _implementation_details
+    {
+        /**
+         * @brief Computes c = op(a, b) element wise on rows x cols blocks of row-major matrices. Large blocks are split by rows on the thread pool.
+         */
+        template <typename T, typename Op>
+        void combine_blocks(int rows, int cols, const T* a, int lda, const T* b, int ldb, T* c, int ldc, Op op)
+        {
+            const auto combine_rows = [&](int i0, int i1)
+            {
+                for (int i = i0; i < i1; ++i)
+                {
+                    const T* a_row = a + static_cast<std::ptrdiff_t>(i) * lda;
+                    const T* b_row = b + static_cast<std::ptrdiff_t>(i) * ldb;
+                    T* c_row = c + static_cast<std::ptrdiff_t>(i) * ldc;
+                    for (int j = 0; j < cols; ++j)
+                        c_row[j] = op(a_row[j], b_row[j]);
+                }
+            };
+
+            constexpr int rows_per_task = 64;
+            if (num_threads() > 1 && static_cast<long long>(rows) * cols >= 256 * 256)
+                parallel_for((rows + rows_per_task - 1) / rows_per_task,
+                             [&](int task) { combine_rows(task * rows_per_task, std::min(rows, (task + 1) * rows_per_task)); });
+            else
+                combine_rows(0, rows);
+        }
+
+        template <typename T>
+        void add_blocks(int rows, int cols, const T* a, int lda, const T* b, int ldb, T* c, int ldc)
+        {
+            combine_blocks(rows, cols, a, lda, b, ldb, c, ldc, std::plus<>());
+        }
+
+        template <typename T>
+        void sub_blocks(int rows, int cols, const T* a, int lda, const T* b, int ldb, T* c, int ldc)
+        {
+            combine_blocks(rows, cols, a, lda, b, ldb, c, ldc, std::minus<>());
+        }
+
+        /**
+         * @brief Computes C = A * B with the Strassen-Winograd recursion on the largest even sized leading block, and fixes up the peeled
+         * last row, column and inner index with gemm() and a rank one update.
+         */
+        template <typename T>
+        void strassen_recursion(int m, int n, int k, const T* A, int lda, const T* B, int ldb, T* C, int ldc, int cutoff)
+        {
+            if (std::min({ m, n, k }) <= std::max(cutoff, 1))
+            {
+                gemm(m, n, k, StridedOperand<T> { A, lda, 1 }, StridedOperand<T> { B, ldb, 1 }, C, ldc);
+                return;
+            }
+
+            const int m2 = m / 2;
+            const int n2 = n / 2;
+            const int k2 = k / 2;
+            const auto offset = [](auto* ptr, int i, int j, int ld) { return ptr + static_cast<std::ptrdiff_t>(i) * ld + j; };
+
+            const T* A11 = A;
+            const T* A12 = offset(A, 0, k2, lda);
+            const T* A21 = offset(A, m2, 0, lda);
+            const T* A22 = offset(A, m2, k2, lda);
+            const T* B11 = B;
+            const T* B12 = offset(B, 0, n2, ldb);
+            const T* B21 = offset(B, k2, 0, ldb);
+            const T* B22 = offset(B, k2, n2, ldb);
+            T* C11 = C;
+            T* C12 = offset(C, 0, n2, ldc);
+            T* C21 = offset(C, m2, 0, ldc);
+            T* C22 = offset(C, m2, n2, ldc);
+
+            // Winograd's variant: 7 products and 15 additions, scheduled so that only three temporaries are needed.
+            std::vector<T> X(static_cast<std::size_t>(m2) * k2);
+            std::vector<T> Y(static_cast<std::size_t>(k2) * n2);
+            std::vector<T> Z(static_cast<std::size_t>(m2) * n2);
+
+            add_blocks(m2, k2, A21, lda, A22, lda, X.data(), k2); // S1 = A21 + A22
+            sub_blocks(k2, n2, B12, ldb, B11, ldb, Y.data(), n2); // T1 = B12 - B11
+            strassen_recursion(m2, n2, k2, X.data(), k2, Y.data(), n2, C22, ldc, cutoff); // P5 = S1 T1
+
+            sub_blocks(m2, k2, X.data(), k2, A11, lda, X.data(), k2); // S2 = S1 - A11
+            sub_blocks(k2, n2, B22, ldb, Y.data(), n2, Y.data(), n2); // T2 = B22 - T1
+            strassen_recursion(m2, n2, k2, X.data(), k2, Y.data(), n2, C21, ldc, cutoff); // P6 = S2 T2
+
+            sub_blocks(m2, k2, A12, lda, X.data(), k2, X.data(), k2); // S4 = A12 - S2
+            strassen_recursion(m2, n2, k2, X.data(), k2, B22, ldb, C12, ldc, cutoff); // P3 = S4 B22
+
+            sub_blocks(k2, n2, Y.data(), n2, B21, ldb, Y.data(), n2); // T4 = T2 - B21
+            strassen_recursion(m2, n2, k2, A22, lda, Y.data(), n2, C11, ldc, cutoff); // P4 = A22 T4
+
+            strassen_recursion(m2, n2, k2, A11, lda, B11, ldb, Z.data(), n2, cutoff); // P1 = A11 B11
+            add_blocks(m2, n2, C21, ldc, Z.data(), n2, C21, ldc); // U2 = P1 + P6
+            add_blocks(m2, n2, C12, ldc, C21, ldc, C12, ldc);     // U2 + P3
+            add_blocks(m2, n2, C12, ldc, C22, ldc, C12, ldc);     // U5 = U2 + P5 + P3
+            add_blocks(m2, n2, C22, ldc, C21, ldc, C22, ldc);     // U4 = U2 + P5
+            sub_blocks(m2, n2, C21, ldc, C11, ldc, C21, ldc);     // U2 - P4
+
+            strassen_recursion(m2, n2, k2, A12, lda, B21, ldb, C11, ldc, cutoff); // P2 = A12 B21
+            add_blocks(m2, n2, C11, ldc, Z.data(), n2, C11, ldc);                  // U1 = P1 + P2
+
+            sub_blocks(m2, k2, A11, lda, A21, lda, X.data(), k2); // S3 = A11 - A21
+            sub_blocks(k2, n2, B22, ldb, B12, ldb, Y.data(), n2); // T3 = B22 - B12
+            strassen_recursion(m2, n2, k2, X.data(), k2, Y.data(), n2, Z.data(), n2, cutoff); // P7 = S3 T3
+            add_blocks(m2, n2, C21, ldc, Z.data(), n2, C21, ldc); // U6 = U2 - P4 + P7
+            add_blocks(m2, n2, C22, ldc, Z.data(), n2, C22, ldc); // U7 = U4 + P7
+
+            // Peeling: contribution of the last inner index, then the last column and row of C.
+            if (k % 2 == 1)
+                for (int i = 0; i < 2 * m2; ++i)
+                {
+                    const T a = A[static_cast<std::ptrdiff_t>(i) * lda + k - 1];
+                    const T* b_row = offset(B, k - 1, 0, ldb);
+                    T* c_row = offset(C, i, 0, ldc);
+                    for (int j = 0; j < 2 * n2; ++j)
+                        c_row[j] += a * b_row[j];
+                }
+            if (n % 2 == 1)
+                gemm(m, 1, k, StridedOperand<T> { A, lda, 1 }, StridedOperand<T> { B + n - 1, ldb, 1 }, C + n - 1, ldc);
+            if (m % 2 == 1)
+                gemm(1, 2 * n2, k, StridedOperand<T> { offset(A, m - 1, 0, lda), lda, 1 }, StridedOperand<T> { B, ldb, 1 }, offset(C, m - 1, 0, ldc), ldc);
+        }
+    }
+
+    /**
+     * @brief Computes C = A * B with the Strassen-Winograd algorithm.
+     *
+     * The problem is split in 2 x 2 blocks and computed with 7 block products instead of 8, recursively, until one dimension is not larger than
+     * cutoff; below it the products are computed by gemm(). Odd sizes are handled by peeling the last row, column and inner index.
+     * It needs O(n^2.81) operations but is slightly less accurate than the standard product: the error bound grows with the number of recursion levels.
+     *
+     * @tparam T scalar type
+     * @param m number of rows of A and C
+     * @param n number of columns of B and C
+     * @param k number of columns of A and rows of B
+     * @param A pointer to the first element of the row-major left operand
+     * @param lda leading dimension of A
+     * @param B pointer to the first element of the row-major right operand
+     * @param ldb leading dimension of B
+     * @param C pointer to the first element of the row-major result
+     * @param ldc leading dimension of C
+     * @param cutoff size below which gemm() is used
+     */
+    template <typename T>
+    void strassen(int m, int n, int k, const T* A, int lda, const T* B, int ldb, T* C, int ldc, int cutoff = strassen_default_cutoff)
+    {
+        if (m <= 0 || n <= 0)
+            return;
+        _implementation_details::strassen_recursion(m, n, k, A, lda, B, ldb, C, ldc, cutoff);
+    }
+}
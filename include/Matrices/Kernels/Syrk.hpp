@@ -0,0 +1,162 @@
+#pragma once
+
+#include <Matrices/Kernels/Dispatch.hpp>
+#include <Matrices/Kernels/Gemm.hpp>
+#include <Matrices/Kernels/Operands.hpp>
+#include <Matrices/Kernels/ThreadPool.hpp>
+#include <stdafx.hpp>
+
+namespace LinAlg::Matrices::Kernels
+{
+    /**
+     * @brief The triangle of a square matrix computed by syrk().
+     */
+    enum class Triangle
+    {
+        Lower, ///< The coefficients (i, j) with j <= i.
+        Upper  ///< The coefficients (i, j) with j >= i.
+    };
+
+    namespace _implementation_details
+    {
+        /**
+         * @brief Returns true if the coefficient (i, j) is in the triangle.
+         */
+        inline bool in_triangle(int i, int j, Triangle uplo)
+        {
+            return uplo == Triangle::Lower ? j <= i : j >= i;
+        }
+
+        /**
+         * @brief Products too small for packing to pay off: each coefficient of the triangle is a dot product of two rows of A.
+         */
+        struct SmallSyrk
+        {
+            template <typename T, typename OpA>
+            static void run(int n, int k, const OpA& A, T* C, int ldc, Triangle uplo, T alpha, T beta)
+            {
+                for (int i = 0; i < n; ++i)
+                {
+                    T* c_row = C + static_cast<std::ptrdiff_t>(i) * ldc;
+                    const int j0 = uplo == Triangle::Lower ? 0 : i;
+                    const int j1 = uplo == Triangle::Lower ? i + 1 : n;
+                    for (int j = j0; j < j1; ++j)
+                    {
+                        T sum = T(0);
+                        for (int p = 0; p < k; ++p)
+                            sum += static_cast<T>(A(i, p)) * static_cast<T>(A(j, p));
+                        c_row[j] = beta == T(0) ? alpha * sum : beta * c_row[j] + alpha * sum;
+                    }
+                }
+            }
+        };
+
+        /**
+         * @brief Computes the block [i0, i1) x [j0, j1) of the triangle of C with the GEMM kernel.
+         *
+         * Blocks off the diagonal are entirely in the triangle and are written directly. Diagonal blocks are computed in full into a scratch buffer,
+         * and only their triangle is written back, so that the other triangle of C is never touched.
+         */
+        struct SyrkBlock
+        {
+            template <typename T, typename OpA>
+            static void run(int i0, int i1, int j0, int j1, int k, const OpA& A, T* C, int ldc, Triangle uplo, T alpha, T beta)
+            {
+                const auto A_t = transpose(A);
+                const OffsetOperand<OpA> rows { A, i0, 0 };
+                const OffsetOperand<decltype(A_t)> cols { A_t, 0, j0 };
+                T* c_block = C + static_cast<std::ptrdiff_t>(i0) * ldc + j0;
+                if (i0 != j0)
+                {
+                    Gemm::run(i1 - i0, j1 - j0, k, rows, cols, c_block, ldc, alpha, beta);
+                    return;
+                }
+
+                const int nb = i1 - i0;
+                T* diagonal = packing_buffer<T, 4>(static_cast<std::size_t>(nb) * nb);
+                Gemm::run(nb, nb, k, rows, cols, diagonal, nb, alpha, T(0));
+                for (int i = 0; i < nb; ++i)
+                    for (int j = 0; j < nb; ++j)
+                        if (in_triangle(i, j, uplo))
+                        {
+                            T& c = c_block[static_cast<std::ptrdiff_t>(i) * ldc + j];
+                            c = diagonal[static_cast<std::ptrdiff_t>(i) * nb + j] + (beta == T(0) ? T(0) : beta * c);
+                        }
+            }
+        };
+    }
+
+    /**
+     * @brief Computes the triangle uplo of C = alpha * A * A^T + beta * C, where A is an n x k operand (symmetric rank-k update).
+     *
+     * Since C is symmetric, only the blocks of one triangle are computed, which halves the number of operations of the general product.
+     * C is split into square blocks of at most BlockSizes<T>::MC rows, each computed with the GEMM kernel; A^T is read through a transposed view of A,
+     * hence it is never stored. The blocks are computed independently on the thread pool for large products.
+     * The other triangle of C is neither read nor written (see mirror_triangle). If beta is zero, C is not read.
+     * Pass transpose(A) to compute A^T * A.
+     *
+     * @tparam T scalar type of the result
+     * @tparam OpA type of the operand
+     * @param n number of rows of A, and of rows and columns of C
+     * @param k number of columns of A
+     * @param A operand
+     * @param C pointer to the first element of the row-major result
+     * @param ldc leading dimension of C
+     * @param uplo triangle of C to compute
+     * @param alpha scaling of the product
+     * @param beta scaling of C
+     */
+    template <typename T, typename OpA>
+    void syrk(int n, int k, const OpA& A, T* C, int ldc, Triangle uplo = Triangle::Lower, std::type_identity_t<T> alpha = T(1),
+              std::type_identity_t<T> beta = T(0))
+    {
+        if (n <= 0)
+            return;
+        if (!gemm_is_profitable(n, n, k))
+        {
+            dispatch<_implementation_details::SmallSyrk>(n, k, A, C, ldc, uplo, alpha, beta);
+            return;
+        }
+
+        // At least 4 block rows, so that the diagonal blocks, computed in full, are a small part of the work.
+        const int nb = std::min(BlockSizes<T>::MC, std::max(32, ((n + 3) / 4 + 31) / 32 * 32));
+        const int n_blocks = (n + nb - 1) / nb;
+        std::vector<std::pair<int, int>> blocks;
+        blocks.reserve(static_cast<std::size_t>(n_blocks) * (n_blocks + 1) / 2);
+        for (int bi = 0; bi < n_blocks; ++bi)
+            for (int bj = 0; bj < n_blocks; ++bj)
+                if (_implementation_details::in_triangle(bi, bj, uplo))
+                    blocks.emplace_back(bi * nb, bj * nb);
+
+        const auto run_block = [&](int block)
+        {
+            const auto [i0, j0] = blocks[block];
+            dispatch<_implementation_details::SyrkBlock>(i0, std::min(i0 + nb, n), j0, std::min(j0 + nb, n), k, A, C, ldc, uplo, alpha, beta);
+        };
+        if (gemm_is_parallel(n, n, k))
+            parallel_for(static_cast<int>(blocks.size()), run_block);
+        else
+            for (int block = 0; block < static_cast<int>(blocks.size()); ++block)
+                run_block(block);
+    }
+
+    /**
+     * @brief Copies the triangle uplo of the n x n matrix C into the other one, so that C becomes a full symmetric matrix.
+     *
+     * The copy is done by square tiles, so that the transposed reads stay in cache.
+     */
+    template <typename T>
+    void mirror_triangle(int n, T* C, int ldc, Triangle uplo = Triangle::Lower)
+    {
+        constexpr int tile = 32;
+        const auto at = [&](int i, int j) -> T& { return C[static_cast<std::ptrdiff_t>(i) * ldc + j]; };
+        for (int i0 = 0; i0 < n; i0 += tile)
+            for (int j0 = 0; j0 <= i0; j0 += tile)
+                for (int i = i0; i < std::min(i0 + tile, n); ++i)
+                    for (int j = j0; j < std::min({ j0 + tile, n, i }); ++j)
+                        if (uplo == Triangle::Lower)
+                            at(j, i) = at(i, j);
+                        else
+                            at(i, j) = at(j, i);
+    }
+}
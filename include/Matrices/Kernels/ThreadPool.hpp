@@ -0,0 +1,314 @@
+#pragma once
+
+#include <stdafx.hpp>
+
+namespace LinAlg::Matrices::Kernels
+{
+    /**
+     * @brief A pool of persistent worker threads executing parallel loops.
+     *
+     * A loop of n_tasks independent tasks is executed by the calling thread together with the workers, each thread pulling the next task index
+     * from a shared counter. Nested loops, and loops started while the pool is busy with another caller, are executed serially by the caller.
+     * An exception thrown by a task stops the tasks not started yet, and is rethrown by run() once all the threads have left the loop.
+     */
+    class ThreadPool
+    {
+      public:
+        explicit ThreadPool(int n_workers);
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+        ~ThreadPool();
+
+        int workers() const { return static_cast<int>(m_workers.size()); } ///< Number of worker threads, the caller excluded.
+        void grow(int n_workers); ///< Adds workers up to n_workers, unless a loop is running.
+
+        template <typename Func>
+        void run(int n_tasks, int n_threads, Func&& f); ///< Runs f(task) for task in [0, n_tasks) on at most n_threads threads.
+
+      private:
+        struct Job
+        {
+            void (*call)(void*, int);
+            void* callable;
+            int n_tasks;
+            std::atomic<int> next { 0 };
+            std::mutex error_mutex {};
+            std::exception_ptr error {}; ///< First exception thrown by a task.
+        };
+
+        static void execute(Job& job) noexcept;
+        static bool& in_parallel_region();
+        void worker_loop(int id, std::size_t seen_generation);
+
+        std::vector<std::thread> m_workers;
+        std::mutex m_run_mutex;
+        std::mutex m_mutex;
+        std::condition_variable m_cv_start;
+        std::condition_variable m_cv_done;
+        Job* m_job { nullptr };
+        int m_job_workers { 0 };
+        int m_pending { 0 };
+        std::size_t m_generation { 0 };
+        bool m_stop { false };
+    };
+
+    int num_threads();
+    void set_num_threads(int n);
+    ThreadPool& thread_pool();
+
+    template <typename Func>
+    void parallel_for(int n_tasks, Func&& f);
+
+    template <typename Func>
+    void parallel_for_tiles(int m, int n, int align_m, int align_n, Func&& f);
+}
+
+/*
+    Implementation
+    -----------------------------------------------------------------------------------------
+*/
+namespace LinAlg::Matrices::Kernels
+{
+    inline ThreadPool::ThreadPool(int n_workers)
+    {
+        grow(n_workers);
+    }
+
+    inline ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_stop = true;
+        }
+        m_cv_start.notify_all();
+        for (auto& worker : m_workers)
+            worker.join();
+    }
+
+    /**
+     * @brief Adds workers until there are n_workers. The pool is never replaced, as other threads may be running loops on it: if a loop
+     * is running, the pool is left as is and will grow on a later call.
+     */
+    inline void ThreadPool::grow(int n_workers)
+    {
+        std::unique_lock run_lock(m_run_mutex, std::try_to_lock);
+        if (!run_lock)
+            return;
+
+        std::size_t generation;
+        {
+            std::lock_guard lock(m_mutex);
+            generation = m_generation;
+        }
+        // The new workers skip the generations already started.
+        for (int id = workers(); id < n_workers; ++id)
+            m_workers.emplace_back([this, id, generation] { worker_loop(id, generation); });
+    }
+
+    inline bool& ThreadPool::in_parallel_region()
+    {
+        thread_local bool in_region = false;
+        return in_region;
+    }
+
+    inline void ThreadPool::execute(Job& job) noexcept
+    {
+        struct RegionGuard
+        {
+            bool previous = std::exchange(in_parallel_region(), true);
+            ~RegionGuard() { in_parallel_region() = previous; }
+        } guard;
+
+        try
+        {
+            for (int task = job.next.fetch_add(1); task < job.n_tasks; task = job.next.fetch_add(1))
+                job.call(job.callable, task);
+        }
+        catch (...)
+        {
+            std::lock_guard lock(job.error_mutex);
+            if (!job.error)
+                job.error = std::current_exception();
+            job.next.store(job.n_tasks);
+        }
+    }
+
+    inline void ThreadPool::worker_loop(int id, std::size_t seen_generation)
+    {
+        while (true)
+        {
+            Job* job = nullptr;
+            {
+                std::unique_lock lock(m_mutex);
+                m_cv_start.wait(lock, [&] { return m_stop || m_generation != seen_generation; });
+                if (m_stop)
+                    return;
+                seen_generation = m_generation;
+                if (id >= m_job_workers)
+                    continue;
+                job = m_job;
+            }
+
+            execute(*job);
+
+            std::lock_guard lock(m_mutex);
+            if (--m_pending == 0)
+                m_cv_done.notify_one();
+        }
+    }
+
+    template <typename Func>
+    void ThreadPool::run(int n_tasks, int n_threads, Func&& f)
+    {
+        std::unique_lock run_lock(m_run_mutex, std::defer_lock);
+        const bool serial = in_parallel_region() || !run_lock.try_lock();
+        const int n_workers = serial ? 0 : std::min({ n_threads - 1, workers(), n_tasks - 1 });
+        if (n_workers <= 0)
+        {
+            for (int task = 0; task < n_tasks; ++task)
+                f(task);
+            return;
+        }
+
+        using F = std::remove_reference_t<Func>;
+        Job job { [](void* callable, int task) { (*static_cast<F*>(callable))(task); }, const_cast<void*>(static_cast<const void*>(std::addressof(f))), n_tasks };
+        {
+            std::lock_guard lock(m_mutex);
+            m_job = &job;
+            m_job_workers = n_workers;
+            m_pending = n_workers;
+            ++m_generation;
+        }
+        m_cv_start.notify_all();
+
+        execute(job);
+
+        // The workers hold a pointer to the job until they are done, even if a task has thrown.
+        {
+            std::unique_lock lock(m_mutex);
+            m_cv_done.wait(lock, [this] { return m_pending == 0; });
+            m_job = nullptr;
+        }
+        if (job.error)
+            std::rethrow_exception(job.error);
+    }
+
+    namespace _implementation_details
+    {
+        inline std::atomic<int>& num_threads_state()
+        {
+            static std::atomic<int> n = []
+            {
+                if (const char* env = std::getenv("LINALG_NUM_THREADS"))
+                    if (int value = std::atoi(env); value > 0)
+                        return value;
+                return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+            }();
+            return n;
+        }
+    }
+
+    /**
+     * @brief Returns the number of threads used by the parallel kernels.
+     *
+     * Defaults to the number of hardware threads, or to the value of the LINALG_NUM_THREADS environment variable if set.
+     */
+    inline int num_threads()
+    {
+        return _implementation_details::num_threads_state().load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Sets the number of threads used by the parallel kernels. Values smaller than one select the number of hardware threads.
+     *
+     * It must not be called while parallel kernels are running in other threads.
+     */
+    inline void set_num_threads(int n)
+    {
+        if (n < 1)
+            n = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+        _implementation_details::num_threads_state().store(n, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Returns the global thread pool. It holds num_threads() - 1 workers, the calling thread being the last one.
+     *
+     * The pool grows if the number of threads has been increased since its creation, but is never replaced (see ThreadPool::grow).
+     */
+    inline ThreadPool& thread_pool()
+    {
+        static std::mutex mutex;
+        static ThreadPool pool(0);
+
+        std::lock_guard lock(mutex);
+        if (pool.workers() < num_threads() - 1)
+            pool.grow(num_threads() - 1);
+        return pool;
+    }
+
+    /**
+     * @brief Runs f(task) for every task in [0, n_tasks) on the global thread pool.
+     *
+     * @tparam Func callable type
+     * @param n_tasks number of independent tasks
+     * @param f callable taking the task index
+     */
+    template <typename Func>
+    void parallel_for(int n_tasks, Func&& f)
+    {
+        const int n = num_threads();
+        if (n <= 1 || n_tasks <= 1)
+        {
+            for (int task = 0; task < n_tasks; ++task)
+                f(task);
+            return;
+        }
+        thread_pool().run(n_tasks, n, f);
+    }
+
+    /**
+     * @brief Splits an m x n output into a 2D grid of tiles and processes them on the global thread pool.
+     *
+     * The grid is refined along the longest tile dimension until there are at least two tiles per thread, so that the load stays balanced.
+     * Tile sizes are multiples of align_m and align_n, except for the last row and column of tiles.
+     *
+     * @tparam Func callable type
+     * @param m number of rows of the output
+     * @param n number of columns of the output
+     * @param align_m rows alignment of the tiles
+     * @param align_n columns alignment of the tiles
+     * @param f callable taking the tile bounds (i0, i1, j0, j1), with rows in [i0, i1) and columns in [j0, j1)
+     */
+    template <typename Func>
+    void parallel_for_tiles(int m, int n, int align_m, int align_n, Func&& f)
+    {
+        const int target = 2 * num_threads();
+        int grid_m = 1;
+        int grid_n = 1;
+        while (grid_m * grid_n < target)
+        {
+            const bool can_split_m = m / (grid_m + 1) >= align_m;
+            const bool can_split_n = n / (grid_n + 1) >= align_n;
+            if (can_split_m && (!can_split_n || m / grid_m >= n / grid_n))
+                ++grid_m;
+            else if (can_split_n)
+                ++grid_n;
+            else
+                break;
+        }
+
+        const auto round_up = [](int value, int align) { return (value + align - 1) / align * align; };
+        const int tile_m = round_up((m + grid_m - 1) / grid_m, align_m);
+        const int tile_n = round_up((n + grid_n - 1) / grid_n, align_n);
+        const int tiles_m = (m + tile_m - 1) / tile_m;
+        const int tiles_n = (n + tile_n - 1) / tile_n;
+
+        parallel_for(tiles_m * tiles_n,
+                     [&](int task)
+                     {
+                         const int i0 = (task / tiles_n) * tile_m;
+                         const int j0 = (task % tiles_n) * tile_n;
+                         f(i0, std::min(i0 + tile_m, m), j0, std::min(j0 + tile_n, n));
+                     });
+    }
+}
@@ -1,16 +1,29 @@
 #pragma once
 
+#include <Matrices/Common/Allocator.hpp>
 #include <Matrices/RG/Concepts.hpp>
+#include <Matrices/RG/ForwardDeclarations.hpp>
 #include <Matrices/RG/Iterator.hpp>
 
 namespace LinAlg::Matrices::RG
 {
-    template <typename T>
-    void swap(Container<T>& first, Container<T>& second) noexcept;
-
-    template <typename T>
+    template <typename T, int InlineCapacity>
+    void swap(Container<T, InlineCapacity>& first, Container<T, InlineCapacity>& second) noexcept;
+
+    /**
+     * @brief A fixed size array of T, whose storage is aligned to a cache line.
+     *
+     * Up to InlineCapacity values are stored in a buffer inside the Container, so that the small matrices are never allocated on the heap.
+     * Moving or swapping such a Container copies its values, as the buffer cannot change owner; larger ones swap their heap pointers.
+     *
+     * @tparam T value type
+     * @tparam InlineCapacity maximum number of values stored inside the Container, 0 to always allocate on the heap
+     */
+    template <typename T, int InlineCapacity>
     class Container
     {
+        static_assert(InlineCapacity >= 0, "The inline capacity cannot be negative.");
+
       public:
         using value_type = T;
         using iterator = Iterator<T>;
@@ -21,10 +34,10 @@ namespace LinAlg::Matrices::RG
         Container(Container&& other) noexcept;
         template <Concepts::sized_input_range R>
         Container(const R& range);
-        ~Container() { delete[] m_data; }
+        ~Container();
 
         Container& operator=(Container other) noexcept;
-        friend void swap<T>(Container<T>& first, Container<T>& second);
+        friend void swap<T, InlineCapacity>(Container<T, InlineCapacity>& first, Container<T, InlineCapacity>& second) noexcept;
 
         iterator begin();
         iterator end();
@@ -36,95 +49,166 @@ namespace LinAlg::Matrices::RG
         T& operator[](int index) { return m_data[index]; }
         T operator[](int index) const { return m_data[index]; }
 
+        T* data() { return m_data; }
+        const T* data() const { return m_data; }
+
         int size() const;
+        bool is_inline() const { return m_size > 0 && m_size <= InlineCapacity; } ///< Returns whether the values are stored inside the Container.
 
       private:
+        T* allocate(int size);
+        void release() noexcept;
+        void steal(Container& other) noexcept;
+
         int m_size;
         T* m_data { nullptr };
+        alignas(Common::cache_line_size) std::byte m_buffer[std::max(InlineCapacity, 1) * sizeof(T)];
     };
 
-    template <typename T>
-    Container<T>::Container(int size)
+    /**
+     * @brief Allocates size default initialized values, in the inline buffer if they fit or else on the heap, aligned to a cache line.
+     */
+    template <typename T, int InlineCapacity>
+    T* Container<T, InlineCapacity>::allocate(int size)
+    {
+        if (size <= 0)
+            return nullptr;
+        T* data = size <= InlineCapacity ? reinterpret_cast<T*>(m_buffer) : Common::AlignedAllocator<T>().allocate(size);
+        std::uninitialized_default_construct_n(data, size);
+        return data;
+    }
+
+    /**
+     * @brief Destroys the values and frees the heap storage. The Container is left empty.
+     */
+    template <typename T, int InlineCapacity>
+    void Container<T, InlineCapacity>::release() noexcept
+    {
+        if (m_data)
+        {
+            std::destroy_n(m_data, m_size);
+            if (!is_inline())
+                Common::AlignedAllocator<T>().deallocate(m_data, m_size);
+        }
+        m_size = 0;
+        m_data = nullptr;
+    }
+
+    /**
+     * @brief Takes the values of other, which is left empty, into this empty Container. The inline values are moved into the own buffer.
+     */
+    template <typename T, int InlineCapacity>
+    void Container<T, InlineCapacity>::steal(Container& other) noexcept
+    {
+        if (other.is_inline())
+        {
+            m_data = reinterpret_cast<T*>(m_buffer);
+            std::uninitialized_move_n(other.m_data, other.m_size, m_data);
+            m_size = other.m_size;
+            other.release();
+        }
+        else
+        {
+            m_size = std::exchange(other.m_size, 0);
+            m_data = std::exchange(other.m_data, nullptr);
+        }
+    }
+
+    template <typename T, int InlineCapacity>
+    Container<T, InlineCapacity>::Container(int size)
         : m_size(size)
-        , m_data(size > 0 ? new T[size] : nullptr) {};
+        , m_data(allocate(size)) {};
 
-    template <typename T>
-    Container<T>::Container(const Container& other)
+    template <typename T, int InlineCapacity>
+    Container<T, InlineCapacity>::Container(const Container& other)
         : m_size(other.m_size)
-        , m_data(other.m_size > 0 ? new T[m_size] : nullptr)
+        , m_data(allocate(other.m_size))
     {
         if (m_data)
             std::copy(other.cbegin(), other.cend(), m_data);
     }
 
-    template <typename T>
-    Container<T>::Container(Container&& other) noexcept
-        : Container(0)
+    template <typename T, int InlineCapacity>
+    Container<T, InlineCapacity>::~Container()
     {
-        swap(*this, other);
+        release();
+    }
+
+    template <typename T, int InlineCapacity>
+    Container<T, InlineCapacity>::Container(Container&& other) noexcept
+        : m_size(0)
+    {
+        steal(other);
     }
 
-    template <typename T>
+    template <typename T, int InlineCapacity>
     template <Concepts::sized_input_range R>
-    Container<T>::Container(const R& range)
+    Container<T, InlineCapacity>::Container(const R& range)
         : Container(range.size())
     {
         std::copy(range.cbegin(), range.cend(), m_data);
     }
 
-    template <typename T>
-    Container<T>& Container<T>::operator=(Container other) noexcept
+    template <typename T, int InlineCapacity>
+    Container<T, InlineCapacity>& Container<T, InlineCapacity>::operator=(Container other) noexcept
     {
         swap(*this, other);
         return *this;
     }
 
-    template <typename T>
-    void swap(Container<T>& first, Container<T>& second) noexcept
+    template <typename T, int InlineCapacity>
+    void swap(Container<T, InlineCapacity>& first, Container<T, InlineCapacity>& second) noexcept
     {
         using std::swap;
-        swap(first.m_size, second.m_size);
-        swap(first.m_data, second.m_data);
+        if (!first.is_inline() && !second.is_inline())
+        {
+            swap(first.m_size, second.m_size);
+            swap(first.m_data, second.m_data);
+            return;
+        }
+        Container<T, InlineCapacity> tmp(std::move(first));
+        first.steal(second);
+        second.steal(tmp);
     }
 
-    template <typename T>
-    Container<T>::iterator Container<T>::begin()
+    template <typename T, int InlineCapacity>
+    Container<T, InlineCapacity>::iterator Container<T, InlineCapacity>::begin()
     {
         return iterator(m_data);
     }
 
-    template <typename T>
-    Container<T>::iterator Container<T>::end()
+    template <typename T, int InlineCapacity>
+    Container<T, InlineCapacity>::iterator Container<T, InlineCapacity>::end()
     {
         return iterator(m_data + m_size);
     }
 
-    template <typename T>
-    Container<T>::const_iterator Container<T>::begin() const
+    template <typename T, int InlineCapacity>
+    Container<T, InlineCapacity>::const_iterator Container<T, InlineCapacity>::begin() const
     {
         return const_iterator(m_data);
     }
 
-    template <typename T>
-    Container<T>::const_iterator Container<T>::end() const
+    template <typename T, int InlineCapacity>
+    Container<T, InlineCapacity>::const_iterator Container<T, InlineCapacity>::end() const
     {
         return const_iterator(m_data + m_size);
     }
 
-    template <typename T>
-    Container<T>::const_iterator Container<T>::cbegin() const
+    template <typename T, int InlineCapacity>
+    Container<T, InlineCapacity>::const_iterator Container<T, InlineCapacity>::cbegin() const
     {
         return begin();
     }
 
-    template <typename T>
-    Container<T>::const_iterator Container<T>::cend() const
+    template <typename T, int InlineCapacity>
+    Container<T, InlineCapacity>::const_iterator Container<T, InlineCapacity>::cend() const
     {
         return end();
     }
 
-    template <typename T>
-    int Container<T>::size() const
+    template <typename T, int InlineCapacity>
+    int Container<T, InlineCapacity>::size() const
     {
         return m_size;
     }
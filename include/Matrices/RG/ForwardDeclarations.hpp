@@ -22,8 +22,16 @@ namespace LinAlg::Matrices::RG
     template <typename T>
     class Identity;
 
-    template <typename T>
+    /**
+     * @brief Default number of coefficients stored inside a Container instead of on the heap: the matrices up to 4x4.
+     */
+    inline constexpr int default_inline_capacity = 16;
+
+    template <typename T, int InlineCapacity = default_inline_capacity>
     class Container;
+
+    template <typename T>
+    class MappedMatrix;
 }
 
 namespace LinAlg
@@ -35,6 +43,13 @@ namespace LinAlg
         using RGType = Cont;
     };
 
+    template <typename T>
+    struct traits<LinAlg::Matrices::RG::MappedMatrix<T>>
+    {
+        using Scalar = T;
+        using RGType = LinAlg::Matrices::Common::MappedArray<T>;
+    };
+
     template <typename View>
     struct traits<LinAlg::Matrices::RG::MatrixView<View>>
     {
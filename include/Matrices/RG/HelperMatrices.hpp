@@ -14,6 +14,7 @@ namespace LinAlg::Matrices::RG
       public:
         using Scalar = T;
         using RGType = constant_view_type<T>;
+        static constexpr Common::MatrixStructure structure = Common::MatrixStructure::Zero;
 
         Zero(int rows, int cols)
             : MatrixView<constant_view_type<T>>(rows, cols, _implementation_details::constant_view<T>(rows, cols, 0))
@@ -27,6 +28,7 @@ namespace LinAlg::Matrices::RG
       public:
         using Scalar = T;
         using RGType = constant_view_type<T>;
+        static constexpr Common::MatrixStructure structure = Common::MatrixStructure::Constant;
 
         Constant(int rows, int cols, const T& value)
             : MatrixView<constant_view_type<T>>(rows, cols, _implementation_details::constant_view<T>(rows, cols, value))
@@ -40,6 +42,7 @@ namespace LinAlg::Matrices::RG
       public:
         using Scalar = T;
         using RGType = identity_view_type<T>;
+        static constexpr Common::MatrixStructure structure = Common::MatrixStructure::Identity;
 
         Identity(int n)
             : MatrixView<identity_view_type<T>>(n, n, _implementation_details::identity_view<T>(n))
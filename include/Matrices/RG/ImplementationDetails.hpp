@@ -1,9 +1,32 @@
 #pragma once
 
 #include <Matrices/RG/Concepts.hpp>
+#include <Matrices/RG/Iterator.hpp>
 
 namespace LinAlg::Matrices::RG::_implementation_details
 {
+    /**
+     * @brief Returns a rows x cols MatrixView of the range data, whose coefficient (i, j) is data[offset + i * row_stride + j * col_stride].
+     *
+     * The view refers to data without copy (a container is taken by reference, a view is copied), and can be written to if data can.
+     */
+    template <std::ranges::random_access_range Data>
+    auto strided_view(Data&& data, int rows, int cols, int offset, int row_stride, int col_stride)
+    {
+        auto coefficient = [data = std::views::all(std::forward<Data>(data)), cols, offset, row_stride, col_stride](int k) -> decltype(auto)
+        { return data[offset + (k / cols) * row_stride + (k % cols) * col_stride]; };
+        auto view = std::views::iota(0, rows * cols) | std::views::transform(coefficient);
+        return MatrixView<decltype(view)>(rows, cols, std::move(view));
+    }
+
+    /**
+     * @brief Makes Derived a range over the coefficients of its data(), and adds the members returning views of its coefficients: block(),
+     * transpose(), row(), col() and diagonal(). The views are MatrixViews, hence they take part in the expressions and the products. The views
+     * of a const matrix are read-only.
+     *
+     * The rows of the matrices with a leading_dimension() are leading_dimension() coefficients apart in data(): their iterators and views
+     * skip the padding at the end of the rows.
+     */
     template <typename Derived>
     class RangeWrapper
     {
@@ -12,15 +35,66 @@ namespace LinAlg::Matrices::RG::_implementation_details
         const Derived& derived() const { return static_cast<const Derived&>(*this); }
 
       public:
-        auto begin() { return derived().data().begin(); }
-        auto end() { return derived().data().end(); }
-        auto begin() const { return derived().data().cbegin(); }
-        auto end() const { return derived().data().cend(); }
-        auto cbegin() const { return derived().data().cbegin(); }
-        auto cend() const { return derived().data().cend(); }
-
-        auto row(int i) const { return derived().data() | std::views::drop(i * derived().cols()) | std::views::take(derived().cols()); }
-        auto col(int j) const { return derived().data() | std::views::drop(j) | std::views::stride(derived().cols()) | std::views::take(derived().rows()); }
+        auto begin() { return coefficient_iterator<false>(derived(), derived().data().begin(), derived().data().end()); }
+        auto end() { return coefficient_iterator<true>(derived(), derived().data().begin(), derived().data().end()); }
+        auto begin() const { return cbegin(); }
+        auto end() const { return cend(); }
+        auto cbegin() const { return coefficient_iterator<false>(derived(), std::ranges::cbegin(derived().data()), std::ranges::cend(derived().data())); }
+        auto cend() const { return coefficient_iterator<true>(derived(), std::ranges::cbegin(derived().data()), std::ranges::cend(derived().data())); }
+
+        auto block(int i, int j, int rows, int cols) { return block_of(derived(), i, j, rows, cols); } ///< The rows x cols block starting at (i, j).
+        auto block(int i, int j, int rows, int cols) const { return block_of(derived(), i, j, rows, cols); }
+        auto row(int i) { return block_of(derived(), i, 0, 1, derived().cols()); } ///< The row i, as a 1 x cols matrix.
+        auto row(int i) const { return block_of(derived(), i, 0, 1, derived().cols()); }
+        auto col(int j) { return block_of(derived(), 0, j, derived().rows(), 1); } ///< The column j, as a rows x 1 matrix.
+        auto col(int j) const { return block_of(derived(), 0, j, derived().rows(), 1); }
+        auto transpose() { return transpose_of(derived()); } ///< The transpose, whose rows are the columns of the matrix.
+        auto transpose() const { return transpose_of(derived()); }
+        auto diagonal() { return diagonal_of(derived()); } ///< The diagonal, as a min(rows, cols) x 1 matrix.
+        auto diagonal() const { return diagonal_of(derived()); }
+
+      private:
+        /// The distance between two consecutive rows in the data() of mat: its leading dimension for a matrix, cols() for a view.
+        template <typename Mat>
+        static int row_stride(const Mat& mat)
+        {
+            if constexpr (requires { mat.leading_dimension(); })
+                return mat.leading_dimension();
+            else
+                return mat.cols();
+        }
+
+        /// The iterator on the first (or past the last if End) coefficient of mat, whose data() is [first, last): a PaddedIterator for a matrix,
+        /// the iterator of the data() for a view.
+        template <bool End, typename Mat, typename It, typename Sentinel>
+        static auto coefficient_iterator(const Mat& mat, It first, Sentinel last)
+        {
+            if constexpr (requires { mat.leading_dimension(); })
+                return PaddedIterator<It>(first, mat.cols(), mat.leading_dimension(), End ? static_cast<std::ptrdiff_t>(mat.rows()) * mat.cols() : 0);
+            else if constexpr (End)
+                return last;
+            else
+                return first;
+        }
+
+        template <typename Mat>
+        static auto block_of(Mat& mat, int i, int j, int rows, int cols)
+        {
+            assert(i >= 0 && j >= 0 && rows >= 0 && cols >= 0 && i + rows <= mat.rows() && j + cols <= mat.cols() && "View out of the matrix.");
+            return strided_view(mat.data(), rows, cols, i * row_stride(mat) + j, row_stride(mat), 1);
+        }
+
+        template <typename Mat>
+        static auto transpose_of(Mat& mat)
+        {
+            return strided_view(mat.data(), mat.cols(), mat.rows(), 0, 1, row_stride(mat));
+        }
+
+        template <typename Mat>
+        static auto diagonal_of(Mat& mat)
+        {
+            return strided_view(mat.data(), std::min(mat.rows(), mat.cols()), 1, 0, row_stride(mat) + 1, 1);
+        }
     };
 
     template <typename T>
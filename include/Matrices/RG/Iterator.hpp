@@ -77,4 +77,107 @@ namespace LinAlg::Matrices::RG
 
     static_assert(std::output_iterator<Iterator<int>, int>);
     static_assert(std::random_access_iterator<Iterator<int>>);
+
+    /**
+     * @brief Iterator over the coefficients of a row-major matrix in the order of the flattened index, skipping the padding of its rows:
+     * the coefficient (i, j) is data[i * leading_dimension + j].
+     *
+     * @tparam It random access iterator over the storage of the matrix
+     */
+    template <std::random_access_iterator It>
+    class PaddedIterator
+    {
+      public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = std::iter_value_t<It>;
+        using reference = std::iter_reference_t<It>;
+
+        PaddedIterator() = default;
+        PaddedIterator(It data, int cols, int leading_dimension, difference_type index)
+            : m_data(data)
+            , m_cols(cols)
+            , m_ld(leading_dimension)
+        {
+            set_index(index);
+        }
+
+        bool operator==(const PaddedIterator& other) const { return m_offset == other.m_offset; }
+        reference operator*() const { return m_data[m_offset]; }
+        PaddedIterator& operator++()
+        {
+            ++m_offset;
+            if (++m_col == m_cols)
+            {
+                m_col = 0;
+                m_offset += m_ld - m_cols;
+            }
+            return *this;
+        }
+        PaddedIterator operator++(int)
+        {
+            PaddedIterator tmp(*this);
+            ++*this;
+            return tmp;
+        }
+        PaddedIterator& operator--()
+        {
+            if (m_col == 0)
+            {
+                m_col = m_cols;
+                m_offset -= m_ld - m_cols;
+            }
+            --m_col;
+            --m_offset;
+            return *this;
+        }
+        PaddedIterator operator--(int)
+        {
+            PaddedIterator tmp(*this);
+            --*this;
+            return tmp;
+        }
+        PaddedIterator& operator+=(difference_type n)
+        {
+            set_index(index() + n);
+            return *this;
+        }
+        PaddedIterator operator+(difference_type n) const
+        {
+            PaddedIterator tmp(*this);
+            return tmp += n;
+        }
+        friend PaddedIterator operator+(difference_type n, const PaddedIterator& it) { return it + n; }
+        PaddedIterator& operator-=(difference_type n) { return *this += -n; }
+        PaddedIterator operator-(difference_type n) const
+        {
+            PaddedIterator tmp(*this);
+            return tmp -= n;
+        }
+        difference_type operator-(const PaddedIterator& other) const { return index() - other.index(); }
+        bool operator!=(const PaddedIterator& other) const { return !(*this == other); }
+        bool operator<=(const PaddedIterator& other) const { return m_offset <= other.m_offset; }
+        bool operator>(const PaddedIterator& other) const { return !(*this <= other); }
+        bool operator>=(const PaddedIterator& other) const { return (*this > other) || (*this == other); }
+        bool operator<(const PaddedIterator& other) const { return !(*this >= other); }
+
+        reference operator[](difference_type n) const { return *(*this + n); }
+
+      private:
+        /// The flattened index of the coefficient, i.e. row * cols + col.
+        difference_type index() const { return m_ld == m_cols ? m_offset : (m_offset - m_col) / m_ld * m_cols + m_col; }
+        void set_index(difference_type index)
+        {
+            m_col = m_cols > 0 ? static_cast<int>(index % m_cols) : 0;
+            m_offset = m_cols > 0 ? index / m_cols * m_ld + m_col : 0;
+        }
+
+        It m_data {};
+        difference_type m_offset { 0 }; ///< Position of the coefficient in the storage.
+        int m_col { 0 };                ///< Column of the coefficient, to skip the padding at the end of its row.
+        int m_cols { 0 };
+        int m_ld { 0 };
+    };
+
+    static_assert(std::output_iterator<PaddedIterator<Iterator<int>>, int>);
+    static_assert(std::random_access_iterator<PaddedIterator<Iterator<int>>>);
 }
@@ -0,0 +1,112 @@
+#pragma once
+#include <Matrices/Common/MappedArray.hpp>
+#include <Matrices/RG/ForwardDeclarations.hpp>
+#include <Matrices/RG/Matrix.hpp>
+
+namespace LinAlg::Matrices::RG
+{
+    /**
+     * @brief A matrix stored in a memory mapping, usually of a file too large for the memory (see Common::MappedArray).
+     *
+     * It is a range over the mapped coefficients, built for instance with MappedMatrix<double>(rows, cols, MappedArray<double>::open(path)).
+     * Assigning a matrix or a view writes its coefficients into the mapping, whose dimensions do not change, while moving a MappedMatrix
+     * transfers its mapping. Writing into a read-only mapping is an error: the assignments, apply_inplace(), zero(), set() and the writable views
+     * throw std::logic_error instead of faulting on the protected pages. The reads are always allowed.
+     *
+     * @tparam T scalar type
+     */
+    template <typename T>
+    class MappedMatrix : public MatrixCont<Common::MappedArray<T>>
+    {
+        using Base = MatrixCont<Common::MappedArray<T>>;
+        using Views = _implementation_details::RangeWrapper<MatrixCont<Common::MappedArray<T>>>;
+
+      public:
+        using Base::Base;
+
+        MappedMatrix(const MappedMatrix&) = default; ///< Copies the coefficients into an anonymous mapping.
+        MappedMatrix(MappedMatrix&&) noexcept = default;
+        MappedMatrix& operator=(MappedMatrix&&) noexcept = default;
+
+        MappedMatrix& operator=(const MappedMatrix& other) ///< Copies the coefficients of other into the mapping.
+        {
+            return *this = static_cast<const LinAlg::Matrices::Common::MatrixBase<LinAlg::Matrices::Common::Matrix<Common::MappedArray<T>>>&>(other);
+        }
+
+        template <typename OtherDerived>
+        MappedMatrix& operator=(const LinAlg::Matrices::Common::MatrixBase<OtherDerived>& other) ///< Writes the coefficients of a matrix or a view into the mapping.
+        {
+            assert(other.rows() == this->rows() && other.cols() == this->cols() && "Matrix dimensions do not match for assignment.");
+            check_writable();
+            LinAlg::Matrices::Common::Matrix<Common::MappedArray<T>>::operator=(other);
+            return *this;
+        }
+
+        using Views::block;
+        using Views::col;
+        using Views::diagonal;
+        using Views::row;
+        using Views::transpose;
+
+        /// The members below write into the mapping, hence throw std::logic_error if it is read-only. The views of a read-only mapping are
+        /// taken on the const matrix, for instance std::as_const(m).row(i).
+        template <typename Func>
+        MappedMatrix& apply_inplace(Func&& f) ///< Applies the function f to all elements inplace.
+        {
+            check_writable();
+            Base::apply_inplace(std::forward<Func>(f));
+            return *this;
+        }
+
+        MappedMatrix& zero() ///< Sets all elements to zero.
+        {
+            check_writable();
+            Base::zero();
+            return *this;
+        }
+
+        MappedMatrix& set(const T& val) ///< Sets all elements to val.
+        {
+            check_writable();
+            Base::set(val);
+            return *this;
+        }
+
+        auto block(int i, int j, int rows, int cols) ///< The writable rows x cols block starting at (i, j).
+        {
+            check_writable();
+            return Views::block(i, j, rows, cols);
+        }
+
+        auto row(int i) ///< The writable row i, as a 1 x cols matrix.
+        {
+            check_writable();
+            return Views::row(i);
+        }
+
+        auto col(int j) ///< The writable column j, as a rows x 1 matrix.
+        {
+            check_writable();
+            return Views::col(j);
+        }
+
+        auto transpose() ///< The writable transpose.
+        {
+            check_writable();
+            return Views::transpose();
+        }
+
+        auto diagonal() ///< The writable diagonal, as a min(rows, cols) x 1 matrix.
+        {
+            check_writable();
+            return Views::diagonal();
+        }
+
+      private:
+        void check_writable() const
+        {
+            if (this->data().read_only())
+                throw std::logic_error("Cannot write into a matrix mapped in read-only mode.");
+        }
+    };
+}
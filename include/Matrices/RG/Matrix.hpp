@@ -11,8 +11,8 @@ namespace LinAlg::Matrices::RG
     {
       public:
         using Scalar = std::ranges::range_value_t<Cont>;
-        using iterator = std::ranges::iterator_t<Cont>;
-        using const_iterator = std::ranges::const_iterator_t<Cont>;
+        using iterator = PaddedIterator<std::ranges::iterator_t<Cont>>;
+        using const_iterator = PaddedIterator<std::ranges::const_iterator_t<Cont>>;
         using RGType = Cont;
 
         using LinAlg::Matrices::Common::Matrix<Cont>::Matrix;
@@ -40,4 +40,7 @@ namespace LinAlg::Matrices::RG
     using Matrixd = Matrix<double>;
     using Matrixf = Matrix<float>;
     using Matrixi = Matrix<int>;
+    using Matrixi8 = Matrix<std::int8_t>;
+    using Matrixi16 = Matrix<std::int16_t>;
+    using Matrixi64 = Matrix<std::int64_t>;
 }
@@ -1,26 +1,257 @@
 #pragma once
 
 #include <Matrices/Common/MatrixMultiplication.hpp>
+#include <Matrices/Kernels/Gemm.hpp>
+#include <Matrices/Kernels/Gemv.hpp>
+#include <Matrices/Kernels/IntGemm.hpp>
+#include <Matrices/Kernels/Strassen.hpp>
+#include <Matrices/Kernels/Syrk.hpp>
 #include <Matrices/RG/ForwardDeclarations.hpp>
 
 namespace LinAlg::Matrices::RG
 {
-    template <typename LHS, typename RHS>
+    namespace _implementation_details
+    {
+        /**
+         * @brief Copies the rows [i0, i1) of a matrix, converted to T, into a contiguous row-major buffer.
+         */
+        template <typename T, typename Mat>
+        void pack_rows(const Mat& mat, int i0, int i1, std::vector<T>& packed)
+        {
+            packed.resize(static_cast<std::size_t>(i1 - i0) * mat.cols());
+            auto out = packed.begin();
+            for (int i : std::views::iota(i0, i1))
+                out = std::ranges::copy(mat.row(i) | std::views::transform([](auto x) { return static_cast<T>(x); }), out).out;
+        }
+
+        /**
+         * @brief Copies the transpose of a matrix, converted to T, into a contiguous row-major buffer: column j becomes row j.
+         */
+        template <typename T, typename Mat>
+        std::vector<T> pack_transpose(const Mat& mat)
+        {
+            std::vector<T> packed(static_cast<std::size_t>(mat.rows()) * mat.cols());
+            const auto pack_col = [&](int j)
+            {
+                std::ranges::copy(mat.col(j) | std::views::transform([](auto x) { return static_cast<T>(x); }),
+                                  packed.begin() + static_cast<std::ptrdiff_t>(j) * mat.rows());
+            };
+
+            if (Kernels::gemv_is_parallel(mat.rows(), mat.cols()))
+                Kernels::parallel_for(mat.cols(), pack_col);
+            else
+                std::ranges::for_each(std::views::iota(0, mat.cols()), pack_col);
+            return packed;
+        }
+    }
+
+    /**
+     * @brief Multiplies two matrices.
+     *
+     * Products with a column or row vector go through the GEMV kernels, integer products through the integer kernel, which accumulates
+     * in a widened type (see widening_mult to get the widened result).
+     * Otherwise, the transpose of rhs is packed once into a contiguous buffer, so that each coefficient is the reduction of two contiguous ranges:
+     * a row of lhs and a row of the packed transpose. Rows of lhs which are not stored contiguously (expressions, helper matrices) are packed
+     * as well, once per tile. Columns are processed in blocks whose packed rows fit in the L2 cache.
+     * Large products are split into 2D tiles of the result, which are computed on the thread pool.
+     * Floating point products are accumulated in Acc if it is not void, for instance in double for float matrices.
+     *
+     * @tparam Acc accumulation type, or void for the common scalar type
+     * @tparam LHS left matrix type
+     * @tparam RHS right matrix type
+     * @param lhs left matrix
+     * @param rhs right matrix
+     * @return Matrix<T> with T being the common scalar type of the matrices
+     */
+    template <typename Acc = void, typename LHS, typename RHS>
         requires Concepts::BothMatrices<LHS, RHS>
     auto two_matrix_mult(LHS&& lhs, RHS&& rhs)
     {
         assert(lhs.cols() == rhs.rows() && "Matrix dimensions do not match for multiplication.");
 
         using T = LinAlg::CommonScalar<std::remove_cvref_t<LHS>, std::remove_cvref_t<RHS>>;
-        Matrix<T> res(lhs.rows(), rhs.cols());
+        using U = std::conditional_t<std::is_void_v<Acc>, T, Acc>;
+        Matrix<T> res(lhs.rows(), rhs.cols(), Common::uninitialized);
+
+        if (Kernels::matrix_vector_product<Acc>(lhs, rhs, Kernels::data_ptr(res)))
+            return res;
+
+        if constexpr (std::is_integral_v<T>)
+        {
+            Kernels::int_gemm(lhs.rows(), rhs.cols(), lhs.cols(), Kernels::make_operand(lhs), Kernels::make_operand(rhs), Kernels::data_ptr(res), res.cols());
+            return res;
+        }
 
-        for (int i = 0; i < lhs.rows(); ++i)
-            for (int j = 0; j < rhs.cols(); ++j)
+        const int k = lhs.cols();
+        const std::vector<T> rhs_t = _implementation_details::pack_transpose<T>(rhs);
+        const int block_cols = std::max<int>(1, 128 * 1024 / (sizeof(T) * std::max(k, 1)));
+
+        const auto mult_tile = [&](int i0, int i1, int j0, int j1)
+        {
+            std::vector<T> packed_lhs;
+            const T* lhs_rows = nullptr;
+            int lhs_ld = k;
+            if constexpr (Kernels::Concepts::ContiguousMatrixOf<LHS, T>)
+            {
+                lhs_ld = Kernels::leading_dimension(lhs);
+                lhs_rows = Kernels::data_ptr(lhs) + static_cast<std::ptrdiff_t>(i0) * lhs_ld;
+            }
+            else
             {
-                auto mult_view = std::views::zip(lhs.row(i), rhs.col(j)) | std::views::transform([](auto&& pair) { return std::get<0>(pair) * std::get<1>(pair); });
-                res[i, j] = std::reduce(mult_view.begin(), mult_view.end(), T(0), std::plus<>());
+                _implementation_details::pack_rows<T>(lhs, i0, i1, packed_lhs);
+                lhs_rows = packed_lhs.data();
             }
 
+            for (int jb = j0; jb < j1; jb += block_cols)
+                for (int i = i0; i < i1; ++i)
+                {
+                    const std::span<const T> lhs_row(lhs_rows + static_cast<std::ptrdiff_t>(i - i0) * lhs_ld, k);
+                    for (int j = jb; j < std::min(jb + block_cols, j1); ++j)
+                    {
+                        const std::span<const T> rhs_col(rhs_t.data() + static_cast<std::ptrdiff_t>(j) * k, k);
+                        res[i, j] = static_cast<T>(std::transform_reduce(lhs_row.begin(), lhs_row.end(), rhs_col.begin(), U(0), std::plus<U> {},
+                                                                         [](T a, T b) { return static_cast<U>(a) * static_cast<U>(b); }));
+                    }
+                }
+        };
+
+        if (Kernels::gemm_is_parallel(lhs.rows(), rhs.cols(), lhs.cols()))
+            Kernels::parallel_for_tiles(lhs.rows(), rhs.cols(), 1, 1, mult_tile);
+        else
+            mult_tile(0, lhs.rows(), 0, rhs.cols());
+
+        return res;
+    }
+
+    /**
+     * @brief Multiplies two matrices, one of which at least is a Zero, Identity or Constant helper matrix, without a general product
+     * (see Common::structured_mult_into).
+     *
+     * @tparam Acc accumulation type, or void for the common scalar type
+     * @tparam LHS left matrix type
+     * @tparam RHS right matrix type
+     * @param lhs left matrix
+     * @param rhs right matrix
+     * @return Matrix<T> with T being the common scalar type of the matrices
+     */
+    template <typename Acc = void, typename LHS, typename RHS>
+        requires Concepts::BothMatrices<LHS, RHS> && Common::Concepts::StructuredProduct<LHS, RHS>
+    auto two_matrix_mult(LHS&& lhs, RHS&& rhs)
+    {
+        using T = LinAlg::CommonScalar<std::remove_cvref_t<LHS>, std::remove_cvref_t<RHS>>;
+        Matrix<T> res(lhs.rows(), rhs.cols(), Common::uninitialized);
+        Common::structured_mult_into<Acc>(lhs, rhs, Kernels::data_ptr(res));
+        return res;
+    }
+
+    /**
+     * @brief Multiplies a sparse matrix with a dense matrix (or expression), in either order, with the sparse kernels (see Common::sparse_mult_into).
+     *
+     * Acc is ignored: the products are accumulated in the common scalar type.
+     *
+     * @tparam Acc ignored
+     * @tparam LHS left matrix type
+     * @tparam RHS right matrix type
+     * @param lhs left matrix
+     * @param rhs right matrix
+     * @return Matrix<T> with T being the common scalar type of the matrices
+     */
+    template <typename Acc = void, typename LHS, typename RHS>
+        requires(Concepts::MatrixType<LHS> && Common::Concepts::SparseMatrixType<RHS>) || (Common::Concepts::SparseMatrixType<LHS> && Concepts::MatrixType<RHS>)
+    auto two_matrix_mult(LHS&& lhs, RHS&& rhs)
+    {
+        using T = LinAlg::CommonScalar<std::remove_cvref_t<LHS>, std::remove_cvref_t<RHS>>;
+        Matrix<T> res(lhs.rows(), rhs.cols(), Common::uninitialized);
+        Common::sparse_mult_into(lhs, rhs, Kernels::data_ptr(res));
+        return res;
+    }
+
+    /**
+     * @brief Multiplies two floating point matrices with the Strassen-Winograd algorithm.
+     *
+     * Opt-in alternative to mat_mult for large products: it needs fewer operations, at the cost of a slightly larger rounding error.
+     * Operands which are expressions, or whose scalar type differs from the result one, are evaluated first.
+     *
+     * @tparam LHS left matrix type
+     * @tparam RHS right matrix type
+     * @param lhs left matrix
+     * @param rhs right matrix
+     * @param cutoff size below which the standard product is used
+     * @return Matrix<T> with T being the common scalar type of the matrices
+     */
+    template <typename LHS, typename RHS>
+        requires Concepts::BothMatrices<LHS, RHS>
+    auto strassen_mult(LHS&& lhs, RHS&& rhs, int cutoff = Kernels::strassen_default_cutoff)
+    {
+        assert(lhs.cols() == rhs.rows() && "Matrix dimensions do not match for multiplication.");
+
+        using T = LinAlg::CommonScalar<std::remove_cvref_t<LHS>, std::remove_cvref_t<RHS>>;
+        static_assert(std::is_floating_point_v<T>, "Strassen multiplication is only available for floating point matrices.");
+
+        if constexpr (!Kernels::Concepts::ContiguousMatrixOf<LHS, T>)
+            return strassen_mult(Matrix<T>(lhs), std::forward<RHS>(rhs), cutoff);
+        else if constexpr (!Kernels::Concepts::ContiguousMatrixOf<RHS, T>)
+            return strassen_mult(std::forward<LHS>(lhs), Matrix<T>(rhs), cutoff);
+        else
+        {
+            Matrix<T> res(lhs.rows(), rhs.cols(), Common::uninitialized);
+            Kernels::strassen(lhs.rows(), rhs.cols(), lhs.cols(), Kernels::data_ptr(lhs), Kernels::leading_dimension(lhs), Kernels::data_ptr(rhs),
+                              Kernels::leading_dimension(rhs), Kernels::data_ptr(res), res.cols(), cutoff);
+            return res;
+        }
+    }
+
+    /**
+     * @brief Multiplies two integer matrices and returns the result in a widened integer type.
+     *
+     * The products are accumulated in 32 bit for 8 bit and int16 matrices and in 64 bit otherwise, unsigned for unsigned matrices, or in Acc if it is wider.
+     * For instance, widening_mult<std::int64_t>(lhs, rhs) computes the exact product of two int16 matrices whatever their size.
+     *
+     * @tparam Acc scalar type of the result. By default, the accumulator type Kernels::widened_t of the common scalar type.
+     * @tparam LHS left matrix type
+     * @tparam RHS right matrix type
+     * @param lhs left matrix
+     * @param rhs right matrix
+     * @return Matrix<Acc>
+     */
+    template <typename Acc = void, typename LHS, typename RHS>
+        requires Concepts::BothMatrices<LHS, RHS>
+    auto widening_mult(LHS&& lhs, RHS&& rhs)
+    {
+        assert(lhs.cols() == rhs.rows() && "Matrix dimensions do not match for multiplication.");
+
+        using T = LinAlg::CommonScalar<std::remove_cvref_t<LHS>, std::remove_cvref_t<RHS>>;
+        static_assert(std::is_integral_v<T>, "Widening multiplication is only available for integer matrices.");
+        using R = std::conditional_t<std::is_void_v<Acc>, Kernels::widened_t<T>, Acc>;
+
+        Matrix<R> res(lhs.rows(), rhs.cols(), Common::uninitialized);
+        Kernels::int_gemm(lhs.rows(), rhs.cols(), lhs.cols(), Kernels::make_operand(lhs), Kernels::make_operand(rhs), Kernels::data_ptr(res), res.cols());
+        return res;
+    }
+
+    /**
+     * @brief Computes the symmetric product A * A^T, or A^T * A if transpose_A is true, for instance a Gram or covariance matrix.
+     *
+     * Only one triangle is computed, which needs half the operations of mat_mult(A, transpose(A)); see Common::syrk_into.
+     * If mirror is false, the other triangle of the result is zero.
+     *
+     * @tparam Mat matrix type
+     * @param A matrix
+     * @param transpose_A if true, computes A^T * A instead of A * A^T
+     * @param uplo triangle to compute
+     * @param mirror if true, the computed triangle is copied into the other one
+     * @return Matrix<T> with T being the scalar type of A
+     */
+    template <typename Mat>
+        requires Concepts::MatrixType<Mat>
+    auto syrk(const Mat& A, bool transpose_A = false, Kernels::Triangle uplo = Kernels::Triangle::Lower, bool mirror = true)
+    {
+        using T = LinAlg::CommonScalar<Mat>;
+        const int n = transpose_A ? A.cols() : A.rows();
+        Matrix<T> res(n, n, Common::uninitialized);
+        if (!mirror)
+            std::fill_n(Kernels::data_ptr(res), static_cast<std::size_t>(n) * n, T(0));
+        Common::syrk_into(res, A, T(1), T(0), transpose_A, uplo, mirror);
         return res;
     }
 }
@@ -14,6 +14,9 @@ namespace LinAlg::Matrices::RG
         using iterator = std::ranges::iterator_t<View>;
         using const_iterator = std::ranges::const_iterator_t<View>;
         using RGType = View;
+        /// Whether the coefficients of View can be assigned, as the ones of the views of a non-const matrix returned by row() or block().
+        static constexpr bool Writable = std::is_lvalue_reference_v<std::ranges::range_reference_t<View>>
+                                         && std::is_assignable_v<std::ranges::range_reference_t<View>, Scalar>;
 
         template <typename V>
         MatrixView(int rows, int cols, V&& view)
@@ -22,6 +25,34 @@ namespace LinAlg::Matrices::RG
         {
         }
 
+        MatrixView(const MatrixView&) = default;
+        MatrixView(MatrixView&&) = default;
+
+        /// Copies the coefficients of other into the viewed ones if the view can be written to, as the views of the rows or blocks of a matrix.
+        /// Otherwise, the view is rebound to the ones of other.
+        MatrixView& operator=(const MatrixView& other)
+            requires Writable
+        {
+            return *this = static_cast<const LinAlg::Matrices::Common::MatrixBase<MatrixView>&>(other);
+        }
+        MatrixView& operator=(const MatrixView&)
+            requires(!Writable)
+        = default;
+        MatrixView& operator=(MatrixView&&)
+            requires(!Writable)
+        = default;
+
+        template <typename OtherDerived>
+            requires Writable
+        MatrixView& operator=(const LinAlg::Matrices::Common::MatrixBase<OtherDerived>& other) ///< Writes the coefficients of a matrix or an expression into the viewed ones.
+        {
+            assert(other.rows() == this->rows() && other.cols() == this->cols() && "Matrix dimensions do not match for assignment.");
+            const OtherDerived& derived = static_cast<const OtherDerived&>(other);
+            for (int i = 0; i < this->m_rows * this->m_cols; ++i)
+                m_view[i] = derived[i];
+            return *this;
+        }
+
         template <typename Cont = Container<Scalar>>
         MatrixCont<Cont> eval() const
         {
@@ -30,6 +61,8 @@ namespace LinAlg::Matrices::RG
 
         Scalar operator[](int i, int j) const { return m_view[i * this->m_cols + j]; }; ///< Access the element at row i and column j.
         Scalar operator[](int i) const { return m_view[i]; };                           ///< Access the element i in the flattened matrix.
+        decltype(auto) operator[](int i, int j) { return m_view[i * this->m_cols + j]; } ///< Access the element at row i and column j, by reference if Writable.
+        decltype(auto) operator[](int i) { return m_view[i]; }                           ///< Access the element i in the flattened matrix, by reference if Writable.
 
         View& data() { return m_view; }
         const View& data() const { return m_view; }
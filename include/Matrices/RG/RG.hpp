@@ -1,7 +1,12 @@
 #pragma once
 
+#include <Matrices/Common/BinaryFile.hpp>
+#include <Matrices/Common/Reductions.hpp>
+#include <Matrices/Common/SparseMatrix.hpp>
+#include <Matrices/Common/TextFile.hpp>
 #include <Matrices/RG/Expressions.hpp>
 #include <Matrices/RG/HelperMatrices.hpp>
+#include <Matrices/RG/MappedMatrix.hpp>
 #include <Matrices/RG/Matrix.hpp>
 #include <Matrices/RG/MatrixMultiplication.hpp>
 #include <Matrices/RG/MatrixView.hpp>
@@ -11,6 +11,13 @@ namespace LinAlg::Solvers
         { m[0, 0] } -> std::same_as<typename Matrix::Scalar&>;
     };
 
+    /// A square matrix whose size is known at compile time.
+    template <typename Matrix>
+    concept FixedSquareMatrixType = MatrixType<Matrix> && requires {
+        { Matrix::RowsAtCompileTime } -> std::convertible_to<int>;
+        { Matrix::ColsAtCompileTime } -> std::convertible_to<int>;
+    } && Matrix::RowsAtCompileTime == Matrix::ColsAtCompileTime;
+
     template <MatrixType Matrix>
     class LU
     {
@@ -27,6 +34,28 @@ namespace LinAlg::Solvers
         Matrix m_u;
         bool factorized { false };
     };
+
+    /**
+     * @brief LU factorization (without pivoting, as LU) of a square matrix whose size N is known at compile time.
+     *
+     * The factors are stored by value and the matrix is factorized by the constructor. All the loops have compile-time trip counts,
+     * hence the compiler unrolls them for small sizes, and everything is constexpr: a fixed size system can be solved at compile time.
+     */
+    template <FixedSquareMatrixType Matrix>
+    class FixedLU
+    {
+      public:
+        static constexpr int N = Matrix::RowsAtCompileTime;
+
+        constexpr FixedLU(const Matrix& m);
+        constexpr std::pair<const Matrix&, const Matrix&> getLU() const;
+        template <typename Rhs>
+        constexpr Rhs solve(Rhs b) const; ///< Solves A x = b for each of the columns of the N x K matrix b.
+
+      private:
+        Matrix m_l;
+        Matrix m_u;
+    };
 }
 
 /*
@@ -45,12 +74,27 @@ namespace LinAlg::Solvers
         assert(m.rows() == m.cols() && "Matrix must be square.");
     };
 
+    /**
+     * @brief Sets the matrix to factorize. The factors of a matrix of the same size are reset in place, hence refactorizing does not allocate.
+     */
     template <MatrixType Matrix>
     void LU<Matrix>::reinit(const Matrix& m)
     {
         m_m = m;
-        m_l = Matrix::Identity(m.rows());
-        m_u = Matrix::Zero(m.rows(), m.cols());
+        if (m_l.rows() == m.rows() && m_l.cols() == m.cols())
+        {
+            for (int i = 0; i < m.rows(); ++i)
+                for (int j = 0; j < m.cols(); ++j)
+                {
+                    m_l[i, j] = i == j ? 1 : 0;
+                    m_u[i, j] = 0;
+                }
+        }
+        else
+        {
+            m_l = Matrix::Identity(m.rows());
+            m_u = Matrix::Zero(m.rows(), m.cols());
+        }
         factorized = false;
     }
 
@@ -107,4 +151,57 @@ namespace LinAlg::Solvers
     {
         return { m_l, m_u };
     }
+
+    template <FixedSquareMatrixType Matrix>
+    constexpr FixedLU<Matrix>::FixedLU(const Matrix& m)
+        : m_l(Matrix::Identity())
+        , m_u(Matrix::Zero())
+    {
+        for (int i = 0; i < N; ++i)
+        {
+            for (int j = i; j < N; ++j)
+            {
+                m_u[i, j] = m[i, j];
+                for (int k = 0; k < i; ++k)
+                    m_u[i, j] -= m_l[i, k] * m_u[k, j];
+            }
+
+            for (int j = i + 1; j < N; ++j)
+            {
+                m_l[j, i] = m[j, i];
+                for (int k = 0; k < i; ++k)
+                    m_l[j, i] -= m_l[j, k] * m_u[k, i];
+                m_l[j, i] /= m_u[i, i];
+            }
+        }
+    }
+
+    template <FixedSquareMatrixType Matrix>
+    template <typename Rhs>
+    constexpr Rhs FixedLU<Matrix>::solve(Rhs b) const
+    {
+        static_assert(Rhs::RowsAtCompileTime == N, "The right-hand side must have as many rows as the matrix.");
+        constexpr int K = Rhs::ColsAtCompileTime;
+
+        for (int c = 0; c < K; ++c)
+        {
+            for (int i = 0; i < N; ++i)
+                for (int j = 0; j < i; ++j)
+                    b[i, c] -= m_l[i, j] * b[j, c];
+
+            for (int i = N - 1; i >= 0; --i)
+            {
+                for (int j = i + 1; j < N; ++j)
+                    b[i, c] -= m_u[i, j] * b[j, c];
+                b[i, c] /= m_u[i, i];
+            }
+        }
+        return b;
+    }
+
+    template <FixedSquareMatrixType Matrix>
+    constexpr std::pair<const Matrix&, const Matrix&> FixedLU<Matrix>::getLU() const
+    {
+        return { m_l, m_u };
+    }
 }
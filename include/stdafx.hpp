@@ -1,15 +1,40 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
 #include <cassert>
+#include <charconv>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <condition_variable>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
 #include <functional>
 #include <initializer_list>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <numeric>
 #include <optional>
 #include <random>
 #include <ranges>
 #include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
 #include <tuple>
 #include <type_traits>
 #include <utility>
+#include <variant>
+#include <vector>
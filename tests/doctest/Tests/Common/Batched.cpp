@@ -0,0 +1,99 @@
+#include <backends.hpp>
+#include <doctest/doctest.h>
+#include <random>
+#include <vector>
+
+namespace Kernels = LinAlg::Matrices::Kernels;
+using LinAlg::Matrices::Common::batched_mat_mult;
+
+/*
+ Helper functions to build random batches and to multiply them by hand.
+*/
+template <typename T>
+std::vector<T> random_batch(int rows, int cols, std::size_t batch, int seed)
+{
+    std::mt19937 gen(seed);
+    std::normal_distribution<double> dist(0., 1.);
+    std::vector<T> values(batch * rows * cols);
+    for (auto& value : values)
+        value = static_cast<T>(dist(gen));
+    return values;
+}
+
+template <typename T>
+std::vector<T> batched_by_hand(int m, int n, int k, std::size_t batch, const std::vector<T>& A, const std::vector<T>& B)
+{
+    std::vector<T> C(batch * m * n, T(0));
+    for (std::size_t b = 0; b < batch; ++b)
+        for (int i = 0; i < m; ++i)
+            for (int j = 0; j < n; ++j)
+                for (int p = 0; p < k; ++p)
+                    C[b * m * n + i * n + j] += A[b * m * k + i * k + p] * B[b * k * n + p * n + j];
+    return C;
+}
+
+template <typename T>
+double max_batch_error(const std::vector<T>& result, const std::vector<T>& expected)
+{
+    double error = 0.;
+    for (std::size_t i = 0; i < expected.size(); ++i)
+        error = std::max(error, std::abs(static_cast<double>(result[i]) - static_cast<double>(expected[i])));
+    return error;
+}
+
+TEST_CASE_TEMPLATE("Batched matrix multiplication", T, double, float)
+{
+    const double tol = std::is_same_v<T, float> ? 1e-4 : 1e-12;
+    const std::size_t batch = 1001; // not a multiple of the lanes of the interleaved layout
+
+    for (auto [m, n, k] : { std::array { 1, 1, 1 }, std::array { 3, 3, 3 }, std::array { 4, 4, 4 }, std::array { 7, 7, 7 }, std::array { 16, 16, 16 },
+                            std::array { 17, 17, 17 }, std::array { 3, 5, 2 }, std::array { 6, 1, 4 } })
+    {
+        CAPTURE(m);
+        CAPTURE(n);
+        CAPTURE(k);
+        std::vector<T> A = random_batch<T>(m, k, batch, 1);
+        std::vector<T> B = random_batch<T>(k, n, batch, 2);
+        std::vector<T> expected = batched_by_hand(m, n, k, batch, A, B);
+
+        SUBCASE("contiguous layout")
+        {
+            std::vector<T> C(batch * m * n, std::numeric_limits<T>::quiet_NaN());
+            batched_mat_mult<T>(m, n, k, batch, A, B, C);
+            CHECK_LE(max_batch_error(C, expected), tol);
+        }
+        SUBCASE("interleaved layout")
+        {
+            using Kernels::BatchLayout;
+            std::vector<T> A_interleaved(Kernels::batched_size<T>(m, k, batch, BatchLayout::Interleaved));
+            std::vector<T> B_interleaved(Kernels::batched_size<T>(k, n, batch, BatchLayout::Interleaved));
+            std::vector<T> C_interleaved(Kernels::batched_size<T>(m, n, batch, BatchLayout::Interleaved));
+            Kernels::interleave(m, k, batch, A.data(), A_interleaved.data());
+            Kernels::interleave(k, n, batch, B.data(), B_interleaved.data());
+            CHECK_EQ(A_interleaved[Kernels::interleaved_index<T>(m, k, batch - 1, m - 1, k - 1)], A.back());
+
+            batched_mat_mult<T>(m, n, k, batch, A_interleaved, B_interleaved, C_interleaved, BatchLayout::Interleaved);
+            std::vector<T> C(batch * m * n);
+            Kernels::deinterleave(m, n, batch, C_interleaved.data(), C.data());
+            CHECK_LE(max_batch_error(C, expected), tol);
+        }
+    }
+}
+
+TEST_CASE("Batched matrix multiplication on multiple threads")
+{
+    const int initial_threads = Kernels::num_threads();
+    Kernels::set_num_threads(3);
+
+    const int size = 5;
+    const std::size_t batch = 20000;
+    std::vector<double> A = random_batch<double>(size, size, batch, 3);
+    std::vector<double> B = random_batch<double>(size, size, batch, 4);
+    std::vector<double> expected = batched_by_hand(size, size, size, batch, A, B);
+
+    std::vector<double> C(batch * size * size);
+    batched_mat_mult<double>(size, size, size, batch, A, B, C);
+    CHECK_LE(max_batch_error(C, expected), 1e-12);
+
+    Kernels::set_num_threads(initial_threads);
+}
@@ -0,0 +1,96 @@
+#include <backends.hpp>
+#include <doctest/doctest.h>
+
+using LinAlg::Matrices::Common::BinaryHeader;
+using LinAlg::Matrices::Common::BinaryLayout;
+using LinAlg::Matrices::Common::MapMode;
+
+TEST_CASE_TEMPLATE("Binary matrix files", S, ET_type<double>, ET_type<float>, ET_type<int>, RG_type<double>, RG_type<float>, RG_type<int>)
+{
+    using Matrix = S::Matrix;
+    using MappedMatrix = S::MappedMatrix;
+    using Scalar = S::Scalar;
+    using OtherMatrix = S::template MatrixOf<typename S::OtherScalar>;
+    namespace Common = LinAlg::Matrices::Common;
+
+    const int rows = 37;
+    const int cols = 29;
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "linalg_binary_file_test.bin";
+    const std::filesystem::path other_path = path.string() + ".other";
+    const Matrix a = Matrix::randn(rows, cols, 0, 100, 0, 1);
+    const auto equal = [](const auto& lhs, const auto& rhs)
+    {
+        if (lhs.rows() != rhs.rows() || lhs.cols() != rhs.cols())
+            return false;
+        for (int i = 0; i < lhs.rows(); ++i)
+            for (int j = 0; j < lhs.cols(); ++j)
+                if (lhs[i, j] != rhs[i, j])
+                    return false;
+        return true;
+    };
+
+    Common::save_binary(path, a);
+
+    SUBCASE("header")
+    {
+        const BinaryHeader header = Common::read_binary_header(path);
+        CHECK_EQ(header.version, BinaryHeader::current_version);
+        CHECK_EQ(header.scalar_size, sizeof(Scalar));
+        CHECK(header.layout == BinaryLayout::RowMajor);
+        CHECK_EQ(header.rows, static_cast<std::uint64_t>(rows));
+        CHECK_EQ(header.cols, static_cast<std::uint64_t>(cols));
+        CHECK_EQ(header.data_offset % 64, 0);
+        CHECK(header.flags & BinaryHeader::has_checksum);
+        CHECK_EQ(std::filesystem::file_size(path), header.data_offset + rows * cols * sizeof(Scalar));
+    }
+    SUBCASE("round trip")
+    {
+        CHECK(equal(Common::load_binary<Matrix>(path), a));
+
+        const MappedMatrix mapped = Common::map_binary<MappedMatrix>(path, MapMode::ReadOnly, Common::MapAccess::Sequential, true);
+        CHECK(mapped.data().read_only());
+        CHECK_EQ(reinterpret_cast<std::uintptr_t>(mapped.data().data()) % 64, 0);
+        CHECK(equal(mapped, a));
+
+        Common::save_binary(other_path, a + a, false);
+        CHECK_FALSE(Common::read_binary_header(other_path).flags & BinaryHeader::has_checksum);
+        CHECK(equal(Common::load_binary<Matrix>(other_path), Matrix(a + a)));
+
+        Common::save_binary(other_path, Matrix(0, 0));
+        CHECK_EQ(Common::load_binary<Matrix>(other_path).rows(), 0);
+    }
+    SUBCASE("read-write mapping")
+    {
+        Common::save_binary(other_path, a);
+        {
+            MappedMatrix mapped = Common::map_binary<MappedMatrix>(other_path, MapMode::ReadWrite);
+            CHECK_FALSE(Common::read_binary_header(other_path).flags & BinaryHeader::has_checksum);
+            mapped[2, 3] = 7;
+        }
+        const Matrix loaded = Common::load_binary<Matrix>(other_path);
+        CHECK_EQ(loaded[2, 3], 7);
+        CHECK_EQ(loaded[3, 2], a[3, 2]);
+    }
+    SUBCASE("errors")
+    {
+        CHECK_THROWS_AS(Common::load_binary<OtherMatrix>(path), std::runtime_error);
+        CHECK_THROWS_AS(Common::load_binary<Matrix>(path.string() + ".missing"), std::system_error);
+
+        {
+            std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+            file.seekp(100);
+            file.put('\x7f');
+        }
+        CHECK_THROWS_AS(Common::load_binary<Matrix>(path), std::runtime_error);
+        CHECK_NOTHROW(Common::load_binary<Matrix>(path, false));
+
+        std::filesystem::resize_file(path, 80);
+        CHECK_THROWS_AS(Common::load_binary<Matrix>(path, false), std::system_error);
+
+        std::ofstream(path) << a;
+        CHECK_THROWS_AS(Common::read_binary_header(path), std::runtime_error);
+    }
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(other_path);
+}
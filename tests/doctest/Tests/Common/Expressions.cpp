@@ -309,3 +309,561 @@ TEST_CASE_TEMPLATE("Matrix-Matrix multiplication", S, ET_type<double>, RG_type<d
         }
     }
 }
+
+TEST_CASE_TEMPLATE("Matrix-vector multiplication", S, ET_type<double>, RG_type<double>)
+{
+    namespace Kernels = LinAlg::Matrices::Kernels;
+    using Matrix = S::Matrix;
+    using Constant = S::Constant;
+    using Identity = S::Identity;
+
+    const int m = 37;
+    const int n = 45;
+    Matrix mat = Matrix::randn(m, n, 0., 1., 1e-8);
+    Matrix col = Matrix::randn(n, 1, 0., 1., 1e-8);
+    Matrix row = Matrix::randn(1, m, 0., 1., 1e-8);
+
+    SUBCASE("matrix-vector")
+    {
+        Matrix result = mat_mult(mat, col);
+        CHECK(APPROX_EQ(result, multiply_by_hand<Matrix>(mat, col)));
+    }
+    SUBCASE("vector-matrix")
+    {
+        Matrix result = mat_mult(row, mat);
+        CHECK(APPROX_EQ(result, multiply_by_hand<Matrix>(row, mat)));
+    }
+    SUBCASE("expressions")
+    {
+        Matrix result = mat_mult(mat * 2., col + col);
+        CHECK(APPROX_EQ(result, multiply_by_hand<Matrix>(mat * 2., col + col)));
+    }
+    SUBCASE("helper matrices")
+    {
+        Matrix result = mat_mult(Identity(n), col);
+        CHECK(APPROX_EQ(result, col));
+
+        Matrix const_result = mat_mult(Constant(m, n, 2.), col);
+        CHECK(APPROX_EQ(const_result, multiply_by_hand<Matrix>(Constant(m, n, 2.), col)));
+
+        Matrix const_vec_result = mat_mult(row, Constant(m, 1, 3.));
+        CHECK(APPROX_EQ(const_vec_result, multiply_by_hand<Matrix>(row, Constant(m, 1, 3.))));
+    }
+    SUBCASE("inner product")
+    {
+        Matrix result = mat_mult(row, mat, col);
+        CHECK(APPROX_EQ(result, multiply_by_hand<Matrix>(multiply_by_hand<Matrix>(row, mat), col)));
+    }
+    SUBCASE("multiple threads")
+    {
+        const int initial_threads = Kernels::num_threads();
+        Kernels::set_num_threads(3);
+
+        Matrix large = Matrix::randn(301, 283, 0., 1., 1e-8);
+        Matrix large_col = Matrix::randn(283, 1, 0., 1., 1e-8);
+        Matrix large_row = Matrix::randn(1, 301, 0., 1., 1e-8);
+        Matrix result = mat_mult(large, large_col);
+        CHECK(APPROX_EQ(result, multiply_by_hand<Matrix>(large, large_col)));
+        Matrix row_result = mat_mult(large_row, large);
+        CHECK(APPROX_EQ(row_result, multiply_by_hand<Matrix>(large_row, large)));
+
+        Kernels::set_num_threads(initial_threads);
+    }
+}
+
+TEST_CASE("Matrix chain ordering")
+{
+    using LinAlg::Matrices::Common::chain_order;
+
+    // Textbook example: the optimal order is (A1 (A2 A3)) ((A4 A5) A6).
+    constexpr auto order = chain_order<6>({ 30, 35, 15, 5, 10, 20, 25 });
+    static_assert(order.cost[0][5] == 15125);
+    CHECK_EQ(order.split[0][5], 2);
+    CHECK_EQ(order.split[0][2], 0);
+    CHECK_EQ(order.split[3][5], 4);
+
+    // A skinny chain must be evaluated from the right, a wide one from the left.
+    CHECK_EQ(chain_order<3>({ 100, 100, 100, 1 }).split[0][2], 0);
+    CHECK_EQ(chain_order<3>({ 1, 100, 100, 100 }).split[0][2], 1);
+}
+
+TEST_CASE_TEMPLATE("Matrix-Matrix multiplication of rectangular chains", S, ET_type<double>, RG_type<double>)
+{
+    using Matrix = S::Matrix;
+
+    SUBCASE("right to left")
+    {
+        Matrix m1 = Matrix::randn(40, 30, 0., 1., 1e-8);
+        Matrix m2 = Matrix::randn(30, 35, 0., 1., 1e-8);
+        Matrix m3 = Matrix::randn(35, 2, 0., 1., 1e-8);
+        Matrix result = mat_mult(m1, m2, m3);
+        Matrix expected = multiply_by_hand<Matrix>(m1, multiply_by_hand<Matrix>(m2, m3));
+        CHECK(APPROX_EQ(result, expected));
+    }
+    SUBCASE("left to right")
+    {
+        Matrix m1 = Matrix::randn(2, 30, 0., 1., 1e-8);
+        Matrix m2 = Matrix::randn(30, 35, 0., 1., 1e-8);
+        Matrix m3 = Matrix::randn(35, 40, 0., 1., 1e-8);
+        Matrix result = mat_mult(m1, m2, m3);
+        Matrix expected = multiply_by_hand<Matrix>(multiply_by_hand<Matrix>(m1, m2), m3);
+        CHECK(APPROX_EQ(result, expected));
+    }
+    SUBCASE("split in the middle with expressions")
+    {
+        Matrix m1 = Matrix::randn(20, 3, 0., 1., 1e-8);
+        Matrix m2 = Matrix::randn(3, 25, 0., 1., 1e-8);
+        Matrix m3 = Matrix::randn(25, 30, 0., 1., 1e-8);
+        Matrix m4 = Matrix::randn(30, 4, 0., 1., 1e-8);
+        Matrix m5 = Matrix::randn(4, 22, 0., 1., 1e-8);
+        Matrix result = mat_mult(m1, m2 + m2, m3, m4, m5);
+        Matrix lhs = multiply_by_hand<Matrix>(m1, m2 + m2);
+        Matrix rhs = multiply_by_hand<Matrix>(multiply_by_hand<Matrix>(m3, m4), m5);
+        Matrix expected = multiply_by_hand<Matrix>(lhs, rhs);
+        CHECK(APPROX_EQ(result, expected));
+    }
+}
+
+template <typename Matrix>
+Matrix transpose_by_hand(const Matrix& mat)
+{
+    Matrix result(mat.cols(), mat.rows());
+    for (int i = 0; i < mat.rows(); ++i)
+        for (int j = 0; j < mat.cols(); ++j)
+            result[j, i] = mat[i, j];
+    return result;
+}
+
+TEST_CASE_TEMPLATE("Matrix-Matrix multiplication into an existing matrix", S, ET_type<double>, RG_type<double>)
+{
+    using Matrix = S::Matrix;
+
+    Matrix a = Matrix::randn(23, 31, 0., 1., 1e-8);
+    Matrix b = Matrix::randn(31, 19, 0., 1., 1e-8);
+    Matrix c0 = Matrix::randn(23, 19, 0., 1., 1e-8);
+    Matrix product = multiply_by_hand<Matrix>(a, b);
+
+    SUBCASE("overwrite")
+    {
+        Matrix c = Matrix::Constant(23, 19, std::numeric_limits<double>::quiet_NaN());
+        gemm_into(c, a, b);
+        CHECK(APPROX_EQ(c, product));
+    }
+    SUBCASE("alpha and beta")
+    {
+        Matrix c = c0;
+        gemm_into(c, a, b, 2., -0.5);
+        Matrix expected = 2. * product - 0.5 * c0;
+        CHECK(APPROX_EQ(c, expected));
+    }
+    SUBCASE("transposes")
+    {
+        Matrix at = transpose_by_hand(a);
+        Matrix bt = transpose_by_hand(b);
+        Matrix c(23, 19);
+        gemm_into(c, at, b, 1., 0., true, false);
+        CHECK(APPROX_EQ(c, product));
+        gemm_into(c, a, bt, 1., 0., false, true);
+        CHECK(APPROX_EQ(c, product));
+        gemm_into(c, at, bt, 1., 0., true, true);
+        CHECK(APPROX_EQ(c, product));
+    }
+    SUBCASE("expressions")
+    {
+        Matrix c(23, 19);
+        gemm_into(c, a + a, b);
+        Matrix expected = 2. * product;
+        CHECK(APPROX_EQ(c, expected));
+    }
+    SUBCASE("chains")
+    {
+        LinAlg::Matrices::Common::ChainWorkspace<double> workspace;
+        Matrix d = Matrix::randn(19, 4, 0., 1., 1e-8);
+        Matrix e = Matrix::randn(4, 27, 0., 1., 1e-8);
+
+        // Evaluated from the left.
+        Matrix wide(23, 27);
+        mat_mult_into(wide, workspace, a, b, d, e);
+        Matrix expected_wide = multiply_by_hand<Matrix>(multiply_by_hand<Matrix>(product, d), e);
+        CHECK(APPROX_EQ(wide, expected_wide));
+
+        // Evaluated from the right.
+        Matrix skinny(23, 4);
+        mat_mult_into(skinny, workspace, a, b - b + b, d);
+        Matrix expected_skinny = multiply_by_hand<Matrix>(product, d);
+        CHECK(APPROX_EQ(skinny, expected_skinny));
+    }
+}
+
+TEST_CASE_TEMPLATE("Strassen multiplication", S, ET_type<double>, RG_type<double>)
+{
+    using Matrix = S::Matrix;
+
+    // Odd and non power of two sizes, with a small cutoff to get three levels of recursion: 199 -> 99 -> 49 -> 24.
+    const int m = 257;
+    const int k = 199;
+    const int n = 131;
+    const int cutoff = 32;
+    const int levels = 3;
+    Matrix lhs = Matrix::randn(m, k, 0., 1., 1e-8);
+    Matrix rhs = Matrix::randn(k, n, 0., 1., 1e-8);
+
+    // Each level of recursion can increase the rounding error of the standard product, bounded by k * eps * max|lhs| * max|rhs|, by a factor 12.
+    const auto max_abs = [](const Matrix& mat)
+    {
+        double value = 0.;
+        for (int i = 0; i < mat.size(); ++i)
+            value = std::max(value, std::abs(mat[i]));
+        return value;
+    };
+    const double bound = std::pow(12., levels) * k * std::numeric_limits<double>::epsilon() * max_abs(lhs) * max_abs(rhs);
+    const auto max_error = [&](const Matrix& result, const Matrix& expected)
+    {
+        double error = 0.;
+        for (int i = 0; i < result.size(); ++i)
+            error = std::max(error, std::abs(result[i] - expected[i]));
+        return error;
+    };
+
+    SUBCASE("matrices")
+    {
+        Matrix result = strassen_mult(lhs, rhs, cutoff);
+        Matrix expected = multiply_by_hand<Matrix>(lhs, rhs);
+        CHECK_EQ(result.rows(), m);
+        CHECK_EQ(result.cols(), n);
+        CHECK_LE(max_error(result, expected), bound);
+    }
+    SUBCASE("expressions")
+    {
+        Matrix result = strassen_mult(lhs * 2., rhs, cutoff);
+        Matrix lhs2 = lhs * 2.;
+        Matrix expected = multiply_by_hand<Matrix>(lhs2, rhs);
+        CHECK_LE(max_error(result, expected), 2. * bound);
+    }
+    SUBCASE("below the cutoff")
+    {
+        Matrix result = strassen_mult(lhs, rhs);
+        Matrix expected = mat_mult(lhs, rhs);
+        CHECK(APPROX_EQ(result, expected));
+    }
+}
+
+TEST_CASE_TEMPLATE("Symmetric rank-k update", S, ET_type<double>, RG_type<double>)
+{
+    namespace Kernels = LinAlg::Matrices::Kernels;
+    using Matrix = S::Matrix;
+    using Kernels::Triangle;
+
+    // Returns true if the triangle uplo of result matches expected.
+    const auto triangle_approx_eq = [](const Matrix& result, const Matrix& expected, Triangle uplo)
+    {
+        for (int i = 0; i < expected.rows(); ++i)
+            for (int j = 0; j < expected.cols(); ++j)
+                if ((uplo == Triangle::Lower ? j <= i : j >= i) && std::abs(result[i, j] - expected[i, j]) > 1e-10 * (1. + std::abs(expected[i, j])))
+                    return false;
+        return true;
+    };
+
+    // Sizes below the packing threshold, and sizes with several blocks which are not multiples of the block size.
+    for (auto [n, k] : { std::pair { 7, 5 }, std::pair { 300, 150 } })
+    {
+        CAPTURE(n);
+        CAPTURE(k);
+        Matrix a = Matrix::randn(n, k, 0., 1., 1e-8);
+        Matrix at = transpose_by_hand(a);
+        Matrix aat = multiply_by_hand<Matrix>(a, at);
+        Matrix ata = multiply_by_hand<Matrix>(at, a);
+
+        SUBCASE("full result")
+        {
+            CHECK(APPROX_EQ(syrk(a), aat));
+            CHECK(APPROX_EQ(syrk(a, true), ata));
+            CHECK(APPROX_EQ(syrk(a, false, Triangle::Upper), aat));
+            CHECK(APPROX_EQ(syrk(a + a, true), 4. * ata));
+        }
+        SUBCASE("one triangle")
+        {
+            for (Triangle uplo : { Triangle::Lower, Triangle::Upper })
+            {
+                Matrix c = Matrix::Constant(n, n, std::numeric_limits<double>::quiet_NaN());
+                syrk_into(c, a, 1., 0., false, uplo, false);
+                CHECK(triangle_approx_eq(c, aat, uplo));
+
+                // The other triangle is not written.
+                const Triangle other = uplo == Triangle::Lower ? Triangle::Upper : Triangle::Lower;
+                bool untouched = true;
+                for (int i = 0; i < n; ++i)
+                    for (int j = 0; j < n; ++j)
+                        if (i != j && (other == Triangle::Lower ? j < i : j > i))
+                            untouched &= std::isnan(c[i, j]);
+                CHECK(untouched);
+
+                Matrix c_zero = syrk(a, false, uplo, false);
+                CHECK(triangle_approx_eq(c_zero, aat, uplo));
+                CHECK_EQ(c_zero[uplo == Triangle::Lower ? 0 : n - 1, uplo == Triangle::Lower ? n - 1 : 0], 0.);
+            }
+        }
+        SUBCASE("alpha and beta")
+        {
+            Matrix c0 = multiply_by_hand<Matrix>(Matrix::randn(n, 3, 0., 1., 1e-8, 1), Matrix::randn(3, n, 0., 1., 1e-8, 1));
+            c0 = c0 + transpose_by_hand(c0);
+            Matrix c = c0;
+            syrk_into(c, at, 2., -0.5, true);
+            Matrix expected = 2. * aat - 0.5 * c0;
+            CHECK(APPROX_EQ(c, expected));
+        }
+    }
+
+    SUBCASE("multiple threads")
+    {
+        const int initial_threads = Kernels::num_threads();
+        Kernels::set_num_threads(3);
+        Matrix a = Matrix::randn(200, 180, 0., 1., 1e-8);
+        Matrix ata = multiply_by_hand<Matrix>(transpose_by_hand(a), a);
+        CHECK(APPROX_EQ(syrk(a, true), ata));
+        Kernels::set_num_threads(initial_threads);
+    }
+}
+
+TEST_CASE_TEMPLATE("Matrix-Matrix multiplication on multiple threads", S, ET_type<double>, RG_type<double>)
+{
+    namespace Kernels = LinAlg::Matrices::Kernels;
+    using Matrix = S::Matrix;
+
+    const int initial_threads = Kernels::num_threads();
+    Kernels::set_num_threads(3);
+    CHECK_EQ(Kernels::num_threads(), 3);
+
+    // Large enough to be split into tiles, with sizes which are not multiples of the tiles.
+    Matrix lhs = Matrix::randn(150, 131, 0., 1., 1e-8);
+    Matrix rhs = Matrix::randn(131, 141, 0., 1., 1e-8);
+    Matrix expected = multiply_by_hand<Matrix>(lhs, rhs);
+
+    Matrix result = mat_mult(lhs, rhs);
+    CHECK(APPROX_EQ(result, expected));
+
+    Kernels::set_num_threads(1);
+    Matrix serial_result = mat_mult(lhs, rhs);
+    CHECK(APPROX_EQ(serial_result, expected));
+
+    Kernels::set_num_threads(initial_threads);
+}
+
+/*
+ Fills a matrix with a deterministic pattern of integers in [-max_abs, max_abs].
+*/
+template <typename Matrix>
+Matrix integer_matrix(int rows, int cols, int max_abs, int seed)
+{
+    Matrix mat(rows, cols);
+    for (int i = 0; i < rows; ++i)
+        for (int j = 0; j < cols; ++j)
+            mat[i, j] = static_cast<typename Matrix::Scalar>((i * 7919 + j * 104729 + seed * 15485863) % (2 * max_abs + 1) - max_abs);
+    return mat;
+}
+
+/*
+ Fills a matrix with a deterministic pattern of integers at most max_offset away from the limits of its scalar type, alternating between the
+ lowest and the highest values.
+*/
+template <typename Matrix>
+Matrix near_limits_matrix(int rows, int cols, int max_offset, int seed)
+{
+    using T = typename Matrix::Scalar;
+    Matrix mat(rows, cols);
+    for (int i = 0; i < rows; ++i)
+        for (int j = 0; j < cols; ++j)
+        {
+            const int offset = (i * 7919 + j * 104729 + seed * 15485863) % (max_offset + 1);
+            mat[i, j] = (i + j + seed) % 2 ? static_cast<T>(std::numeric_limits<T>::max() - offset) : static_cast<T>(std::numeric_limits<T>::min() + offset);
+        }
+    return mat;
+}
+
+TEST_CASE_TEMPLATE("Integer Matrix-Matrix multiplication", S, ET_type<int>, RG_type<int>)
+{
+    using Matrix = S::Matrix;
+    using Matrixi8 = S::template MatrixOf<std::int8_t>;
+    using Matrixi16 = S::template MatrixOf<std::int16_t>;
+    using Matrixi64 = S::template MatrixOf<std::int64_t>;
+
+    SUBCASE("int matrices")
+    {
+        Matrix lhs = integer_matrix<Matrix>(37, 53, 1000, 1);
+        Matrix rhs = integer_matrix<Matrix>(53, 29, 1000, 2);
+        Matrix result = mat_mult(lhs, rhs);
+        Matrix expected = multiply_by_hand<Matrix>(lhs, rhs);
+        CHECK(APPROX_EQ(result, expected));
+
+        Matrix result_expr = mat_mult(lhs + lhs, rhs);
+        Matrix lhs2 = lhs + lhs;
+        CHECK(APPROX_EQ(result_expr, multiply_by_hand<Matrix>(lhs2, rhs)));
+    }
+    SUBCASE("int matrix-vector products with an intermediate overflow")
+    {
+        // The partial sums overflow int, not the results: the vector products are accumulated in 64 bit like the matrix products.
+        const int max = std::numeric_limits<int>::max();
+        Matrix lhs { { max, 1, -1 }, { 1, max, -max } };
+        Matrix col { { 1 }, { 1 }, { 1 } };
+        CHECK(APPROX_EQ(mat_mult(lhs, col), Matrix { { max }, { 1 } }));
+
+        Matrix row { { 1, 1, 1 } };
+        Matrix rhs { { max, 1 }, { 1, max }, { -1, -max } };
+        CHECK(APPROX_EQ(mat_mult(row, rhs), Matrix { { max, 1 } }));
+    }
+    SUBCASE("int8 matrices are accumulated in 32 bit")
+    {
+        Matrixi8 lhs = integer_matrix<Matrixi8>(19, 301, 127, 3);
+        Matrixi8 rhs = integer_matrix<Matrixi8>(301, 23, 127, 4);
+        auto result = widening_mult(lhs, rhs);
+        static_assert(std::is_same_v<typename decltype(result)::Scalar, std::int32_t>);
+
+        using Matrixi32 = S::template MatrixOf<std::int32_t>;
+        Matrixi32 lhs32 = integer_matrix<Matrixi32>(19, 301, 127, 3);
+        Matrixi32 rhs32 = integer_matrix<Matrixi32>(301, 23, 127, 4);
+        CHECK(APPROX_EQ(result, multiply_by_hand<Matrixi32>(lhs32, rhs32)));
+    }
+    SUBCASE("int16 matrices overflowing 32 bit")
+    {
+        // 301 products of magnitude up to 30000^2 overflow 32 bit, the result is exact in 64 bit.
+        Matrixi16 lhs = integer_matrix<Matrixi16>(41, 301, 30000, 5);
+        Matrixi16 rhs = integer_matrix<Matrixi16>(301, 17, 30000, 6);
+        Matrixi64 result = widening_mult<std::int64_t>(lhs, rhs);
+
+        Matrixi64 lhs64 = integer_matrix<Matrixi64>(41, 301, 30000, 5);
+        Matrixi64 rhs64 = integer_matrix<Matrixi64>(301, 17, 30000, 6);
+        Matrixi64 expected = multiply_by_hand<Matrixi64>(lhs64, rhs64);
+        CHECK(APPROX_EQ(result, expected));
+
+        bool overflows_32_bit = false;
+        for (int i = 0; i < expected.size(); ++i)
+            overflows_32_bit |= std::abs(expected[i]) > std::numeric_limits<std::int32_t>::max();
+        CHECK(overflows_32_bit);
+    }
+    SUBCASE("unsigned matrices near the type limits")
+    {
+        using Matrixu8 = S::template MatrixOf<std::uint8_t>;
+        using Matrixu16 = S::template MatrixOf<std::uint16_t>;
+        using Matrixu32 = S::template MatrixOf<std::uint32_t>;
+        using Matrixu64 = S::template MatrixOf<std::uint64_t>;
+
+        Matrixu8 lhs8 = near_limits_matrix<Matrixu8>(19, 301, 3, 1);
+        Matrixu8 rhs8 = near_limits_matrix<Matrixu8>(301, 23, 3, 2);
+        auto result8 = widening_mult(lhs8, rhs8);
+        static_assert(std::is_same_v<typename decltype(result8)::Scalar, std::int32_t>);
+        CHECK(APPROX_EQ(Matrixi64(result8), multiply_by_hand<Matrixi64>(Matrixi64(lhs8), Matrixi64(rhs8))));
+
+        // uint16 values do not fit in the 16 bit packed type, and 301 of their products overflow 32 bit.
+        Matrixu16 lhs16 = near_limits_matrix<Matrixu16>(41, 301, 7, 3);
+        Matrixu16 rhs16 = near_limits_matrix<Matrixu16>(301, 17, 7, 4);
+        auto result16 = widening_mult(lhs16, rhs16);
+        static_assert(std::is_same_v<typename decltype(result16)::Scalar, std::uint64_t>);
+        CHECK(APPROX_EQ(result16, multiply_by_hand<Matrixu64>(Matrixu64(lhs16), Matrixu64(rhs16))));
+
+        // A product of two uint32 values close to the maximum only fits in 64 bit unsigned.
+        Matrixu32 lhs32 = near_limits_matrix<Matrixu32>(13, 1, 7, 5);
+        Matrixu32 rhs32 = near_limits_matrix<Matrixu32>(1, 11, 7, 6);
+        auto result32 = widening_mult(lhs32, rhs32);
+        static_assert(std::is_same_v<typename decltype(result32)::Scalar, std::uint64_t>);
+        Matrixu64 expected32 = multiply_by_hand<Matrixu64>(Matrixu64(lhs32), Matrixu64(rhs32));
+        CHECK(APPROX_EQ(result32, expected32));
+        bool overflows_signed_64_bit = false;
+        for (int i = 0; i < expected32.size(); ++i)
+            overflows_signed_64_bit |= expected32[i] > static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max());
+        CHECK(overflows_signed_64_bit);
+    }
+    SUBCASE("mixed-sign matrices near the type limits")
+    {
+        using Matrixu16 = S::template MatrixOf<std::uint16_t>;
+        using Matrixi32 = S::template MatrixOf<std::int32_t>;
+        using Matrixu32 = S::template MatrixOf<std::uint32_t>;
+
+        Matrixi8 lhs8 = near_limits_matrix<Matrixi8>(29, 301, 3, 7);
+        Matrixu16 rhs16 = near_limits_matrix<Matrixu16>(301, 31, 7, 8);
+        Matrixi64 result = widening_mult<std::int64_t>(lhs8, rhs16);
+        CHECK(APPROX_EQ(result, multiply_by_hand<Matrixi64>(Matrixi64(lhs8), Matrixi64(rhs16))));
+
+        Matrixi32 lhs32 = near_limits_matrix<Matrixi32>(13, 1, 7, 9);
+        Matrixu32 rhs32 = near_limits_matrix<Matrixu32>(1, 11, 7, 10);
+        Matrixi64 result32 = widening_mult<std::int64_t>(lhs32, rhs32);
+        CHECK(APPROX_EQ(result32, multiply_by_hand<Matrixi64>(Matrixi64(lhs32), Matrixi64(rhs32))));
+    }
+    SUBCASE("int matrices on multiple threads")
+    {
+        namespace Kernels = LinAlg::Matrices::Kernels;
+        const int initial_threads = Kernels::num_threads();
+        Kernels::set_num_threads(3);
+
+        Matrix lhs = integer_matrix<Matrix>(150, 131, 100, 7);
+        Matrix rhs = integer_matrix<Matrix>(131, 141, 100, 8);
+        Matrixi64 result = widening_mult(lhs, rhs);
+        Matrixi64 lhs64 = integer_matrix<Matrixi64>(150, 131, 100, 7);
+        Matrixi64 rhs64 = integer_matrix<Matrixi64>(131, 141, 100, 8);
+        CHECK(APPROX_EQ(result, multiply_by_hand<Matrixi64>(lhs64, rhs64)));
+
+        Kernels::set_num_threads(initial_threads);
+    }
+}
+
+TEST_CASE_TEMPLATE("Mixed precision Matrix-Matrix multiplication", S, ET_type<double>, RG_type<double>)
+{
+    using Matrix = S::Matrix;
+    using Matrixf = S::template MatrixOf<float>;
+
+    // The errors are measured against the double product of the same float values, relatively to the magnitude of each coefficient.
+    const auto max_relative_error = [](const Matrixf& result, const Matrix& expected, const Matrix& magnitude)
+    {
+        double error = 0.;
+        for (int i = 0; i < result.size(); ++i)
+            error = std::max(error, std::abs(static_cast<double>(result[i]) - expected[i]) / magnitude[i]);
+        return error;
+    };
+    const auto check_mixed_product = [&](const Matrixf& lhs, const Matrixf& rhs)
+    {
+        Matrix lhs_d(lhs);
+        Matrix rhs_d(rhs);
+        Matrix expected = mat_mult(lhs_d, rhs_d);
+        Matrix magnitude = mat_mult(lhs_d.apply([](double x) { return std::abs(x); }), rhs_d.apply([](double x) { return std::abs(x); }));
+
+        Matrixf mixed = mat_mult<double>(lhs, rhs);
+        Matrixf single = mat_mult(lhs, rhs);
+        const double mixed_error = max_relative_error(mixed, expected, magnitude);
+        const double single_error = max_relative_error(single, expected, magnitude);
+
+        // Accumulating in double over the whole inner dimension, the only error left is the final rounding to float, at most half an epsilon
+        // relatively to the coefficient. The margin, relative to the magnitude, covers the rounding errors of the double products.
+        double rounding_excess = 0.;
+        for (int i = 0; i < mixed.size(); ++i)
+        {
+            const double rounding = 0.5 * std::numeric_limits<float>::epsilon() * std::abs(expected[i]);
+            rounding_excess = std::max(rounding_excess, (std::abs(static_cast<double>(mixed[i]) - expected[i]) - rounding) / magnitude[i]);
+        }
+        CHECK_LE(rounding_excess, 1e-10);
+        CHECK_LT(mixed_error, single_error);
+    };
+
+    SUBCASE("matrices")
+    {
+        // Inner dimensions just above one slice of the blocked product (BlockSizes::KC) and much larger.
+        check_mixed_product(Matrixf::randn(37, 257, 0.f, 1.f, 0.f, 1), Matrixf::randn(257, 29, 0.f, 1.f, 0.f, 2));
+        check_mixed_product(Matrixf::randn(37, 3001, 0.f, 1.f, 0.f, 1), Matrixf::randn(3001, 29, 0.f, 1.f, 0.f, 2));
+        check_mixed_product(Matrixf::randn(150, 20000, 0.f, 1.f, 0.f, 3), Matrixf::randn(20000, 140, 0.f, 1.f, 0.f, 4));
+    }
+    SUBCASE("matrix-vector")
+    {
+        check_mixed_product(Matrixf::randn(37, 3001, 0.f, 1.f, 0.f, 3), Matrixf::randn(3001, 1, 0.f, 1.f, 0.f, 4));
+        check_mixed_product(Matrixf::randn(1, 3001, 0.f, 1.f, 0.f, 5), Matrixf::randn(3001, 29, 0.f, 1.f, 0.f, 6));
+    }
+    SUBCASE("expressions and chains")
+    {
+        Matrixf lhs = Matrixf::randn(20, 30, 0.f, 1.f, 0.f, 7);
+        Matrixf mid = Matrixf::randn(30, 40, 0.f, 1.f, 0.f, 8);
+        Matrixf rhs = Matrixf::randn(40, 10, 0.f, 1.f, 0.f, 9);
+        Matrixf result = mat_mult<double>(lhs + lhs, mid, rhs);
+        Matrix expected = mat_mult(Matrix(lhs + lhs), Matrix(mid), Matrix(rhs));
+        CHECK(APPROX_EQ(Matrix(result), expected, 1e-5, 1e-4));
+
+        Matrixf result_eval = mat_mult<double, true>(lhs + lhs, mid + mid, rhs + rhs);
+        CHECK(APPROX_EQ(Matrix(result_eval), 4. * expected, 1e-5, 1e-4));
+    }
+}
@@ -1,5 +1,8 @@
 #include <backends.hpp>
 #include <doctest/doctest.h>
+#include <csignal>
+#include <sys/wait.h>
+#include <unistd.h>
 
 TEST_CASE_TEMPLATE("Constant matrix", S, ET_type<double>, RG_type<double>)
 {
@@ -34,3 +37,88 @@ TEST_CASE_TEMPLATE("Identity Matrix", S, ET_type<double>, RG_type<double>)
 
     CHECK(APPROX_EQ(identity, expected));
 }
+
+TEST_CASE_TEMPLATE("Products with helper matrices", S, ET_type<double>, RG_type<double>)
+{
+    using Matrix = S::Matrix;
+    using Zero = S::Zero;
+    using Identity = S::Identity;
+    using Constant = S::Constant;
+    using LinAlg::Matrices::Common::mat_mult;
+
+    Matrix a = Matrix::randn(5, 7, 0., 1., 0., 1);
+    Matrix b = Matrix::randn(7, 4, 0., 1., 0., 2);
+    Matrix ab = mat_mult(a, b);
+
+    SUBCASE("identity")
+    {
+        CHECK(APPROX_EQ(mat_mult(Identity(5), a), a));
+        CHECK(APPROX_EQ(mat_mult(a, Identity(7)), a));
+        CHECK(APPROX_EQ(mat_mult(Identity(5), a + a), 2. * a));
+        CHECK(APPROX_EQ(mat_mult(Identity(5), a, Identity(7), b, Identity(4)), ab));
+
+        auto identity = mat_mult(Identity(3), Identity(3));
+        static_assert(std::is_same_v<decltype(identity), Identity>);
+        CHECK_EQ(identity.rows(), 3);
+    }
+    SUBCASE("zero")
+    {
+        auto zero = mat_mult(a, Zero(7, 3));
+        static_assert(std::is_same_v<decltype(zero), Zero>);
+        CHECK(APPROX_EQ(zero, Matrix::Zero(5, 3)));
+
+        auto chain = mat_mult(Zero(2, 5), a, b);
+        static_assert(std::is_same_v<decltype(chain), Zero>);
+        CHECK_EQ(chain.rows(), 2);
+        CHECK_EQ(chain.cols(), 4);
+    }
+    SUBCASE("constant")
+    {
+        CHECK(APPROX_EQ(mat_mult(Constant(3, 5, 2.), a), mat_mult(Matrix::Constant(3, 5, 2.), a)));
+        CHECK(APPROX_EQ(mat_mult(a, Constant(7, 2, -1.5)), mat_mult(a, Matrix::Constant(7, 2, -1.5))));
+        auto constant = mat_mult(Constant(3, 5, 2.), Constant(5, 2, 3.));
+        static_assert(std::is_same_v<decltype(constant), Constant>);
+        CHECK(APPROX_EQ(constant, Matrix::Constant(3, 2, 30.)));
+        CHECK(APPROX_EQ(mat_mult(Constant(3, 5, 2.), a, b), mat_mult(Matrix::Constant(3, 5, 2.), ab)));
+    }
+}
+
+#ifndef NDEBUG
+/*
+    Returns true if f aborts, for instance on a failed assertion. It is run in a child process.
+*/
+template <typename Func>
+bool aborts(Func&& f)
+{
+    const pid_t pid = fork();
+    if (pid == 0)
+    {
+        std::freopen("/dev/null", "w", stderr);
+        f();
+        std::_Exit(0);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT;
+}
+
+TEST_CASE_TEMPLATE("Products with helper matrices of mismatched dimensions", S, ET_type<double>, RG_type<double>)
+{
+    using Matrix = S::Matrix;
+    using Zero = S::Zero;
+    using Identity = S::Identity;
+    using LinAlg::Matrices::Common::mat_mult;
+
+    const Matrix a = Matrix::randn(5, 7, 0., 1., 0., 1);
+    const Matrix b = Matrix::randn(7, 4, 0., 1., 0., 2);
+
+    // The products short-circuited by Zero and Identity matrices check the dimensions of the whole chain.
+    CHECK(aborts([&] { (void)mat_mult(Zero(3, 4), a); }));
+    CHECK(aborts([&] { (void)mat_mult(a, Zero(6, 3)); }));
+    CHECK(aborts([&] { (void)mat_mult(Zero(2, 5), a, Matrix(6, 4)); }));
+    CHECK(aborts([&] { (void)mat_mult(Identity(3), Identity(4)); }));
+    CHECK(aborts([&] { (void)mat_mult(a, Identity(6), b); }));
+    CHECK_FALSE(aborts([&] { (void)mat_mult(Zero(3, 5), a, b); }));
+    CHECK_FALSE(aborts([&] { (void)mat_mult(a, Identity(7), b); }));
+}
+#endif
@@ -0,0 +1,101 @@
+#include <backends.hpp>
+#include <doctest/doctest.h>
+
+using LinAlg::Matrices::Common::MapAccess;
+using LinAlg::Matrices::Common::MapMode;
+using LinAlg::Matrices::Common::MappedArray;
+
+TEST_CASE_TEMPLATE("Mapped matrices", S, ET_type<double>, RG_type<double>)
+{
+    using Matrix = S::Matrix;
+    using MappedMatrix = S::MappedMatrix;
+    using Scalar = S::Scalar;
+
+    const int rows = 53;
+    const int cols = 41;
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "linalg_mapped_matrix_test.bin";
+    const Matrix a = Matrix::randn(rows, cols, 0., 1., 0., 1);
+    const Matrix b = Matrix::randn(cols, rows, 0., 1., 0., 2);
+
+    // Write a matrix through a read-write mapping of a new file.
+    {
+        MappedMatrix written(rows, cols, MappedArray<Scalar>::create(path, rows * cols));
+        REQUIRE(written.data().is_file());
+        CHECK(APPROX_EQ(written, Matrix::Zero(rows, cols)));
+        written = a;
+        written.data().flush();
+    }
+    REQUIRE(std::filesystem::file_size(path) == rows * cols * sizeof(Scalar));
+
+    SUBCASE("read-only")
+    {
+        const MappedMatrix m(rows, cols, MappedArray<Scalar>::open(path));
+        CHECK(m.data().read_only());
+        CHECK(APPROX_EQ(m, a));
+        CHECK(APPROX_EQ(Matrix(m + 2. * m), Matrix(3. * a)));
+        CHECK(APPROX_EQ(mat_mult(m, b), mat_mult(a, b)));
+        CHECK_LE(std::abs(LinAlg::Matrices::Common::sum(m) - LinAlg::Matrices::Common::sum(a)), 1e-10);
+
+        m.data().advise(MapAccess::Random);
+        CHECK_EQ(m[rows - 1, cols - 1], a[rows - 1, cols - 1]);
+
+        // A copy is in memory, and can be written.
+        MappedMatrix copy(m);
+        CHECK_FALSE(copy.data().is_file());
+        copy[0, 0] = 42.;
+        CHECK_EQ(copy[0, 0], 42.);
+        CHECK_EQ(m[0, 0], a[0, 0]);
+    }
+    SUBCASE("offset and size")
+    {
+        const MappedMatrix first_rows(2, cols, MappedArray<Scalar>::open(path, MapMode::ReadOnly, MapAccess::Normal, 0, 2 * cols));
+        CHECK_EQ(first_rows.data().size(), static_cast<std::size_t>(2 * cols));
+        const MappedMatrix last_row(1, cols, MappedArray<Scalar>::open(path, MapMode::ReadOnly, MapAccess::Normal, (rows - 1) * cols * sizeof(Scalar)));
+        for (int j = 0; j < cols; ++j)
+        {
+            CHECK_EQ(first_rows[1, j], a[1, j]);
+            CHECK_EQ(last_row[0, j], a[rows - 1, j]);
+        }
+    }
+    SUBCASE("errors")
+    {
+        CHECK_THROWS_AS(MappedArray<Scalar>::open(path.string() + ".missing"), std::system_error);
+        CHECK_THROWS_AS(MappedArray<Scalar>::open(path, MapMode::ReadOnly, MapAccess::Normal, 0, rows * cols + 1), std::system_error);
+
+        // Writing into a read-only mapping throws instead of faulting, and leaves the file unchanged.
+        MappedMatrix read_only(rows, cols, MappedArray<Scalar>::open(path));
+        const MappedMatrix other(Matrix(a + 1.));
+        CHECK_THROWS_AS(read_only = Matrix(a + 1.), std::logic_error);
+        CHECK_THROWS_AS(read_only = a + 1., std::logic_error);
+        CHECK_THROWS_AS(read_only = other, std::logic_error);
+        CHECK_THROWS_AS(read_only.apply_inplace([](Scalar& x) { return x + 1.; }), std::logic_error);
+        CHECK_THROWS_AS(read_only.zero(), std::logic_error);
+        CHECK_THROWS_AS(read_only.set(1.), std::logic_error);
+        CHECK_THROWS_AS(read_only.block(0, 0, 2, 2), std::logic_error);
+        CHECK_THROWS_AS(read_only.row(0), std::logic_error);
+        CHECK_THROWS_AS(read_only.col(0), std::logic_error);
+        CHECK_THROWS_AS(read_only.transpose(), std::logic_error);
+        CHECK_THROWS_AS(read_only.diagonal(), std::logic_error);
+
+        // The reads are allowed, also through the non-const matrix.
+        bool equal = true;
+        for (int i = 0; i < rows; ++i)
+            for (int j = 0; j < cols; ++j)
+                equal = equal && read_only[i, j] == a[i, j];
+        CHECK(equal);
+        CHECK_EQ(read_only[rows * cols - 1], a[rows - 1, cols - 1]);
+        CHECK(APPROX_EQ(read_only, a));
+        CHECK(APPROX_EQ(Matrix(std::as_const(read_only).row(1)), Matrix(a.row(1))));
+    }
+    SUBCASE("read-write")
+    {
+        {
+            MappedMatrix m(rows, cols, MappedArray<Scalar>::open(path, MapMode::ReadWrite));
+            m = m + 1.;
+        }
+        const MappedMatrix m(rows, cols, MappedArray<Scalar>::open(path));
+        CHECK(APPROX_EQ(m, Matrix(a + 1.)));
+    }
+
+    std::filesystem::remove(path);
+}
@@ -257,3 +257,62 @@ TEST_CASE_TEMPLATE("Matrix::apply", S, ET_type<double>, RG_type<double>)
         CHECK(APPROX_EQ(fun_m, expected));
     }
 }
+
+TEST_CASE_TEMPLATE("Matrix temporaries in an arena", S, ET_type<double>, RG_type<double>)
+{
+    using Matrix = S::Matrix;
+    using LinAlg::Matrices::Common::Arena;
+    using LinAlg::Matrices::Common::ArenaScope;
+
+    Matrix a = Matrix::randn(20, 30, 0., 1., 0., 1);
+    Matrix b = Matrix::randn(30, 5, 0., 1., 0., 2);
+    Matrix c = Matrix::randn(5, 40, 0., 1., 0., 3);
+    Matrix d = Matrix::randn(40, 10, 0., 1., 0., 4);
+    const Matrix chain = mat_mult(a, b, c, d);
+    const Matrix pre_eval = mat_mult<true>(a + a, b * 2.);
+
+    // The arena is too small for all the temporaries of the first scope, hence some of them are taken from the heap.
+    Arena arena(4096);
+    Matrix res_chain;
+    Matrix res_pre_eval;
+    for (int iteration = 0; iteration < 3; ++iteration)
+    {
+        ArenaScope scope(arena);
+        res_chain = mat_mult(a, b, c, d);
+        res_pre_eval = mat_mult<true>(a + a, b * 2.);
+    }
+
+    // The results do not use the memory of the arena, which the next scope overwrites.
+    {
+        ArenaScope scope(arena);
+        Matrix twice = mat_mult(a, b * 2., c, d);
+        CHECK(APPROX_EQ(twice, Matrix(chain * 2.)));
+    }
+    CHECK(APPROX_EQ(res_chain, chain));
+    CHECK(APPROX_EQ(res_pre_eval, pre_eval));
+}
+
+TEST_CASE_TEMPLATE("Matrix::Matrix(rows, cols, uninitialized)", S, ET_type<double>, RG_type<double>)
+{
+    using Matrix = S::Matrix;
+    using LinAlg::Matrices::Common::uninitialized;
+
+    // The memory of a freed matrix is likely reused: the value initialized matrices are zero anyway.
+    {
+        Matrix filled = Matrix::Constant(30, 40, 7.);
+    }
+    Matrix zero(30, 40);
+    CHECK(APPROX_EQ(zero, Matrix::Zero(30, 40)));
+
+    Matrix m(30, 40, uninitialized);
+    CHECK_EQ(m.shape(), std::make_pair<int, int>(30, 40));
+    CHECK_EQ(m.leading_dimension(), 40);
+    CHECK_EQ(m.data().size(), 1200);
+    m.set(2.);
+    CHECK(APPROX_EQ(m, Matrix::Constant(30, 40, 2.)));
+
+    Matrix a = Matrix::randn(30, 20, 0., 1., 0., 1);
+    Matrix b = Matrix::randn(20, 40, 0., 1., 0., 2);
+    CHECK(APPROX_EQ(mat_mult(a, b) - mat_mult(a, b), zero));
+    CHECK(APPROX_EQ(Matrix(a + a), Matrix(a * 2.)));
+}
@@ -0,0 +1,80 @@
+#include <backends.hpp>
+#include <doctest/doctest.h>
+
+using LinAlg::Matrices::Common::dot;
+using LinAlg::Matrices::Common::norm;
+using LinAlg::Matrices::Common::sum;
+
+double relative_error(double result, double expected)
+{
+    return std::abs(result - expected) / std::abs(expected);
+}
+
+TEST_CASE_TEMPLATE("Reductions", S, ET_type<double>, RG_type<double>)
+{
+    using Matrix = S::Matrix;
+
+    Matrix lhs = Matrix::randn(37, 41, 0., 1., 0., 1);
+    Matrix rhs = Matrix::randn(37, 41, 0., 1., 0., 2);
+    double expected_sum = 0.;
+    double expected_dot = 0.;
+    for (int i = 0; i < lhs.size(); ++i)
+    {
+        expected_sum += lhs[i];
+        expected_dot += lhs[i] * rhs[i];
+    }
+
+    SUBCASE("matrices")
+    {
+        CHECK_LE(relative_error(sum(lhs), expected_sum), 1e-12);
+        CHECK_LE(relative_error(dot(lhs, rhs), expected_dot), 1e-12);
+        CHECK_LE(relative_error(norm(lhs), std::sqrt(dot(lhs, lhs))), 1e-12);
+    }
+    SUBCASE("expressions")
+    {
+        CHECK_LE(relative_error(sum(lhs + rhs), expected_sum + sum(rhs)), 1e-12);
+        CHECK_LE(relative_error(dot(lhs + lhs, rhs), 2. * expected_dot), 1e-12);
+    }
+}
+
+TEST_CASE_TEMPLATE("Mixed precision reductions", S, ET_type<double>, RG_type<double>)
+{
+    namespace Kernels = LinAlg::Matrices::Kernels;
+    using Matrix = S::Matrix;
+    using Matrixf = S::template MatrixOf<float>;
+
+    // Many chunks of the parallel reduction, with positive terms so that the float rounding errors accumulate.
+    Matrixf lhs = Matrixf::randn(1000, 301, 1.f, 0.5f, 0.f, 3);
+    Matrixf rhs = Matrixf::randn(1000, 301, 1.f, 0.5f, 0.f, 4);
+    Matrix lhs_d(lhs);
+    Matrix rhs_d(rhs);
+    double expected_sum = 0.;
+    double expected_dot = 0.;
+    for (int i = 0; i < lhs_d.size(); ++i)
+    {
+        expected_sum += lhs_d[i];
+        expected_dot += lhs_d[i] * rhs_d[i];
+    }
+
+    const auto mixed_sum = sum<double>(lhs);
+    const auto mixed_dot = dot<double>(lhs, rhs);
+    static_assert(std::is_same_v<decltype(mixed_sum), const double>);
+    CHECK_LE(relative_error(mixed_sum, expected_sum), 1e-12);
+    CHECK_LE(relative_error(mixed_dot, expected_dot), 1e-12);
+    CHECK_LE(relative_error(norm<double>(lhs), std::sqrt(dot(lhs_d, lhs_d))), 1e-12);
+
+    const double single_sum_error = std::abs(static_cast<double>(sum(lhs)) - expected_sum);
+    CHECK_LT(std::abs(mixed_sum - expected_sum), single_sum_error);
+
+    SUBCASE("the result does not depend on the number of threads")
+    {
+        const int initial_threads = Kernels::num_threads();
+        Kernels::set_num_threads(3);
+        const double parallel_sum = sum<double>(lhs);
+        const float parallel_single_sum = sum(lhs);
+        Kernels::set_num_threads(1);
+        CHECK_EQ(parallel_sum, sum<double>(lhs));
+        CHECK_EQ(parallel_single_sum, sum(lhs));
+        Kernels::set_num_threads(initial_threads);
+    }
+}
@@ -2,6 +2,7 @@
 #include <backends.hpp>
 #include <doctest/doctest.h>
 
+using LinAlg::Solvers::FixedLU;
 using LinAlg::Solvers::LU;
 
 TEST_CASE_TEMPLATE("LU", S, ET_type<double>)
@@ -38,6 +39,14 @@ TEST_CASE_TEMPLATE("LU", S, ET_type<double>)
         auto [L2, U2] = lu.getLU();
         res = mat_mult(L2, U2);
         CHECK(APPROX_EQ(m, res));
+
+        // Same size: the factors are reset in place.
+        m = S::Matrix::randn(20, 20, 10., 100.);
+        lu.reinit(m);
+        lu.factorize();
+        auto [L3, U3] = lu.getLU();
+        res = mat_mult(L3, U3);
+        CHECK(APPROX_EQ(m, res));
     }
 
     SUBCASE("Solve")
@@ -59,3 +68,22 @@ TEST_CASE_TEMPLATE("LU", S, ET_type<double>)
         CHECK(APPROX_EQ(Ax2, b2));
     }
 }
+
+TEST_CASE("FixedLU")
+{
+    using Matrix4d = ET::Matrix4d;
+
+    // The factorization of a fixed size matrix is constexpr.
+    constexpr ET::Matrix<double, 2, 2> A_2 { { 4., 3. }, { 6., 3. } };
+    constexpr ET::Matrix<double, 2, 1> x_2 = FixedLU(A_2).solve(ET::Matrix<double, 2, 1> { { 10. }, { 12. } });
+    static_assert(x_2[0] == 1. && x_2[1] == 2.);
+
+    Matrix4d A = Matrix4d::randn(4, 4, 10., 1., 0., 1);
+    FixedLU lu(A);
+    auto [L, U] = lu.getLU();
+    CHECK(APPROX_EQ(mat_mult(L, U), A));
+
+    ET::Matrix<double, 4, 2> b = ET::Matrix<double, 4, 2>::randn(4, 2, 0., 1., 0., 2);
+    auto x = lu.solve(b);
+    CHECK(APPROX_EQ(mat_mult(A, x), b));
+}
@@ -0,0 +1,164 @@
+#include <backends.hpp>
+#include <doctest/doctest.h>
+
+using LinAlg::Matrices::Common::SparseFormat;
+using LinAlg::Matrices::Common::SparseMatrix;
+using LinAlg::Matrices::Common::Triplet;
+
+/*
+    Returns random coefficients of a rows x cols matrix, about density * rows * cols of them, some of them duplicated.
+*/
+std::vector<Triplet<double>> random_triplets(int rows, int cols, double density, int seed)
+{
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> row(0, rows - 1);
+    std::uniform_int_distribution<int> col(0, cols - 1);
+    std::normal_distribution<double> value(0., 1.);
+    std::vector<Triplet<double>> triplets(static_cast<std::size_t>(density * rows * cols));
+    for (auto& t : triplets)
+        t = { row(gen), col(gen), value(gen) };
+    return triplets;
+}
+
+TEST_CASE_TEMPLATE("Sparse matrices", S, ET_type<double>, RG_type<double>)
+{
+    using Matrix = S::Matrix;
+    using CSR = SparseMatrix<double, SparseFormat::CSR>;
+    using CSC = SparseMatrix<double, SparseFormat::CSC>;
+
+    const std::vector<Triplet<double>> triplets { { 2, 1, 3. }, { 0, 3, 1. }, { 2, 1, 4. }, { 1, 0, -2. }, { 0, 0, 5. }, { 2, 3, 6. } };
+    Matrix expected { { 5., 0., 0., 1. }, { -2., 0., 0., 0. }, { 0., 7., 0., 6. } };
+
+    SUBCASE("from triplets")
+    {
+        CSR csr = CSR::from_triplets(3, 4, triplets);
+        CSC csc = CSC::from_triplets(3, 4, triplets);
+        CHECK_EQ(csr.non_zeros(), 5);
+        CHECK_EQ(csc.non_zeros(), 5);
+        CHECK(APPROX_EQ(csr, expected));
+        CHECK(APPROX_EQ(csc, expected));
+        CHECK_EQ(csr[5], 0.);
+        CHECK_EQ(csr[9], 7.);
+        CHECK(std::ranges::equal(csr.offsets(), std::vector { 0, 2, 3, 5 }));
+        CHECK(std::ranges::equal(csr.indices(), std::vector { 0, 3, 0, 1, 3 }));
+        CHECK(std::ranges::equal(csc.indices(), std::vector { 0, 1, 2, 0, 2 }));
+    }
+    SUBCASE("from dense")
+    {
+        CSR csr = CSR::from_dense(expected);
+        CHECK_EQ(csr.non_zeros(), 5);
+        CHECK(APPROX_EQ(Matrix(csr), expected));
+        CHECK_EQ(CSC::from_dense(expected, 5.).non_zeros(), 2);
+    }
+    SUBCASE("conversions")
+    {
+        CSR csr = CSR::from_triplets(3, 4, triplets);
+        CSC csc(csr);
+        CHECK(APPROX_EQ(csc, expected));
+        CHECK(APPROX_EQ(CSR(csc), expected));
+
+        auto csr_t = csr.transpose();
+        static_assert(std::is_same_v<decltype(csr_t), CSC>);
+        CHECK_EQ(csr_t.rows(), 4);
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 4; ++j)
+                CHECK_EQ(csr_t[j, i], expected[i, j]);
+    }
+    SUBCASE("empty")
+    {
+        CSR empty(3, 2);
+        CHECK_EQ(empty.non_zeros(), 0);
+        CHECK(APPROX_EQ(empty, Matrix::Zero(3, 2)));
+    }
+}
+
+TEST_CASE_TEMPLATE("Sparse matrix products", S, ET_type<double>, RG_type<double>)
+{
+    namespace Kernels = LinAlg::Matrices::Kernels;
+    using Matrix = S::Matrix;
+    using CSR = SparseMatrix<double, SparseFormat::CSR>;
+    using CSC = SparseMatrix<double, SparseFormat::CSC>;
+
+    // Small products, and products large enough to be split on the thread pool.
+    for (auto [m, k, n] : { std::array { 7, 5, 3 }, std::array { 1000, 800, 24 } })
+    {
+        CAPTURE(m);
+        CAPTURE(k);
+        CAPTURE(n);
+        const auto triplets = random_triplets(m, k, m < 100 ? 0.3 : 0.05, m);
+        CSR a_csr = CSR::from_triplets(m, k, triplets);
+        CSC a_csc = CSC::from_triplets(m, k, triplets);
+        Matrix a(a_csr);
+        Matrix b = Matrix::randn(k, n, 0., 1., 0., 1);
+        Matrix c = Matrix::randn(n, m, 0., 1., 0., 2);
+        Matrix x = Matrix::randn(k, 1, 0., 1., 0., 3);
+        Matrix ab = mat_mult(a, b);
+        Matrix ca = mat_mult(c, a);
+
+        SUBCASE("sparse times dense")
+        {
+            CHECK(APPROX_EQ(mat_mult(a_csr, b), ab));
+            CHECK(APPROX_EQ(mat_mult(a_csc, b), ab));
+            CHECK(APPROX_EQ(mat_mult(a_csr, x), mat_mult(a, x)));
+            CHECK(APPROX_EQ(mat_mult(a_csc, x), mat_mult(a, x)));
+            CHECK(APPROX_EQ(mat_mult(a_csr, b + b), 2. * ab));
+        }
+        SUBCASE("dense times sparse")
+        {
+            CHECK(APPROX_EQ(mat_mult(c, a_csr), ca));
+            CHECK(APPROX_EQ(mat_mult(c, a_csc), ca));
+            CHECK(APPROX_EQ(mat_mult(c + c, a_csc), 2. * ca));
+
+            // An expression on the left is evaluated once, although the kernels read its coefficients several times.
+            std::atomic<int> evaluations = 0;
+            const auto counted = c.apply([&evaluations](double value)
+            {
+                ++evaluations;
+                return 2. * value;
+            });
+            CHECK(APPROX_EQ(mat_mult(counted, a_csr), 2. * ca));
+            CHECK_EQ(evaluations.load(), n * m);
+            CHECK(APPROX_EQ(mat_mult(counted, a_csc), 2. * ca));
+            CHECK_EQ(evaluations.load(), 2 * n * m);
+        }
+        SUBCASE("non-finite values")
+        {
+            // As in dense products, the zeros of the dense operand times a NaN or an infinity give NaN.
+            const std::vector<Triplet<double>> non_finite { { 0, 0, std::numeric_limits<double>::quiet_NaN() }, { m - 1, k - 1, std::numeric_limits<double>::infinity() } };
+            const CSR non_finite_csr = CSR::from_triplets(m, k, non_finite);
+            const CSC non_finite_csc = CSC::from_triplets(m, k, non_finite);
+            const Matrix zeros(n, m);
+            for (const Matrix& product : { Matrix(mat_mult(zeros, non_finite_csr)), Matrix(mat_mult(zeros, non_finite_csc)) })
+            {
+                CHECK(std::isnan(product[0, 0]));
+                CHECK(std::isnan(product[n - 1, k - 1]));
+                CHECK_EQ(product[0, 1], 0.);
+            }
+        }
+        SUBCASE("sparse times sparse")
+        {
+            CSR a_t = a_csc.transpose();
+            Matrix expected = mat_mult(a, Matrix(a_t));
+            auto product = mat_mult(a_csr, a_t);
+            static_assert(std::is_same_v<decltype(product), CSR>);
+            CHECK(APPROX_EQ(product, expected));
+            CHECK(APPROX_EQ(mat_mult(a_csc, a_csr.transpose()), expected));
+        }
+        SUBCASE("chains")
+        {
+            CHECK(APPROX_EQ(mat_mult(c, a_csr, b), mat_mult(ca, b)));
+        }
+        SUBCASE("parallel products")
+        {
+            const int initial_threads = Kernels::num_threads();
+            Kernels::set_num_threads(3);
+            Matrix parallel_csr = mat_mult(a_csr, b);
+            Matrix parallel_csc = mat_mult(a_csc, x);
+            Kernels::set_num_threads(1);
+            CHECK(APPROX_EQ(parallel_csr, mat_mult(a_csr, b), 0., 0.));
+            // The CSC product with a vector adds per-thread partial results, which only changes the rounding.
+            CHECK(APPROX_EQ(parallel_csc, mat_mult(a_csc, x)));
+            Kernels::set_num_threads(initial_threads);
+        }
+    }
+}
@@ -0,0 +1,73 @@
+#include <backends.hpp>
+#include <doctest/doctest.h>
+
+using LinAlg::Matrices::Common::TextFormat;
+
+TEST_CASE_TEMPLATE("Text matrix files", S, ET_type<double>, ET_type<float>, ET_type<int>, RG_type<double>, RG_type<float>, RG_type<int>)
+{
+    using Matrix = S::Matrix;
+    namespace Common = LinAlg::Matrices::Common;
+
+    const auto equal = [](const auto& lhs, const auto& rhs)
+    {
+        if (lhs.rows() != rhs.rows() || lhs.cols() != rhs.cols())
+            return false;
+        for (int i = 0; i < lhs.rows(); ++i)
+            for (int j = 0; j < lhs.cols(); ++j)
+                if (lhs[i, j] != rhs[i, j])
+                    return false;
+        return true;
+    };
+    const auto to_text = [](const auto& mat, TextFormat format)
+    {
+        std::ostringstream os;
+        Common::write_text(os, mat, format);
+        return os.str();
+    };
+
+    SUBCASE("round trip")
+    {
+        // Large enough to be parsed in several chunks.
+        const Matrix a = Matrix::randn(700, 200, 0, 1000, 0, 1);
+        for (const TextFormat format : { TextFormat::Whitespace, TextFormat::CSV })
+        {
+            const std::string text = to_text(a, format);
+            CHECK_GT(text.size(), std::size_t(1) << 19);
+            CHECK(equal(Common::parse_text<Matrix>(text, format), a));
+        }
+        CHECK(equal(Common::parse_text<Matrix>(to_text(a + a, TextFormat::CSV), TextFormat::CSV), Matrix(a + a)));
+
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / "linalg_text_file_test.csv";
+        Common::save_text(path, a, TextFormat::CSV);
+        CHECK(equal(Common::load_text<Matrix>(path, TextFormat::CSV), a));
+        std::filesystem::remove(path);
+    }
+    SUBCASE("formatting")
+    {
+        const Matrix expected { { 1, 2, 3 }, { -4, 5, 6 } };
+        CHECK_EQ(to_text(expected, TextFormat::Whitespace), "1 2 3\n-4 5 6\n");
+        CHECK_EQ(to_text(expected, TextFormat::CSV), "1,2,3\n-4,5,6\n");
+        CHECK(equal(Common::parse_text<Matrix>("1 2\t3\r\n\n  -4 5 6 \n\n"), expected));
+        CHECK(equal(Common::parse_text<Matrix>("1, 2,3\n-4 ,5 , 6", TextFormat::CSV), expected));
+        CHECK(equal(Common::parse_text<Matrix>("\n \t\n1 2 3\n-4 5 6\n"), expected));
+
+        // The output of operator<< ends its rows with a space.
+        std::ostringstream os;
+        os << expected;
+        CHECK(equal(Common::parse_text<Matrix>(os.str()), expected));
+
+        CHECK_EQ(Common::parse_text<Matrix>("").rows(), 0);
+        CHECK_EQ(Common::parse_text<Matrix>("\n \n").rows(), 0);
+    }
+    SUBCASE("errors")
+    {
+        CHECK_THROWS_AS(Common::parse_text<Matrix>("1 2\n3\n"), std::runtime_error);
+        CHECK_THROWS_AS(Common::parse_text<Matrix>("1 2\n3 4 5\n"), std::runtime_error);
+        CHECK_THROWS_AS(Common::parse_text<Matrix>("1 x\n"), std::runtime_error);
+        CHECK_THROWS_AS(Common::parse_text<Matrix>("1,2\n"), std::runtime_error);
+        CHECK_THROWS_AS(Common::parse_text<Matrix>("1,,2\n", TextFormat::CSV), std::runtime_error);
+        CHECK_THROWS_AS(Common::parse_text<Matrix>("1,2,\n", TextFormat::CSV), std::runtime_error);
+        CHECK_THROWS_AS(Common::parse_text<Matrix>("1 2\n", TextFormat::CSV), std::runtime_error);
+        CHECK_THROWS_AS(Common::load_text<Matrix>(std::filesystem::temp_directory_path() / "linalg_text_file_test.missing"), std::system_error);
+    }
+}
@@ -0,0 +1,70 @@
+#include <backends.hpp>
+#include <doctest/doctest.h>
+#include <chrono>
+#include <set>
+
+namespace Kernels = LinAlg::Matrices::Kernels;
+
+TEST_CASE("Thread pool")
+{
+    const int initial_threads = Kernels::num_threads();
+    Kernels::set_num_threads(4);
+
+    SUBCASE("tasks")
+    {
+        std::vector<std::atomic<int>> runs(1000);
+        Kernels::parallel_for(1000, [&](int task) { ++runs[task]; });
+        CHECK(std::ranges::all_of(runs, [](const auto& count) { return count == 1; }));
+    }
+    SUBCASE("exceptions")
+    {
+        // A throwing task, on the caller or on a worker, stops the loop and the exception reaches the caller.
+        for (int failing_task : { 0, 7, 999 })
+        {
+            CHECK_THROWS_AS(Kernels::parallel_for(1000,
+                                                  [&](int task)
+                                                  {
+                                                      if (task == failing_task)
+                                                          throw std::runtime_error("task failed");
+                                                  }),
+                            std::runtime_error);
+        }
+
+        // The pool and the caller are still able to run parallel loops.
+        std::atomic<int> nested = 0;
+        std::set<std::thread::id> threads;
+        std::mutex mutex;
+        Kernels::parallel_for(64,
+                              [&](int)
+                              {
+                                  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                                  std::lock_guard lock(mutex);
+                                  threads.insert(std::this_thread::get_id());
+                              });
+        CHECK_GT(threads.size(), std::size_t(1));
+        Kernels::parallel_for(8, [&](int) { Kernels::parallel_for(8, [&](int) { ++nested; }); });
+        CHECK_EQ(nested.load(), 64);
+    }
+    SUBCASE("growing the pool")
+    {
+        Kernels::ThreadPool& pool = Kernels::thread_pool();
+        Kernels::set_num_threads(6);
+        CHECK_EQ(&Kernels::thread_pool(), &pool);
+        CHECK_GE(pool.workers(), 5);
+
+        // The pool is not replaced while a loop is running on it.
+        std::atomic<int> sum = 0;
+        std::atomic<bool> same_pool = true;
+        Kernels::parallel_for(16,
+                              [&](int task)
+                              {
+                                  Kernels::set_num_threads(8);
+                                  same_pool = same_pool && &Kernels::thread_pool() == &pool;
+                                  sum += task;
+                              });
+        CHECK(same_pool);
+        CHECK_EQ(sum.load(), 120);
+    }
+
+    Kernels::set_num_threads(initial_threads);
+}
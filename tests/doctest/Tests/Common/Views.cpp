@@ -0,0 +1,83 @@
+#include <backends.hpp>
+#include <doctest/doctest.h>
+
+TEST_CASE_TEMPLATE("Views", S, ET_type<double>, RG_type<double>)
+{
+    using Matrix = S::Matrix;
+
+    const int rows = 23;
+    const int cols = 17;
+    Matrix m = Matrix::randn(rows, cols, 0., 1., 0., 1);
+    const Matrix original = m;
+
+    SUBCASE("coefficients")
+    {
+        const auto block = m.block(3, 5, 7, 4);
+        CHECK_EQ(block.rows(), 7);
+        CHECK_EQ(block.cols(), 4);
+        for (int i = 0; i < 7; ++i)
+            for (int j = 0; j < 4; ++j)
+                CHECK_EQ(block[i, j], m[3 + i, 5 + j]);
+        for (int k = 0; k < 28; ++k)
+            CHECK_EQ(block[k], m[3 + k / 4, 5 + k % 4]);
+
+        const auto transposed = m.transpose();
+        CHECK_EQ(transposed.rows(), cols);
+        CHECK_EQ(transposed.cols(), rows);
+        for (int i = 0; i < rows; ++i)
+            for (int j = 0; j < cols; ++j)
+                CHECK_EQ(transposed[j, i], m[i, j]);
+
+        const auto diagonal = m.diagonal();
+        CHECK_EQ(diagonal.rows(), cols);
+        for (int i = 0; i < cols; ++i)
+            CHECK_EQ(diagonal[i, 0], m[i, i]);
+
+        CHECK(APPROX_EQ(Matrix(m.row(4)), Matrix(m.block(4, 0, 1, cols))));
+        CHECK(APPROX_EQ(Matrix(m.col(6)), Matrix(m.block(0, 6, rows, 1))));
+        CHECK(APPROX_EQ(Matrix(m.transpose().transpose()), m));
+        CHECK(APPROX_EQ(Matrix(m.block(2, 2, 10, 10).block(1, 3, 4, 5)), Matrix(m.block(3, 5, 4, 5))));
+        CHECK(APPROX_EQ(Matrix(original.block(2, 2, 10, 10).transpose()), Matrix(m.transpose().block(2, 2, 10, 10))));
+    }
+    SUBCASE("expressions")
+    {
+        Matrix sum = m.block(0, 0, 10, 10) + 2. * m.block(5, 5, 10, 10);
+        for (int i = 0; i < 10; ++i)
+            for (int j = 0; j < 10; ++j)
+                CHECK_LE(std::abs(sum[i, j] - (m[i, j] + 2. * m[5 + i, 5 + j])), 1e-12);
+
+        Matrix square = m.block(0, 0, cols, cols);
+        CHECK(APPROX_EQ(Matrix(square.transpose() + square), Matrix(square + square.transpose())));
+    }
+    SUBCASE("products")
+    {
+        Matrix other = Matrix::randn(cols, rows, 0., 1., 0., 2);
+        Matrix mt(m.transpose());
+        CHECK(APPROX_EQ(mat_mult(m.transpose(), m), mat_mult(mt, m)));
+        CHECK(APPROX_EQ(mat_mult(m, m.transpose()), mat_mult(m, mt)));
+        CHECK(APPROX_EQ(mat_mult(m.block(1, 2, 10, 8), other.block(3, 4, 8, 6)), mat_mult(Matrix(m.block(1, 2, 10, 8)), Matrix(other.block(3, 4, 8, 6)))));
+        CHECK(APPROX_EQ(mat_mult(m, m.row(2).transpose()), mat_mult(m, Matrix(mt.col(2)))));
+        CHECK(APPROX_EQ(mat_mult(m.col(3).transpose(), m), mat_mult(Matrix(mt.row(3)), m)));
+    }
+    SUBCASE("writing")
+    {
+        m.block(2, 3, 4, 5) = Matrix::Zero(4, 5);
+        for (int i = 0; i < rows; ++i)
+            for (int j = 0; j < cols; ++j)
+                CHECK_EQ(m[i, j], (i >= 2 && i < 6 && j >= 3 && j < 8) ? 0. : original[i, j]);
+
+        m.row(0) = m.row(1);
+        CHECK(APPROX_EQ(Matrix(m.row(0)), Matrix(original.row(1))));
+
+        const Matrix expected(2. * m.col(2));
+        m.col(1) = 2. * m.col(2);
+        CHECK(APPROX_EQ(Matrix(m.col(1)), expected));
+
+        m.diagonal() = Matrix::Constant(cols, 1, 1.);
+        for (int i = 0; i < cols; ++i)
+            CHECK_EQ(m[i, i], 1.);
+
+        m.transpose().block(4, 2, 3, 3)[1, 2] = 42.;
+        CHECK_EQ(m[4, 5], 42.);
+    }
+}
@@ -0,0 +1,385 @@
+#include <backends.hpp>
+#include <doctest/doctest.h>
+#include <tuple>
+#include <vector>
+
+TEST_CASE_TEMPLATE("ET::two_matrix_mult GEMM kernel", S, ET_type<double>, ET_type<float>)
+{
+    using Matrix = S::Matrix;
+    using Scalar = S::Scalar;
+    const double tol = std::is_same_v<Scalar, float> ? 1e-4 : 1e-10;
+
+    // Shapes below and above the profitability threshold, non multiples of the micro-tile and crossing the KC and MC block sizes.
+    std::vector<std::tuple<int, int, int>> shapes { { 1, 1, 1 }, { 3, 5, 7 }, { 16, 16, 16 }, { 17, 33, 9 }, { 37, 53, 71 }, { 130, 300, 257 }, { 5, 600, 9 } };
+
+    for (auto [m, k, n] : shapes)
+    {
+        CAPTURE(m);
+        CAPTURE(k);
+        CAPTURE(n);
+        Matrix lhs = Matrix::randn(m, k, 0., 1., 0., m);
+        Matrix rhs = Matrix::randn(k, n, 0., 1., 0., n);
+
+        Matrix result = mat_mult(lhs, rhs);
+        Matrix expected(m, n);
+        ET::_implementation_details::naive_two_matrix_mult(lhs, rhs, expected);
+
+        CHECK(APPROX_EQ(result, expected, tol, tol));
+    }
+}
+
+TEST_CASE("ET::two_matrix_mult evaluates expressions once")
+{
+    namespace Kernels = LinAlg::Matrices::Kernels;
+    using Matrix = ET::Matrixd;
+
+    const int initial_threads = Kernels::num_threads();
+
+    // Small (unpacked), packed serial and parallel (tiled) products.
+    for (const auto& [m, k, n, threads] : { std::tuple(7, 5, 9, 1), std::tuple(40, 50, 30, 1), std::tuple(40, 50, 30, 4), std::tuple(170, 150, 160, 4) })
+    {
+        CAPTURE(m);
+        CAPTURE(threads);
+        Kernels::set_num_threads(threads);
+        CHECK_EQ(Kernels::gemm_is_parallel(m, n, k), threads > 1 && m == 170);
+
+        Matrix m1 = Matrix::randn(m, k, 0., 1., 0., 1);
+        Matrix m2 = Matrix::randn(m, k, 0., 1., 0., 2);
+        Matrix rhs = Matrix::randn(k, n, 0., 1., 0., 3);
+
+        std::atomic<int> lhs_evaluations = 0;
+        std::atomic<int> rhs_evaluations = 0;
+        const auto counted_sum = [](std::atomic<int>& evaluations)
+        {
+            return [&evaluations](double x, double y)
+            {
+                ++evaluations;
+                return x + y;
+            };
+        };
+        ET::Expr lhs_expr(counted_sum(lhs_evaluations), m1, m2);
+        ET::Expr rhs_expr(counted_sum(rhs_evaluations), rhs, rhs);
+
+        Matrix result = mat_mult(lhs_expr, rhs_expr);
+        CHECK_EQ(lhs_evaluations.load(), m * k);
+        CHECK_EQ(rhs_evaluations.load(), k * n);
+
+        Matrix lhs = m1 + m2;
+        Matrix rhs2 = rhs * 2.;
+        Matrix expected(m, n);
+        ET::_implementation_details::naive_two_matrix_mult(lhs, rhs2, expected);
+        CHECK(APPROX_EQ(result, expected));
+    }
+
+    Kernels::set_num_threads(initial_threads);
+}
+
+TEST_CASE("ET::two_matrix_mult instruction set variants")
+{
+    namespace Kernels = LinAlg::Matrices::Kernels;
+    using Matrix = ET::Matrixd;
+
+    CHECK_EQ(Kernels::parse_isa("avx2"), Kernels::ISA::AVX2);
+    CHECK_FALSE(Kernels::parse_isa("neon").has_value());
+
+    Matrix lhs = Matrix::randn(67, 45, 0., 1., 0., 1);
+    Matrix rhs = Matrix::randn(45, 39, 0., 1., 0., 2);
+    Matrix expected(67, 39);
+    ET::_implementation_details::naive_two_matrix_mult(lhs, rhs, expected);
+    Matrix sum = lhs + 2. * lhs;
+    ET::Matrixi16 lhs_int = lhs * 1000.;
+    ET::Matrixi16 rhs_int = rhs * 1000.;
+    ET::Matrixi64 expected_int(67, 39);
+    ET::_implementation_details::naive_two_matrix_mult(ET::Matrixi64(lhs_int), ET::Matrixi64(rhs_int), expected_int);
+
+    const Kernels::ISA initial = Kernels::active_isa();
+    for (Kernels::ISA isa : { Kernels::ISA::Generic, Kernels::ISA::SSE4, Kernels::ISA::AVX2, Kernels::ISA::AVX512, Kernels::ISA::AVX512VNNI })
+    {
+        CAPTURE(Kernels::isa_name(isa));
+        const Kernels::ISA selected = Kernels::set_isa(isa);
+        CHECK_LE(selected, isa);
+        CHECK_EQ(Kernels::active_isa(), selected);
+
+        Matrix result = mat_mult(lhs, rhs);
+        CHECK(APPROX_EQ(result, expected));
+
+        Matrix result_sum = lhs + 2. * lhs;
+        CHECK(APPROX_EQ(result_sum, sum));
+
+        ET::Matrixi64 result_int = widening_mult<std::int64_t>(lhs_int, rhs_int);
+        CHECK(APPROX_EQ(result_int, expected_int));
+    }
+    Kernels::set_isa(initial);
+}
+
+TEST_CASE("ET fixed size matrices")
+{
+    using Matrix3d = ET::Matrix3d;
+    using Matrix = ET::Matrixd;
+
+    static_assert(sizeof(Matrix3d) == sizeof(int) * 2 + sizeof(double) * 9);
+    static_assert(Matrix3d::rows() == 3 && Matrix3d::cols() == 3);
+    static_assert(!LinAlg::Matrices::Common::shapes_match<Matrix3d, ET::Matrix<double, 3, 2>>);
+    static_assert(LinAlg::Matrices::Common::shapes_match<Matrix3d, Matrix>);
+
+    // Products of fixed size matrices are constexpr.
+    constexpr ET::Matrix<int, 2, 3> a { { 1, 2, 3 }, { 4, 5, 6 } };
+    constexpr ET::Matrix<int, 3, 2> b { { 1, 0 }, { 0, 1 }, { 2, -1 } };
+    constexpr auto ab = mat_mult(a, b);
+    static_assert(std::is_same_v<std::remove_cv_t<decltype(ab)>, ET::Matrix<int, 2, 2>>);
+    static_assert(ab[0, 0] == 7 && ab[0, 1] == -1 && ab[1, 0] == 16 && ab[1, 1] == -1);
+    static_assert(mat_mult(b, a, b)[1, 1] == -1 && mat_mult(b, a, b)[2, 0] == -2);
+
+    Matrix3d m = Matrix3d::randn(3, 3, 0., 1., 0., 1);
+    Matrix3d n = Matrix3d::randn(3, 3, 0., 1., 0., 2);
+    Matrix m_dyn(m);
+    Matrix n_dyn(n);
+
+    SUBCASE("expressions")
+    {
+        Matrix3d sum = m + 2. * n;
+        CHECK(APPROX_EQ(sum, Matrix(m_dyn + 2. * n_dyn)));
+        static_assert(std::is_same_v<decltype((m + n).eval()), Matrix3d>);
+        Matrix mixed = m - n_dyn;
+        CHECK(APPROX_EQ(mixed, Matrix(m_dyn - n_dyn)));
+    }
+    SUBCASE("products")
+    {
+        auto product = mat_mult(m, n);
+        static_assert(std::is_same_v<decltype(product), Matrix3d>);
+        CHECK(APPROX_EQ(product, mat_mult(m_dyn, n_dyn)));
+        CHECK(APPROX_EQ(mat_mult(m + n, n), mat_mult(m_dyn + n_dyn, n_dyn)));
+        CHECK(APPROX_EQ(mat_mult(m, n, m, n), mat_mult(m_dyn, n_dyn, m_dyn, n_dyn)));
+        CHECK(APPROX_EQ(mat_mult(m, n_dyn), mat_mult(m_dyn, n_dyn)));
+
+        ET::Matrix<double, 3, 1> x { { 1. }, { -2. }, { 0.5 } };
+        CHECK(APPROX_EQ(mat_mult(m, x), mat_mult(m_dyn, Matrix(x))));
+        CHECK(APPROX_EQ(mat_mult(Matrix3d::Identity(), m), m));
+    }
+    SUBCASE("float products accumulated in double")
+    {
+        ET::Matrix<float, 3, 3> m_f(m);
+        ET::Matrix<float, 3, 3> n_f(n);
+        auto product = mat_mult<double>(m_f, n_f);
+        static_assert(std::is_same_v<decltype(product), ET::Matrix<float, 3, 3>>);
+        CHECK(APPROX_EQ(product, mat_mult(m_dyn, n_dyn), 1e-5, 1e-5));
+    }
+}
+
+TEST_CASE("ET padded matrices")
+{
+    namespace Common = LinAlg::Matrices::Common;
+    using Matrix = ET::Matrixd;
+
+    CHECK_EQ(Common::padded_leading_dimension<double>(5), 8);
+    CHECK_EQ(Common::padded_leading_dimension<double>(64), 72);
+    CHECK_EQ(Common::padded_leading_dimension<float>(100), 112);
+
+    const int m = 37;
+    const int n = 64;
+    const int ld = Common::padded_leading_dimension<double>(n);
+    Matrix a = Matrix::randn(m, n, 0., 1., 0., 1);
+    Matrix b = Matrix::randn(n, m, 0., 1., 0., 2);
+    Matrix x = Matrix::randn(n, 1, 0., 1., 0., 3);
+
+    Matrix a_pad(a, ld);
+    Matrix b_pad(b, Common::padded_leading_dimension<double>(m));
+    Matrix x_pad(x, 8);
+
+    REQUIRE(a_pad.is_padded());
+    CHECK_EQ(a_pad.leading_dimension(), ld);
+    CHECK_EQ(a_pad.data().size(), static_cast<std::size_t>(m * ld));
+    CHECK(reinterpret_cast<std::uintptr_t>(a_pad.data().data()) % Common::cache_line_size == 0);
+    CHECK(reinterpret_cast<std::uintptr_t>(a.data().data()) % Common::cache_line_size == 0);
+
+    SUBCASE("coefficients and expressions")
+    {
+        for (int i = 0; i < m * n; ++i)
+            CHECK_EQ(a_pad[i], a[i]);
+        CHECK(APPROX_EQ(a_pad, a));
+        Matrix sum(a_pad + 2. * a, ld);
+        CHECK(APPROX_EQ(sum, Matrix(3. * a)));
+        CHECK(sum.is_padded());
+        Matrix copy(a_pad);
+        CHECK(copy.is_padded());
+        CHECK(APPROX_EQ(copy, a));
+        CHECK(APPROX_EQ(Matrix(a_pad - a), Matrix::Zero(m, n)));
+    }
+    SUBCASE("reductions")
+    {
+        using LinAlg::Matrices::Common::dot;
+        using LinAlg::Matrices::Common::sum;
+        CHECK_LE(std::abs(sum(a_pad) - sum(a)), 1e-10);
+        CHECK_LE(std::abs(dot(a_pad, a) - dot(a, a)), 1e-10 * dot(a, a));
+    }
+    SUBCASE("products")
+    {
+        const Matrix ab = mat_mult(a, b);
+        CHECK(APPROX_EQ(mat_mult(a_pad, b_pad), ab));
+        CHECK(APPROX_EQ(mat_mult(a_pad, b), ab));
+        CHECK(APPROX_EQ(mat_mult(a_pad, x_pad), mat_mult(a, x)));
+        CHECK(APPROX_EQ(mat_mult(b_pad, a_pad, b_pad), mat_mult(b, ab)));
+        CHECK(APPROX_EQ(strassen_mult(a_pad, b_pad, 16), ab));
+
+        Matrix c(m, m, Common::padded_leading_dimension<double>(m));
+        LinAlg::Matrices::Common::gemm_into(c, a_pad, b_pad);
+        CHECK(APPROX_EQ(c, ab));
+    }
+}
+
+TEST_CASE("ET column-major and tiled matrices")
+{
+    namespace Common = LinAlg::Matrices::Common;
+    using Matrix = ET::Matrixd;
+    using ColMajor = ET::ColMajorMatrix<double>;
+    using Tiled = ET::TiledMatrix<double, 4>;
+
+    // Converting between layouts is explicit.
+    static_assert(std::is_constructible_v<ColMajor, const Matrix&> && !std::is_convertible_v<const Matrix&, ColMajor>);
+    static_assert(!std::is_convertible_v<const ColMajor&, Matrix> && std::is_convertible_v<decltype(std::declval<Matrix>() + std::declval<ColMajor>()), Matrix>);
+    static_assert(LinAlg::Matrices::Kernels::Concepts::ColMajorMatrix<ColMajor> && !LinAlg::Matrices::Kernels::Concepts::ContiguousMatrix<ColMajor>);
+    static_assert(!LinAlg::Matrices::Kernels::Concepts::ContiguousMatrix<Tiled>);
+
+    const int m = 37;
+    const int k = 45;
+    const int n = 29;
+    Matrix a = Matrix::randn(m, k, 0., 1., 0., 1);
+    Matrix b = Matrix::randn(k, n, 0., 1., 0., 2);
+    ColMajor a_col(a);
+    ColMajor b_col(b);
+    Tiled a_tiled(a);
+    Tiled b_tiled(b);
+
+    SUBCASE("storage")
+    {
+        CHECK_EQ(a_col.leading_dimension(), m);
+        CHECK_EQ(a_tiled.leading_dimension(), 48);
+        CHECK_EQ(a_tiled.data().size(), static_cast<std::size_t>(40 * 48));
+        CHECK_EQ(a_col.data()[3 * m + 5], a[5, 3]);
+        CHECK_EQ(a_tiled.data()[(4 * 48 + 4 * 4) * 4 + 1 * 4 + 2], a[17, 18]);
+        for (int i = 0; i < m * k; ++i)
+        {
+            CHECK_EQ(a_col[i], a[i]);
+            CHECK_EQ(a_tiled[i], a[i]);
+        }
+        CHECK(APPROX_EQ(Matrix(a_col), a));
+        CHECK(APPROX_EQ(Matrix(a_tiled), a));
+        CHECK(APPROX_EQ(Matrix(Tiled(a_col)), a));
+
+        ColMajor padded(a, m + 3);
+        CHECK_EQ(padded.data().size(), static_cast<std::size_t>((m + 3) * k));
+        CHECK(APPROX_EQ(padded, a));
+        CHECK(APPROX_EQ(ColMajor { { 1., 2. }, { 3., 4. } }, Matrix { { 1., 2. }, { 3., 4. } }));
+        CHECK(APPROX_EQ(ColMajor::Identity(3), Matrix::Identity(3)));
+    }
+    SUBCASE("expressions and reductions")
+    {
+        Matrix sum = a + 2. * a;
+        CHECK(APPROX_EQ(Matrix(a_col + 2. * a), sum));
+        CHECK(APPROX_EQ(Matrix(a_tiled + 2. * a_col), sum));
+        ColMajor sum_col(a + 2. * a_col);
+        CHECK(APPROX_EQ(sum_col, sum));
+        sum_col = a_tiled * 3.;
+        CHECK(APPROX_EQ(sum_col, sum));
+        CHECK_LE(std::abs(Common::sum(a_col) - Common::sum(a)), 1e-10);
+        CHECK_LE(std::abs(Common::dot(a_col, a_tiled) - Common::dot(a, a)), 1e-10 * Common::dot(a, a));
+    }
+    SUBCASE("products")
+    {
+        const Matrix ab = mat_mult(a, b);
+        CHECK(APPROX_EQ(mat_mult(a_col, b_col), ab));
+        CHECK(APPROX_EQ(mat_mult(a_col, b), ab));
+        CHECK(APPROX_EQ(mat_mult(a_tiled, b_col), ab));
+        CHECK(APPROX_EQ(mat_mult(a_col + a_tiled, b), Matrix(2. * ab)));
+        CHECK(APPROX_EQ(mat_mult(a_col, b_col, Matrix::Identity(n)), ab));
+        CHECK(APPROX_EQ(strassen_mult(a_col, b_tiled, 8), ab));
+
+        ColMajor x(Matrix::randn(k, 1, 0., 1., 0., 3));
+        CHECK(APPROX_EQ(mat_mult(a_col, x), mat_mult(a, Matrix(x))));
+        CHECK(APPROX_EQ(syrk(a_col), syrk(a)));
+        CHECK(APPROX_EQ(syrk(a_tiled, true), syrk(a, true)));
+
+        using CSR = Common::SparseMatrix<double, Common::SparseFormat::CSR>;
+        const CSR sparse = CSR::from_dense(Matrix(a.apply([](double v) { return std::abs(v) > 1. ? v : 0.; })));
+        const ColMajor c_col(Matrix::randn(n, m, 0., 1., 0., 4));
+        CHECK(APPROX_EQ(mat_mult(sparse, b_col), mat_mult(sparse, b)));
+        CHECK(APPROX_EQ(mat_mult(c_col, sparse), mat_mult(Matrix(c_col), sparse)));
+    }
+}
+
+TEST_CASE("ET views of column-major, padded and fixed size matrices")
+{
+    namespace Kernels = LinAlg::Matrices::Kernels;
+    using Matrix = ET::Matrixd;
+
+    Matrix a = Matrix::randn(19, 13, 0., 1., 0., 1);
+    Matrix b = Matrix::randn(13, 11, 0., 1., 0., 2);
+
+    // The views are read in place by the kernels, and are read-only if the matrix is const.
+    static_assert(std::is_same_v<decltype(Kernels::make_operand(a.transpose())), Kernels::StridedOperand<double>>);
+    static_assert(std::is_same_v<decltype(std::as_const(a).block(0, 0, 1, 1)), ET::StridedView<const double>>);
+    static_assert(std::is_same_v<decltype(a.block(0, 0, 1, 1).transpose()), ET::StridedView<double>>);
+
+    SUBCASE("column-major")
+    {
+        ET::ColMajorMatrix<double> a_col(a);
+        CHECK(APPROX_EQ(Matrix(a_col.transpose()), Matrix(a.transpose())));
+        CHECK(APPROX_EQ(Matrix(a_col.block(2, 3, 5, 7)), Matrix(a.block(2, 3, 5, 7))));
+        CHECK(APPROX_EQ(mat_mult(a_col.block(1, 0, 10, 13), b), mat_mult(a.block(1, 0, 10, 13), b)));
+        a_col.col(4) = a.col(5);
+        CHECK(APPROX_EQ(Matrix(a_col.col(4)), Matrix(a.col(5))));
+    }
+    SUBCASE("padded")
+    {
+        Matrix a_pad(a, 32);
+        CHECK(APPROX_EQ(Matrix(a_pad.block(4, 1, 9, 12)), Matrix(a.block(4, 1, 9, 12))));
+        CHECK(APPROX_EQ(Matrix(a_pad.diagonal()), Matrix(a.diagonal())));
+        CHECK(APPROX_EQ(syrk(a_pad.transpose()), syrk(a, true)));
+    }
+    SUBCASE("fixed size")
+    {
+        ET::Matrix<double, 3, 3> f { { 1., 2., 3. }, { 4., 5., 6. }, { 7., 8., 9. } };
+        CHECK(APPROX_EQ(Matrix(f.diagonal()), Matrix { { 1. }, { 5. }, { 9. } }));
+        f.row(0) = f.col(2).transpose();
+        CHECK(APPROX_EQ(f, Matrix { { 3., 6., 9. }, { 4., 5., 6. }, { 7., 8., 9. } }));
+    }
+}
+
+TEST_CASE("ET binary files of column-major, padded and fixed size matrices")
+{
+    namespace Common = LinAlg::Matrices::Common;
+    using Matrix = ET::Matrixd;
+    using ColMajor = ET::ColMajorMatrix<double>;
+
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "linalg_binary_file_et_test.bin";
+    const Matrix a = Matrix::randn(23, 17, 0., 1., 0., 1);
+
+    SUBCASE("column-major")
+    {
+        Common::save_binary(path, ColMajor(a));
+        CHECK(Common::read_binary_header(path).layout == Common::BinaryLayout::ColMajor);
+        CHECK(APPROX_EQ(Common::load_binary<Matrix>(path), a));
+        CHECK(APPROX_EQ(Common::load_binary<ColMajor>(path), a));
+        CHECK_THROWS_AS(Common::map_binary<ET::MappedMatrix<double>>(path), std::runtime_error);
+    }
+    SUBCASE("padded and tiled")
+    {
+        Common::save_binary(path, ColMajor(a, 30));
+        CHECK(APPROX_EQ(Common::load_binary<Matrix>(path), a));
+        Common::save_binary(path, Matrix(a, 20));
+        CHECK_EQ(std::filesystem::file_size(path), Common::read_binary_header(path).data_offset + a.rows() * a.cols() * sizeof(double));
+        CHECK(APPROX_EQ(Common::map_binary<ET::MappedMatrix<double>>(path), a));
+        Common::save_binary(path, ET::TiledMatrix<double, 4>(a));
+        CHECK(Common::read_binary_header(path).layout == Common::BinaryLayout::RowMajor);
+        CHECK(APPROX_EQ(Common::load_binary<Matrix>(path), a));
+    }
+    SUBCASE("fixed size")
+    {
+        const ET::Matrix<float, 2, 3> f { { 1.f, 2.f, 3.f }, { 4.f, 5.f, 6.f } };
+        Common::save_binary(path, f);
+        CHECK(APPROX_EQ(Common::load_binary<ET::Matrix<float, 2, 3>>(path), f));
+        CHECK(APPROX_EQ(Common::map_binary<ET::MappedMatrix<float>>(path), f));
+    }
+
+    std::filesystem::remove(path);
+}
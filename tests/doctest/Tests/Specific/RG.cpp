@@ -9,6 +9,7 @@ TEST_CASE("RG::Container")
 
     Cont c1(5);
     CHECK_EQ(c1.size(), 5);
+    CHECK(reinterpret_cast<std::uintptr_t>(c1.data()) % LinAlg::Matrices::Common::cache_line_size == 0);
 
     // operator subscript
     for (int i = 0; i < c1.size(); ++i)
@@ -68,6 +69,77 @@ TEST_CASE("RG::Container")
         CHECK_EQ(c8[i], c6[i]);
 }
 
+TEST_CASE("RG::Container inline storage")
+{
+    using Cont = RG::Container<int, 8>;
+
+    const auto filled = [](int size, int first)
+    {
+        Cont c(size);
+        for (int i = 0; i < size; ++i)
+            c[i] = first + i;
+        return c;
+    };
+    const auto check = [](const Cont& c, int size, int first)
+    {
+        REQUIRE(c.size() == size);
+        for (int i = 0; i < size; ++i)
+            CHECK_EQ(c[i], first + i);
+    };
+
+    Cont small = filled(8, 0);
+    Cont large = filled(9, 100);
+    CHECK(small.is_inline());
+    CHECK_FALSE(large.is_inline());
+    CHECK_FALSE(Cont(0).is_inline());
+    CHECK(reinterpret_cast<std::uintptr_t>(small.data()) % LinAlg::Matrices::Common::cache_line_size == 0);
+    // The inline values stay inside the Container.
+    CHECK_GE(reinterpret_cast<const std::byte*>(small.data()), reinterpret_cast<const std::byte*>(&small));
+    CHECK_LT(reinterpret_cast<const std::byte*>(small.data()), reinterpret_cast<const std::byte*>(&small + 1));
+
+    SUBCASE("move")
+    {
+        Cont moved(std::move(small));
+        CHECK(moved.is_inline());
+        CHECK_NE(moved.data(), small.data());
+        check(moved, 8, 0);
+        CHECK_EQ(small.size(), 0);
+
+        const int* heap = large.data();
+        Cont moved_large(std::move(large));
+        CHECK_EQ(moved_large.data(), heap);
+        check(moved_large, 9, 100);
+    }
+    SUBCASE("swap")
+    {
+        Cont other_small = filled(3, 50);
+        swap(small, other_small);
+        check(small, 3, 50);
+        check(other_small, 8, 0);
+
+        swap(small, large);
+        check(small, 9, 100);
+        check(large, 3, 50);
+        CHECK(large.is_inline());
+        CHECK_FALSE(small.is_inline());
+    }
+    SUBCASE("assignment")
+    {
+        Cont c = filled(20, 7);
+        c = small;
+        check(c, 8, 0);
+        c = large;
+        check(c, 9, 100);
+        c = std::move(small);
+        check(c, 8, 0);
+    }
+    SUBCASE("heap only")
+    {
+        RG::Container<int, 0> c(2);
+        CHECK_FALSE(c.is_inline());
+    }
+}
+
 template <typename Cont>
 using MatrixView = RG::MatrixView<Cont>;
 
@@ -131,3 +203,128 @@ TEST_CASE_TEMPLATE("RG::Matrix", S, RG_type<double>)
             CHECK_EQ(col[i], m1[i, j]);
     }
 }
+
+TEST_CASE_TEMPLATE("RG::two_matrix_mult packed kernel", S, RG_type<double>, RG_type_STL<double>)
+{
+    using Matrix = S::Matrix;
+
+    const auto mult_by_hand = [](const auto& lhs, const auto& rhs)
+    {
+        Matrix result(lhs.rows(), rhs.cols());
+        for (int i = 0; i < lhs.rows(); ++i)
+            for (int j = 0; j < rhs.cols(); ++j)
+            {
+                double sum = 0.;
+                for (int k = 0; k < lhs.cols(); ++k)
+                    sum += lhs[i, k] * rhs[k, j];
+                result[i, j] = sum;
+            }
+        return result;
+    };
+
+    // The inner dimension is large enough to split the columns in several blocks.
+    Matrix lhs = Matrix::randn(9, 5000, 0., 1., 1e-8);
+    Matrix rhs = Matrix::randn(5000, 7, 0., 1., 1e-8);
+
+    SUBCASE("matrices")
+    {
+        Matrix result = mat_mult(lhs, rhs);
+        CHECK(APPROX_EQ(result, mult_by_hand(lhs, rhs)));
+    }
+    SUBCASE("views")
+    {
+        Matrix result = mat_mult(lhs + lhs, rhs - 2. * rhs);
+        Matrix lhs2 = lhs + lhs;
+        Matrix rhs2 = rhs - 2. * rhs;
+        CHECK(APPROX_EQ(result, mult_by_hand(lhs2, rhs2)));
+    }
+    SUBCASE("mixed scalar types")
+    {
+        RG::Matrix<int> lhs_int = RG::Matrix<int>::randn(9, 31, 0, 5);
+        Matrix rhs_small = Matrix::randn(31, 7, 0., 1., 1e-8);
+        Matrix result = mat_mult(lhs_int, rhs_small);
+        Matrix lhs_double = lhs_int;
+        CHECK(APPROX_EQ(result, mult_by_hand(lhs_double, rhs_small)));
+    }
+}
+
+TEST_CASE_TEMPLATE("RG padded matrices", S, RG_type<double>, RG_type_STL<double>)
+{
+    namespace Common = LinAlg::Matrices::Common;
+    using Matrix = S::Matrix;
+
+    const int m = 37;
+    const int n = 64;
+    const int ld = Common::padded_leading_dimension<double>(n);
+    Matrix a = Matrix::randn(m, n, 0., 1., 0., 1);
+    Matrix b = Matrix::randn(n, m, 0., 1., 0., 2);
+    Matrix x = Matrix::randn(n, 1, 0., 1., 0., 3);
+
+    Matrix a_pad(a, ld);
+    Matrix b_pad(b, Common::padded_leading_dimension<double>(m));
+    Matrix x_pad(x, 8);
+
+    REQUIRE(a_pad.is_padded());
+    CHECK_EQ(a_pad.leading_dimension(), ld);
+
+    SUBCASE("iterators")
+    {
+        // The iteration goes through the coefficients in the order of the flattened index, skipping the padding of the rows.
+        CHECK_EQ(std::ranges::distance(a_pad), m * n);
+        CHECK(std::ranges::equal(a_pad, a));
+        CHECK(std::ranges::equal(std::as_const(a_pad), a));
+        CHECK(std::ranges::equal(a_pad | std::views::reverse, a | std::views::reverse));
+        auto it = a_pad.begin() + (2 * n + 5);
+        CHECK_EQ(*it, a[2, 5]);
+        CHECK_EQ(it[n], a[3, 5]);
+        CHECK_EQ(it - a_pad.begin(), 2 * n + 5);
+
+        Matrix filled(m, n, ld);
+        std::ranges::fill(filled, 1.);
+        bool all_ones = true;
+        for (int i = 0; i < m * n; ++i)
+            all_ones = all_ones && filled[i] == 1.;
+        CHECK(all_ones);
+        for (int i = 0; i < m; ++i)
+            CHECK_EQ(filled.data()[i * ld + n], 0.);
+    }
+    SUBCASE("views")
+    {
+        CHECK(std::ranges::equal(a_pad.row(3), a.row(3)));
+        CHECK(std::ranges::equal(a_pad.col(5), a.col(5)));
+        CHECK(std::ranges::equal(a_pad.block(2, 3, 4, 5), a.block(2, 3, 4, 5)));
+        CHECK(std::ranges::equal(a_pad.transpose(), a.transpose()));
+        CHECK(std::ranges::equal(a_pad.diagonal(), a.diagonal()));
+
+        Matrix copy(a, ld);
+        copy.row(1) = a.row(0);
+        CHECK_EQ(copy[1, n - 1], a[0, n - 1]);
+        CHECK_EQ(copy.data()[ld + n - 1], a[0, n - 1]);
+    }
+    SUBCASE("coefficients and expressions")
+    {
+        for (int i = 0; i < m * n; ++i)
+            CHECK_EQ(a_pad[i], a[i]);
+        CHECK(APPROX_EQ(a_pad, a));
+        Matrix sum(a_pad + 2. * a, ld);
+        CHECK(APPROX_EQ(sum, Matrix(3. * a)));
+        CHECK(sum.is_padded());
+        CHECK(APPROX_EQ(Matrix(a_pad - a), Matrix::Zero(m, n)));
+    }
+    SUBCASE("reductions")
+    {
+        using LinAlg::Matrices::Common::dot;
+        using LinAlg::Matrices::Common::sum;
+        CHECK_LE(std::abs(sum(a_pad) - sum(a)), 1e-10);
+        CHECK_LE(std::abs(dot(a_pad, a) - dot(a, a)), 1e-10 * dot(a, a));
+    }
+    SUBCASE("products")
+    {
+        const Matrix ab = mat_mult(a, b);
+        CHECK(APPROX_EQ(mat_mult(a_pad, b_pad), ab));
+        CHECK(APPROX_EQ(mat_mult(a_pad, b), ab));
+        CHECK(APPROX_EQ(mat_mult(a_pad, x_pad), mat_mult(a, x)));
+        CHECK(APPROX_EQ(mat_mult(b_pad, a_pad, b_pad), mat_mult(b, ab)));
+        CHECK(APPROX_EQ(strassen_mult(a_pad, b_pad, 16), ab));
+    }
+}
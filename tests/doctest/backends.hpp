@@ -18,6 +18,9 @@ struct ET_type
     using Scalar = T;
     using OtherScalar = std::conditional_t<std::is_integral_v<Scalar>, double, int>;
     using Matrix = ET::Matrix<Scalar>;
+    using MappedMatrix = ET::MappedMatrix<Scalar>;
+    template <typename U>
+    using MatrixOf = ET::Matrix<U>;
     using OtherMatrix = ET::Matrix<OtherScalar>;
     using Constant = ET::Constant<Scalar>;
     using Zero = ET::Zero<Scalar>;
@@ -30,6 +33,9 @@ struct RG_type
     using Scalar = T;
     using OtherScalar = std::conditional_t<std::is_integral_v<Scalar>, double, int>;
     using Matrix = RG::Matrix<Scalar>;
+    using MappedMatrix = RG::MappedMatrix<Scalar>;
+    template <typename U>
+    using MatrixOf = RG::Matrix<U>;
     using OtherMatrix = RG::Matrix<OtherScalar>;
     using Constant = RG::Constant<Scalar>;
     using Zero = RG::Zero<Scalar>;
@@ -42,6 +48,9 @@ struct RG_type_STL
     using Scalar = T;
     using OtherScalar = std::conditional_t<std::is_integral_v<Scalar>, double, int>;
     using Matrix = RG::MatrixCont<std::vector<Scalar>>;
+    using MappedMatrix = RG::MappedMatrix<Scalar>;
+    template <typename U>
+    using MatrixOf = RG::MatrixCont<std::vector<U>>;
     using OtherMatrix = RG::Matrix<std::vector<OtherScalar>>;
     using Constant = RG::Constant<Scalar>;
     using Zero = RG::Zero<Scalar>;